@@ -27,6 +27,7 @@ namespace wrench {
 
     protected:
         friend class Simulation;
+        friend class CompoundStorageService;
         DataFile(std::string id, double size);
 
         /** @brief File id/name **/
@@ -32,6 +32,7 @@ namespace wrench {
          *      - "fcfs": First Come First Serve (default)
          *      - "conservative_bf": a home-grown implementation of FCFS with conservative backfilling, which only allocates resources at the node level (i.e., two jobs can never run on the same node even if that node has enough cores to support both jobs)
          *      - "conservative_bf_core_level": a home-grown implementation of FCFS with conservative backfilling, which only allocates resources at the core level (i.e., two jobs may run on the same node  if that node has enough cores to support both jobs)
+         *      - "easy_bf": a home-grown implementation of FCFS with EASY backfilling (only the job at the head of the queue gets a reservation, and any other job is started early if it does not delay that reservation), which only allocates resources at the node level (i.e., two jobs can never run on the same node even if that node has enough cores to support both jobs)
          *
          *    - If ENABLE_BATSCHED is set to on:
          *      - whatever scheduling algorithm is supported by Batsched
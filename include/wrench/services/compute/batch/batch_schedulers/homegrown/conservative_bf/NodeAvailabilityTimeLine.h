@@ -10,9 +10,12 @@
 #ifndef WRENCH_NODEAVAILABILITYTIMELINE_H
 #define WRENCH_NODEAVAILABILITYTIMELINE_H
 
-#include <vector>
-#include <boost/icl/interval_map.hpp>
-#include "wrench/services/compute/batch/batch_schedulers/homegrown/conservative_bf/BatchJobSet.h"
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <boost/icl/interval_set.hpp>
+#include "wrench/services/compute/batch/batch_schedulers/homegrown/conservative_bf/NodeUtilizationTree.h"
 
 /***********************/
 /** \cond              */
@@ -24,7 +27,11 @@ namespace wrench {
     class BatchJob;
 
     /**
-     * @brief A class that implements a node availability time line abstraction
+     * @brief A class that implements a node availability time line abstraction. The number of
+     *        utilized nodes over time is kept in a segment tree, so that adding or removing a job takes
+     *        O(log T) and finding the earliest start time of a job takes O(log T) per (too short) period
+     *        during which it would fit that is skipped. The dates at which each job is in the time line
+     *        are kept in a separate reservation table
      */
     class NodeAvailabilityTimeLine {
 
@@ -37,12 +44,30 @@ namespace wrench {
         void print();
         std::set<std::shared_ptr<BatchJob>> getJobsInFirstSlot();
         u_int32_t findEarliestStartTime(uint32_t duration, unsigned long num_nodes);
+        u_int32_t findEarlierStartTime(uint32_t duration, const std::shared_ptr<BatchJob> &job, u_int32_t start);
+        unsigned long getMaxAvailableNodesBefore(u_int32_t date);
 
     private:
+        /** @brief The dates at which a job is in the time line */
+        struct Reservation {
+            /** @brief The date intervals */
+            boost::icl::interval_set<u_int32_t> intervals;
+            /** @brief The position of the job in reservations_by_start */
+            std::multimap<u_int32_t, std::shared_ptr<BatchJob>>::iterator by_start;
+            /** @brief The position of the job in reservations_by_end */
+            std::multimap<u_int32_t, std::shared_ptr<BatchJob>>::iterator by_end;
+        };
+
         unsigned long max_num_nodes;
-        boost::icl::interval_map<u_int32_t, BatchJobSet, boost::icl::partial_enricher> availability_timeslots;
+        u_int32_t time_origin = 0;
+        NodeUtilizationTree num_nodes_utilized;
+        std::unordered_map<std::shared_ptr<BatchJob>, Reservation> reservations;
+        // Jobs indexed by the first date and by the date after the last date at which they are in the time line
+        std::multimap<u_int32_t, std::shared_ptr<BatchJob>> reservations_by_start;
+        std::multimap<u_int32_t, std::shared_ptr<BatchJob>> reservations_by_end;
 
         void update(bool add, u_int32_t start, u_int32_t end, std::shared_ptr<BatchJob> job);
+        u_int32_t findEarliestStartTime(uint32_t duration, unsigned long num_nodes, u_int32_t latest_start);
     };
 
 }// namespace wrench
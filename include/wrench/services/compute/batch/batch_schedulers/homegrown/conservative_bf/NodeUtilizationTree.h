@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2017-2018. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_NODEUTILIZATIONTREE_H
+#define WRENCH_NODEUTILIZATIONTREE_H
+
+#include <cstdint>
+#include <sys/types.h>
+#include <vector>
+
+/***********************/
+/** \cond              */
+/***********************/
+
+namespace wrench {
+
+    /**
+     * @brief A class that implements a number of utilized nodes over time, i.e., over all dates
+     *        in [0, UINT32_MAX), as a segment tree whose nodes are only created where the count
+     *        varies (and deleted when it no longer does). Adding a count over a date range, and
+     *        finding the min count over a date range, the first date at which the count is at most
+     *        some threshold, or the last date in a range at which it is above that threshold, are all O(log T) operations, where T is the size of the
+     *        date domain
+     */
+    class NodeUtilizationTree {
+
+    public:
+        NodeUtilizationTree();
+
+        void clear();
+        void add(u_int32_t start, u_int32_t end, long num_nodes);
+        long getMin(u_int32_t start, u_int32_t end);
+        u_int32_t findLastAbove(u_int32_t start, u_int32_t end, long threshold);
+        u_int32_t findFirstAtMost(u_int32_t start, long threshold);
+
+    private:
+        struct TreeNode {
+            // Count added to all dates covered by this node
+            long added;
+            // Min and max counts over the dates covered by this node (including "added" but
+            // not the counts added to the ancestors)
+            long min;
+            long max;
+            // Indices of the children in tree_nodes, or -1 for a child whose counts are all zero
+            int children[2];
+        };
+
+        std::vector<TreeNode> tree_nodes;
+        std::vector<int> free_tree_nodes;
+
+        int newTreeNode();
+        void update(int index, uint64_t lower, uint64_t upper, uint64_t start, uint64_t end, long num_nodes);
+        long getMin(int index, uint64_t lower, uint64_t upper, uint64_t start, uint64_t end, long offset);
+        uint64_t findFirstAtMost(int index, uint64_t lower, uint64_t upper, uint64_t start, uint64_t end, long offset,
+                           long threshold);
+        uint64_t findLastAbove(int index, uint64_t lower, uint64_t upper, uint64_t start, uint64_t end, long offset,
+                               long threshold);
+    };
+
+}// namespace wrench
+
+/***********************/
+/** \endcond           */
+/***********************/
+
+#endif//WRENCH_NODEUTILIZATIONTREE_H
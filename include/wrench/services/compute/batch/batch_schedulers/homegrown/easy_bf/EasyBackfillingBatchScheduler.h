@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2017-2021. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_EASYBACKFILLINGBATCHSCHEDULER_H
+#define WRENCH_EASYBACKFILLINGBATCHSCHEDULER_H
+
+#include <map>
+#include <unordered_map>
+
+#include "wrench/services/compute/batch/BatchComputeService.h"
+#include "wrench/services/compute/batch/batch_schedulers/homegrown/HomegrownBatchScheduler.h"
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A class that defines an EASY backfilling batch scheduler: only the job at the head of
+     *        the queue gets a reservation (at the "shadow time", i.e., the earliest date at which enough
+     *        nodes will be free based on the requested times of the running jobs), and any other queued
+     *        job is started right away if it does not delay that reservation. Resources are allocated at
+     *        the node level (i.e., two jobs can never run on the same node)
+     */
+    class EasyBackfillingBatchScheduler : public HomegrownBatchScheduler {
+
+    public:
+        explicit EasyBackfillingBatchScheduler(BatchComputeService *cs);
+
+        void processQueuedJobs() override;
+
+        void processJobSubmission(std::shared_ptr<BatchJob> batch_job) override;
+        void processJobFailure(std::shared_ptr<BatchJob> batch_job) override;
+        void processJobCompletion(std::shared_ptr<BatchJob> batch_job) override;
+        void processJobTermination(std::shared_ptr<BatchJob> batch_job) override;
+
+        std::map<std::string, std::tuple<unsigned long, double>> scheduleOnHosts(unsigned long, unsigned long, double) override;
+
+        std::map<std::string, double>
+        getStartTimeEstimates(std::set<std::tuple<std::string, unsigned long, unsigned long, double>> set_of_jobs) override;
+
+    private:
+        bool startJob(const std::shared_ptr<BatchJob> &batch_job);
+        void forgetJob(const std::shared_ptr<BatchJob> &batch_job);
+
+        /** @brief The running jobs, sorted by expected end date (i.e., start date + requested time) */
+        std::multimap<double, std::shared_ptr<BatchJob>> running_jobs_by_expected_end_date;
+        /** @brief The position of each running job in running_jobs_by_expected_end_date */
+        std::unordered_map<std::shared_ptr<BatchJob>, std::multimap<double, std::shared_ptr<BatchJob>>::iterator> running_job_positions;
+        /** @brief The number of nodes used by running jobs */
+        unsigned long num_busy_nodes = 0;
+        /** @brief Whether a job event occurred since the queue was last scanned */
+        bool queue_needs_scan = false;
+    };
+
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+}// namespace wrench
+
+
+#endif//WRENCH_EASYBACKFILLINGBATCHSCHEDULER_H
@@ -16,6 +16,9 @@
 
 namespace wrench {
 
+    class CachedFile;
+    class MemoryManager;
+
     /***********************/
     /** \cond INTERNAL    */
     /***********************/
@@ -60,6 +63,8 @@ namespace wrench {
         Block *split(double remaining);
 
     private:
+        friend class MemoryManager;
+
         std::string file_id;
         //        std::string mountpoint;
         std::shared_ptr<FileLocation> location;
@@ -68,6 +73,16 @@ namespace wrench {
         bool dirty;
         double dirty_time;
 
+        // Links in the LRU list of the MemoryManager
+        Block *lru_prev = nullptr;
+        Block *lru_next = nullptr;
+
+        // Links in the per-file block index of the MemoryManager
+        CachedFile *cached_file = nullptr;
+        Block *file_prev = nullptr;
+        Block *file_next = nullptr;
+        bool active = false;
+
         /***********************/
         /** \endcond           */
         /***********************/
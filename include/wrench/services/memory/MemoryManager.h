@@ -11,7 +11,10 @@
 #ifndef WRENCH_MEMORYMANAGER_H
 #define WRENCH_MEMORYMANAGER_H
 
+#include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include "wrench/services/Service.h"
 #include "wrench/simulation/Simulation.h"
 #include "Block.h"
@@ -22,6 +25,52 @@ namespace wrench {
     /** \cond INTERNAL    */
     /***********************/
 
+    /**
+     * @brief A LRU list of cached blocks (intrusive, doubly-linked, least recently used first),
+     * with running totals so that the amounts of cached and dirty data never require a traversal
+     */
+    class LruList {
+    public:
+        /** @brief The least recently used block */
+        Block *head = nullptr;
+        /** @brief The most recently used block */
+        Block *tail = nullptr;
+        /** @brief The total size of the blocks */
+        double cached = 0;
+        /** @brief The total size of the dirty blocks */
+        double dirty = 0;
+    };
+
+    /**
+     * @brief The cached blocks of a file, in the order in which they appear in the inactive
+     * and active LRU lists of a MemoryManager
+     */
+    class CachedFile {
+    public:
+        /** @brief The file id */
+        std::string file_id;
+        /** @brief The first of the file's blocks in the inactive list */
+        Block *inactive_head = nullptr;
+        /** @brief The last of the file's blocks in the inactive list */
+        Block *inactive_tail = nullptr;
+        /** @brief The first of the file's blocks in the active list */
+        Block *active_head = nullptr;
+        /** @brief The last of the file's blocks in the active list */
+        Block *active_tail = nullptr;
+        /** @brief The total size of the file's blocks */
+        double cached = 0;
+        /** @brief The number of the file's blocks */
+        unsigned long num_blocks = 0;
+        /** @brief The offset at which the next read is sequential (or -1) */
+        double readahead_next_offset = -1;
+        /** @brief The current readahead window (0 if the file is not read sequentially) */
+        double readahead_window = 0;
+        /** @brief The amount of data that was read ahead and has not been read yet */
+        double readahead = 0;
+        /** @brief The last readahead disk read */
+        simgrid::s4u::IoPtr readahead_io = nullptr;
+    };
+
     /**
      * @brief A class that implemnets a MemoryManager service to simulate Linux in-memory 
      * page caching for I/O operations
@@ -29,24 +78,81 @@ namespace wrench {
     class MemoryManager : public Service {
 
     public:
+        ~MemoryManager() override;
+
     private:
         simgrid::s4u::Disk *memory;
         double dirty_ratio;
         int interval;
         int expired_time;
-        std::vector<Block *> inactive_list;
-        std::vector<Block *> active_list;
+        LruList inactive_list;
+        LruList active_list;
         double total;
+        unsigned long max_blocks_per_file;
+        double readahead_initial_window;
+        double readahead_max_window;
 
         // We keep track of these properties since we don't want to traverse through two LRU lists to get them.
         double free;
         double cached;
         double dirty;
 
-        std::vector<double> time_log;
-        std::vector<double> dirty_log;
-        std::vector<double> cached_log;
-        std::vector<double> free_log;
+        // Number of dirty blocks for each dirty time, to find the next expiry without traversing LRU lists
+        std::map<double, unsigned long> dirty_times;
+        // Whether periodical flushing is waiting for dirty data
+        bool flusher_idle = false;
+
+        /** @brief A sample of the log, which covers one or more calls to log() */
+        struct LogSample {
+            /** @brief The date of the first call */
+            double time;
+            /** @brief The maximum amount of dirty data */
+            double dirty;
+            /** @brief The maximum amount of cached data */
+            double cached;
+            /** @brief The minimum amount of free memory */
+            double free;
+        };
+
+        // The log, which never holds more than log_max_num_samples samples: when it is full,
+        // adjacent samples are merged pairwise, which doubles the number of calls per sample
+        std::vector<LogSample> log_samples;
+        unsigned long log_max_num_samples;
+        unsigned long log_num_calls_per_sample = 1;
+        unsigned long log_num_calls_in_last_sample = 0;
+
+        static void mergeLogSamples(LogSample &sample, const LogSample &other);
+
+        // Per-file index of the cached blocks
+        std::unordered_map<std::string, std::unique_ptr<CachedFile>> cached_files;
+
+        CachedFile *getCachedFile(const std::string &filename, bool create);
+
+        void releaseCachedFile(CachedFile *cached_file);
+
+        void pushBack(LruList &list, Block *blk);
+
+        void append(LruList &list, Block *blk);
+
+        Block *findCoalescingTarget(LruList &list, Block *blk);
+
+        void remove(LruList &list, Block *blk);
+
+        LruList &getList(Block *blk);
+
+        void setBlockDirty(Block *blk, bool is_dirty);
+
+        void trackDirtyBlock(Block *blk, bool is_dirty);
+
+        double getNextFlushDate(double next_tick);
+
+        void linkBlock(Block *blk, bool active);
+
+        void unlinkBlock(Block *blk);
+
+        void resizeBlock(Block *blk, double size);
+
+        Block *splitBlock(Block *blk, double remaining);
 
 
         MemoryManager(simgrid::s4u::Disk *memory, double dirty_ratio, int interval, int expired_time, std::string hostname);
@@ -57,11 +163,11 @@ namespace wrench {
 
         double pdflush();
 
-        double flushExpiredData(std::vector<Block *> &list);
+        double flushExpiredData(LruList &list);
 
-        double flushLruList(std::vector<Block *> &list, double amount, const std::string &excluded_filename);
+        double flushLruList(LruList &list, double amount, const std::string &excluded_filename);
 
-        double evictLruList(std::vector<Block *> &lru_list, double amount, std::string excluded_filename);
+        double evictLruList(LruList &lru_list, double amount, std::string excluded_filename);
 
     public:
         static std::shared_ptr<MemoryManager> initAndStart(Simulation *simulation, simgrid::s4u::Disk *memory,
@@ -103,6 +209,10 @@ namespace wrench {
 
         void readChunkFromCache(std::string filename, double amount);
 
+        double readFromReadahead(const std::string &filename, double offset, double amount);
+
+        void readAhead(const std::string &filename, const std::shared_ptr<FileLocation> &location, double file_size);
+
         void writebackToCache(std::string filename, std::shared_ptr<FileLocation> location, double amount, bool is_dirty);
 
         void addToCache(std::string filename, std::shared_ptr<FileLocation> location, double amount, bool is_dirty);
@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_MEMORYMANAGERMESSAGE_H
+#define WRENCH_MEMORYMANAGERMESSAGE_H
+
+#include "wrench/services/ServiceMessage.h"
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief Top-level class for messages received/sent by a MemoryManager
+     */
+    class MemoryManagerMessage : public ServiceMessage {
+    protected:
+        MemoryManagerMessage(double payload);
+    };
+
+    /**
+     * @brief A message received by an idle MemoryManager so that it wakes up because
+     *        the page cache now holds dirty data
+     */
+    class MemoryManagerWakeUpMessage : public MemoryManagerMessage {
+    public:
+        MemoryManagerWakeUpMessage(double payload);
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+}// namespace wrench
+
+#endif//WRENCH_MEMORYMANAGERMESSAGE_H
@@ -12,6 +12,7 @@
 
 #include <string>
 #include <set>
+#include <vector>
 
 #include "wrench/services/Service.h"
 #include "wrench/failure_causes/FailureCause.h"
@@ -42,6 +43,9 @@ namespace wrench {
         std::map<std::string, double> getFreeSpace();
 
         std::map<std::string, double> getTotalSpace();
+        std::map<std::string, LogicalFileSystem::CacheStatistics> getCacheStatistics();
+        void pinFile(const std::shared_ptr<FileLocation> &location);
+        void unpinFile(const std::shared_ptr<FileLocation> &location);
         virtual std::string getMountPoint();
         virtual std::set<std::string> getMountPoints();
         virtual bool hasMultipleMountPoints();
@@ -49,6 +53,7 @@ namespace wrench {
 
         static bool lookupFile(const std::shared_ptr<FileLocation> &location);
         virtual bool lookupFile(const std::shared_ptr<DataFile> &file);
+        static std::vector<bool> lookupFiles(const std::vector<std::shared_ptr<FileLocation>> &locations);
 
         /**
          * @brief Check (outside of simulation time) whether the storage service has a file
@@ -79,6 +84,8 @@ namespace wrench {
         static void deleteFile(const std::shared_ptr<FileLocation> &location,
                                const std::shared_ptr<FileRegistryService> &file_registry_service = nullptr);
         virtual void deleteFile(const std::shared_ptr<DataFile> &file, const std::shared_ptr<FileRegistryService> &file_registry_service = nullptr);
+        static void deleteFiles(const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                const std::shared_ptr<FileRegistryService> &file_registry_service = nullptr);
 
         static void readFile(const std::shared_ptr<FileLocation> &location);
         static void readFile(const std::shared_ptr<FileLocation> &location, double num_bytes);
@@ -122,9 +129,16 @@ namespace wrench {
                                      const std::shared_ptr<FileLocation> &src_location,
                                      const std::shared_ptr<FileLocation> &dst_location);
 
-        static void readFiles(std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations);
+        static void readFiles(std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations,
+                              unsigned long max_num_concurrent_reads = 1);
 
-        static void writeFiles(std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations);
+        static void writeFiles(std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations,
+                               unsigned long max_num_concurrent_writes = 1);
+
+        static void lookupOrDeleteFiles(bool lookup,
+                                        const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                        std::vector<bool> &files_are_available,
+                                        std::vector<std::shared_ptr<FailureCause>> &failure_causes);
 
 
         //        StorageService(const std::string &hostname,
@@ -161,7 +175,12 @@ namespace wrench {
         };
 
         static void writeOrReadFiles(FileOperation action,
-                                     std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations);
+                                     std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations,
+                                     unsigned long max_num_concurrent_operations);
+
+        static void writeOrReadFilesConcurrently(FileOperation action,
+                                                 const std::vector<std::shared_ptr<FileLocation>> &sorted_locations,
+                                                 unsigned long max_num_concurrent_operations);
 
         void stageFile(const std::shared_ptr<DataFile> &file, const std::string &mountpoint, std::string path);
 
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "wrench/services/ServiceMessage.h"
 #include "wrench/failure_causes/FailureCause.h"
@@ -123,6 +124,56 @@ namespace wrench {
         std::shared_ptr<FailureCause> failure_cause;
     };
 
+    /**
+     * @brief A message sent to a StorageService to lookup several files at once
+     */
+    class StorageServiceBulkFileLookupRequestMessage : public StorageServiceMessage {
+    public:
+        StorageServiceBulkFileLookupRequestMessage(simgrid::s4u::Mailbox *answer_mailbox,
+                                                   std::vector<std::shared_ptr<FileLocation>> locations, double payload);
+
+        /** @brief Mailbox to which the answer message should be sent */
+        simgrid::s4u::Mailbox *answer_mailbox;
+        /** @brief The file locations */
+        std::vector<std::shared_ptr<FileLocation>> locations;
+    };
+
+    /**
+     * @brief A message sent by a StorageService in answer to a bulk file lookup request
+     */
+    class StorageServiceBulkFileLookupAnswerMessage : public StorageServiceMessage {
+    public:
+        StorageServiceBulkFileLookupAnswerMessage(std::vector<bool> files_are_available, double payload);
+
+        /** @brief Whether each file was found (in the order of the request's locations) */
+        std::vector<bool> files_are_available;
+    };
+
+    /**
+     * @brief A message sent to a StorageService to delete several files at once
+     */
+    class StorageServiceBulkFileDeleteRequestMessage : public StorageServiceMessage {
+    public:
+        StorageServiceBulkFileDeleteRequestMessage(simgrid::s4u::Mailbox *answer_mailbox,
+                                                   std::vector<std::shared_ptr<FileLocation>> locations, double payload);
+
+        /** @brief Mailbox to which the answer message should be sent */
+        simgrid::s4u::Mailbox *answer_mailbox;
+        /** @brief The file locations */
+        std::vector<std::shared_ptr<FileLocation>> locations;
+    };
+
+    /**
+     * @brief A message sent by a StorageService in answer to a bulk file deletion request
+     */
+    class StorageServiceBulkFileDeleteAnswerMessage : public StorageServiceMessage {
+    public:
+        StorageServiceBulkFileDeleteAnswerMessage(std::vector<std::shared_ptr<FailureCause>> failure_causes, double payload);
+
+        /** @brief The cause of the failure of each deletion, or nullptr if success (in the order of the request's locations) */
+        std::vector<std::shared_ptr<FailureCause>> failure_causes;
+    };
+
     /**
     * @brief A message sent to a StorageService to copy a file from another StorageService
     */
@@ -36,8 +36,25 @@ namespace wrench {
          *   - "NONE" (default): no caching, i.e., if not enough space is available for a new file, then the file write/creation fails.
          *   - "LRU": Least Recently Used policy, i.e.,  if not enough space is available for a new file, the Least Recently Used
          *          files are deleted until enough space is available.
+         *   - "LFU": Least Frequently Used policy, i.e., the files that were read the fewest times are deleted first
+         *          (ties are broken in LRU order).
+         *   - "ARC": Adaptive Replacement Cache policy, which balances recency and frequency based on the
+         *          recent history of evicted files.
+         *   - "2Q": Two-Queue policy, in which files read only once are deleted (in FIFO order) before
+         *          files that were read several times (in LRU order).
+         *   - "TTL": Time-To-Live policy, i.e., files are deleted once they have been stored for longer than
+         *          the value of CACHING_TTL, or in FIFO order if more space is needed before that.
+         *
+         *   With all policies other than "NONE", files that are being read or written are never deleted.
          **/
         DECLARE_PROPERTY_NAME(CACHING_BEHAVIOR);
+
+        /** @brief The time-to-live of a file when the caching behavior is "TTL" (ignored otherwise):
+         *
+         *  - Default value: "infinity"
+         *  - Example values: "3600", "3600s", "60min", "1h", etc.
+         **/
+        DECLARE_PROPERTY_NAME(CACHING_TTL);
     };
 
 }// namespace wrench
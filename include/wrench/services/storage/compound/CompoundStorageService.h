@@ -16,6 +16,10 @@
 #include "wrench/simgrid_S4U_util/S4U_PendingCommunication.h"
 #include "wrench/services/storage/compound/CompoundStorageServiceProperty.h"
 #include "wrench/services/storage/compound/CompoundStorageServiceMessagePayload.h"
+#include "wrench/services/storage/compound/StripedFileOperationThread.h"
+#include "wrench/services/storage/compound/FreeSpaceRequestThread.h"
+#include "wrench/services/storage/storage_helpers/BulkFileOperationThread.h"
+#include "wrench/services/storage/compound/StorageSelectionStrategy.h"
 
 namespace wrench {
 
@@ -39,6 +43,9 @@ namespace wrench {
      *        process any of these requests, which should be addressed directly to the correct underlying 
      *        storage service. (A possible future patch could give it the ability to automatically forward 
      *        said request to one of the underlying storage services).
+     *        Files can also be striped over several of the underlying storage services (see the
+     *        CompoundStorageServiceProperty::STRIPE_COUNT property), in which case the CompoundStorageService
+     *        serves their reads, writes, lookups, deletions and copies itself, by accessing all stripes concurrently.
      */
     class CompoundStorageService : public StorageService {
     public:
@@ -75,6 +82,8 @@ namespace wrench {
 
         std::shared_ptr<FileLocation> lookupFileLocation(const std::shared_ptr<FileLocation> &location);
 
+        std::vector<std::shared_ptr<FileLocation>> lookupFileStripeLocations(const std::shared_ptr<DataFile> &file);
+
     protected:
         CompoundStorageService(const std::string &hostname,
                                std::set<std::shared_ptr<StorageService>> storage_services,
@@ -87,7 +96,10 @@ namespace wrench {
         /** @brief Default property values **/
         WRENCH_PROPERTY_COLLECTION_TYPE default_property_values = {
                 {CompoundStorageServiceProperty::STORAGE_SELECTION_METHOD, "external"},
+                {CompoundStorageServiceProperty::STORAGE_SELECTION_WEIGHTED_BY_CAPACITY, "true"},
                 {CompoundStorageServiceProperty::CACHING_BEHAVIOR, "NONE"},
+                {CompoundStorageServiceProperty::STRIPE_COUNT, "1"},
+                {CompoundStorageServiceProperty::STRIPE_SIZE, "1MiB"},
         };
 
         /** @brief Default message payload values 
@@ -99,6 +111,7 @@ namespace wrench {
                 {CompoundStorageServiceMessagePayload::STOP_DAEMON_MESSAGE_PAYLOAD, 1024},
                 {CompoundStorageServiceMessagePayload::DAEMON_STOPPED_MESSAGE_PAYLOAD, 1024},
                 {CompoundStorageServiceMessagePayload::FREE_SPACE_REQUEST_MESSAGE_PAYLOAD, 0},
+                {CompoundStorageServiceMessagePayload::FREE_SPACE_ANSWER_MESSAGE_PAYLOAD, 0},
                 {CompoundStorageServiceMessagePayload::FILE_DELETE_REQUEST_MESSAGE_PAYLOAD, 0},
                 {CompoundStorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD, 0},
                 {CompoundStorageServiceMessagePayload::FILE_LOOKUP_REQUEST_MESSAGE_PAYLOAD, 0},
@@ -119,6 +132,7 @@ namespace wrench {
 
     private:
         friend class Simulation;
+        friend class StripedFileOperationThread;
 
         int main() override;
 
@@ -132,18 +146,53 @@ namespace wrench {
 
         bool processFileLookupRequest(StorageServiceFileLookupRequestMessage *msg);
 
+        bool processBulkFileRequest(BulkFileOperationThread::Operation operation,
+                                    const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                    simgrid::s4u::Mailbox *answer_mailbox);
+
+        bool processFreeSpaceRequest(StorageServiceFreeSpaceRequestMessage *msg);
+
         bool processFileCopyRequest(StorageServiceFileCopyRequestMessage *msg);
 
+        bool processStripedFileCopyRequest(StorageServiceFileCopyRequestMessage *msg, bool src_is_compound, bool dst_is_compound);
+
         bool processFileWriteRequest(StorageServiceFileWriteRequestMessage *msg);
 
         bool processFileReadRequest(StorageServiceFileReadRequestMessage *msg);
 
+        unsigned long getNumStripes(const std::shared_ptr<DataFile> &file);
+
+        std::vector<double> computeStripeSizes(double num_bytes, unsigned long num_stripes);
+
+        std::vector<std::shared_ptr<FileLocation>> designateStripeLocations(const std::shared_ptr<DataFile> &file);
+
+        void forgetFile(const std::shared_ptr<DataFile> &file);
+
+        void forgetStripedFile(const std::shared_ptr<DataFile> &file);
+
+        void startStripedFileOperation(StripedFileOperationThread::Operation operation,
+                                       const std::shared_ptr<FileLocation> &location,
+                                       const std::vector<std::shared_ptr<FileLocation>> &stripe_locations,
+                                       const std::vector<double> &num_bytes_per_stripe,
+                                       simgrid::s4u::Mailbox *answer_mailbox,
+                                       simgrid::s4u::Host *requesting_host,
+                                       const std::shared_ptr<FileLocation> &copy_src = nullptr,
+                                       const std::shared_ptr<FileLocation> &copy_dst = nullptr);
+
         std::set<std::shared_ptr<StorageService>> storage_services = {};
 
         std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> file_location_mapping = {};
 
+        std::map<std::shared_ptr<DataFile>, std::vector<std::shared_ptr<FileLocation>>> stripe_location_mapping = {};
+
+        unsigned long stripe_count;
+
+        double stripe_size;
+
         StorageSelectionStrategyCallback storage_selection;
 
+        std::shared_ptr<StorageSelectionStrategy> storage_selection_strategy = nullptr;
+
         bool isStorageSelectionUserProvided;
     };
 
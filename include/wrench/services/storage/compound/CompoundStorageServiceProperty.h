@@ -21,12 +21,35 @@ namespace wrench {
     class CompoundStorageServiceProperty : public StorageServiceProperty {
     public:
         /** @brief Property that defines how the underlying storage is selected:
-         *         So far the only option is to have an external process that 
-         *         update actions in job (property value: "external"), with the
-         *         CompoundStorageService being passive. A future option would be
-         *         to have the CSS take the decision upon receiving an IO request.
+         *         - "external" (default): an external process updates actions in jobs, or the storage
+         *           selection callback passed to the constructor (if any) is used
+         *         - "round_robin": (weighted) round-robin over all mount points of the storage services
+         *         - "least_used": the mount point with the lowest used space relative to its weight
+         *         - "most_free": the mount point with the most free space
+         *         - "hash": a hash of the file ID, each mount point being picked with a probability proportional to its weight
+         *         - "consistent_hash": consistent hashing of the file ID, with a number of virtual nodes proportional to the weight
+         *         Built-in methods track the space used on each mount point as files are placed on and deleted from it
+         *         through the CompoundStorageService, and never send messages to the storage services. A mount point
+         *         without enough tracked free space is never picked.
          */
         DECLARE_PROPERTY_NAME(STORAGE_SELECTION_METHOD);
+
+        /** @brief Whether the weight of a mount point, for built-in storage selection methods, is its capacity
+         *         ("true", the default) or 1 ("false")
+         */
+        DECLARE_PROPERTY_NAME(STORAGE_SELECTION_WEIGHTED_BY_CAPACITY);
+
+        /** @brief The number of storage services over which a file is striped (default: "1", i.e., no striping).
+         *         A file is split into units of STRIPE_SIZE bytes that are placed in a round-robin fashion on
+         *         min(STRIPE_COUNT, number of storage services, number of units) stripes, each stripe being
+         *         a file placed by the storage selection callback on a distinct storage service. Reads and
+         *         writes of a striped file are performed as concurrent transfers to/from all stripes. Striping
+         *         requires all storage services to be non-bufferized.
+         */
+        DECLARE_PROPERTY_NAME(STRIPE_COUNT);
+
+        /** @brief The stripe unit size, e.g., "1MiB" (default: "1MiB") */
+        DECLARE_PROPERTY_NAME(STRIPE_SIZE);
     };
 
 };// namespace wrench
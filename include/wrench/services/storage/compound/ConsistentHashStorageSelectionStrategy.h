@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_CONSISTENTHASHSTORAGESELECTIONSTRATEGY_H
+#define WRENCH_CONSISTENTHASHSTORAGESELECTIONSTRATEGY_H
+
+#include <map>
+
+#include <wrench/services/storage/compound/StorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A consistent hashing placement strategy: each target owns a number of virtual nodes
+     *        proportional to its weight on a hash ring, and a file is placed on the first eligible
+     *        target found clockwise from the hash of its ID. Adding or removing a storage service only
+     *        moves the files whose hashes fall next to its virtual nodes.
+     */
+    class ConsistentHashStorageSelectionStrategy : public StorageSelectionStrategy {
+
+    public:
+        ConsistentHashStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services, bool weighted_by_capacity);
+
+    protected:
+        long pickTarget(const std::shared_ptr<DataFile> &file,
+                        const std::set<std::shared_ptr<StorageService>> &resources) override;
+
+
+    private:
+        /** @brief The number of virtual nodes of the target with the largest weight */
+        static constexpr unsigned long MAX_NUM_VIRTUAL_NODES = 64;
+
+        std::map<size_t, unsigned long> ring;
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_CONSISTENTHASHSTORAGESELECTIONSTRATEGY_H
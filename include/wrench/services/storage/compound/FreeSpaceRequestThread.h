@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_FREESPACEREQUESTTHREAD_H
+#define WRENCH_FREESPACEREQUESTTHREAD_H
+
+#include <memory>
+
+#include "wrench/services/Service.h"
+
+namespace wrench {
+
+    class CompoundStorageService;
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A helper class that answers a free space request received by a CompoundStorageService,
+     *        so that the CompoundStorageService's daemon does not block while its storage services
+     *        are being asked for their free space
+     */
+    class FreeSpaceRequestThread : public Service {
+
+    public:
+        FreeSpaceRequestThread(const std::string &hostname,
+                               std::shared_ptr<CompoundStorageService> parent,
+                               simgrid::s4u::Mailbox *answer_mailbox);
+
+        int main() override;
+        void cleanup(bool has_returned_from_main, int return_value) override;
+
+    private:
+        std::shared_ptr<CompoundStorageService> parent;
+        simgrid::s4u::Mailbox *answer_mailbox;
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+#endif//WRENCH_FREESPACEREQUESTTHREAD_H
@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_HASHSTORAGESELECTIONSTRATEGY_H
+#define WRENCH_HASHSTORAGESELECTIONSTRATEGY_H
+
+#include <vector>
+
+#include <wrench/services/storage/compound/StorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A placement strategy that picks a target based on a hash of the file ID, each target
+     *        being picked with a probability proportional to its weight (if that target is not eligible,
+     *        the next eligible target in index order is picked)
+     */
+    class HashStorageSelectionStrategy : public StorageSelectionStrategy {
+
+    public:
+        HashStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services, bool weighted_by_capacity);
+
+    protected:
+        long pickTarget(const std::shared_ptr<DataFile> &file,
+                        const std::set<std::shared_ptr<StorageService>> &resources) override;
+
+
+    private:
+        std::vector<double> cumulative_weights;
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_HASHSTORAGESELECTIONSTRATEGY_H
@@ -0,0 +1,42 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_LEASTUSEDSTORAGESELECTIONSTRATEGY_H
+#define WRENCH_LEASTUSEDSTORAGESELECTIONSTRATEGY_H
+
+#include <wrench/services/storage/compound/StorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A placement strategy that picks the eligible target with the lowest used space
+     *        relative to its weight (i.e., the lowest used fraction when weighted by capacity)
+     */
+    class LeastUsedStorageSelectionStrategy : public OrderedStorageSelectionStrategy {
+
+    public:
+        LeastUsedStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services, bool weighted_by_capacity);
+
+    protected:
+        double getKey(unsigned long index) override;
+
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_LEASTUSEDSTORAGESELECTIONSTRATEGY_H
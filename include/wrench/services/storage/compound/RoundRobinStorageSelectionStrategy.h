@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_ROUNDROBINSTORAGESELECTIONSTRATEGY_H
+#define WRENCH_ROUNDROBINSTORAGESELECTIONSTRATEGY_H
+
+#include <wrench/services/storage/compound/StorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A (weighted) round-robin placement strategy, implemented with stride scheduling: each
+     *        target has a pass value that grows by the inverse of its weight each time a file is placed
+     *        on it, and the eligible target with the lowest pass value is picked
+     */
+    class RoundRobinStorageSelectionStrategy : public OrderedStorageSelectionStrategy {
+
+    public:
+        RoundRobinStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services, bool weighted_by_capacity);
+
+    protected:
+        double getKey(unsigned long index) override;
+        void afterTargetUpdate(unsigned long index, bool file_was_added) override;
+
+
+    private:
+        std::vector<double> passes;
+        std::vector<double> strides;
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_ROUNDROBINSTORAGESELECTIONSTRATEGY_H
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_STORAGESELECTIONSTRATEGY_H
+#define WRENCH_STORAGESELECTIONSTRATEGY_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace wrench {
+
+    class DataFile;
+    class FileLocation;
+    class StorageService;
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief An abstract built-in placement strategy for a CompoundStorageService. A strategy chooses
+     *        a target (i.e., a mount point of one of the storage services) for each new file, based on
+     *        per-target counters (tracked used space, number of files) that are updated incrementally
+     *        as files are placed and removed, so that no message is ever sent to the storage services.
+     *        Each target has a weight, which is either its capacity or 1.
+     */
+    class StorageSelectionStrategy {
+
+    public:
+        static std::shared_ptr<StorageSelectionStrategy> createStorageSelectionStrategy(const std::string &name,
+                                                                                        const std::set<std::shared_ptr<StorageService>> &storage_services,
+                                                                                        bool weighted_by_capacity);
+
+        virtual ~StorageSelectionStrategy() = default;
+
+        std::shared_ptr<FileLocation> selectLocation(const std::shared_ptr<DataFile> &file,
+                                                     const std::set<std::shared_ptr<StorageService>> &resources);
+
+        void fileRemoved(const std::shared_ptr<FileLocation> &location);
+
+        double getTrackedUsedSpace(const std::shared_ptr<StorageService> &storage_service, const std::string &mount_point);
+
+    protected:
+        /** @brief A placement target */
+        struct Target {
+            /** @brief The storage service */
+            std::shared_ptr<StorageService> storage_service;
+            /** @brief The mount point */
+            std::string mount_point;
+            /** @brief The capacity in bytes */
+            double capacity;
+            /** @brief The weight */
+            double weight;
+            /** @brief The space used by the files placed on this target */
+            double used_space = 0;
+            /** @brief The number of files placed on this target */
+            unsigned long num_files = 0;
+        };
+
+        StorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services, bool weighted_by_capacity);
+
+        /**
+         * @brief Pick a target for a file
+         * @param file: the file
+         * @param resources: the storage services that may be picked
+         * @return a target index, or -1 if no target is eligible
+         */
+        virtual long pickTarget(const std::shared_ptr<DataFile> &file,
+                                const std::set<std::shared_ptr<StorageService>> &resources) = 0;
+
+        /**
+         * @brief Called right before the counters of a target are updated
+         * @param index: the target index
+         */
+        virtual void beforeTargetUpdate(unsigned long index) {}
+
+        /**
+         * @brief Called right after the counters of a target are updated
+         * @param index: the target index
+         * @param file_was_added: true if a file was placed on the target, false if a file was removed
+         */
+        virtual void afterTargetUpdate(unsigned long index, bool file_was_added) {}
+
+        bool isEligible(unsigned long index, const std::shared_ptr<DataFile> &file,
+                        const std::set<std::shared_ptr<StorageService>> &resources);
+
+        /** @brief The targets */
+        std::vector<Target> targets;
+
+    private:
+        std::map<std::pair<StorageService *, std::string>, unsigned long> target_indices;
+
+        void updateTarget(unsigned long index, double delta_used_space, bool file_was_added);
+    };
+
+    /**
+     * @brief A strategy that keeps targets sorted by a key, and picks the eligible target with the lowest key
+     */
+    class OrderedStorageSelectionStrategy : public StorageSelectionStrategy {
+
+    protected:
+        OrderedStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services, bool weighted_by_capacity);
+
+        void initOrder();
+
+        /**
+         * @brief Compute the sorting key of a target
+         * @param index: the target index
+         * @return a key
+         */
+        virtual double getKey(unsigned long index) = 0;
+
+        long pickTarget(const std::shared_ptr<DataFile> &file,
+                        const std::set<std::shared_ptr<StorageService>> &resources) override;
+        void beforeTargetUpdate(unsigned long index) override;
+        void afterTargetUpdate(unsigned long index, bool file_was_added) override;
+
+    private:
+        std::set<std::pair<double, unsigned long>> ordered_targets;
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+#endif//WRENCH_STORAGESELECTIONSTRATEGY_H
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_STRIPEDFILEOPERATIONTHREAD_H
+#define WRENCH_STRIPEDFILEOPERATIONTHREAD_H
+
+#include <memory>
+#include <vector>
+
+#include "wrench/services/Service.h"
+#include "wrench/services/storage/StorageService.h"
+
+namespace wrench {
+
+    class CompoundStorageService;
+    class FailureCause;
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A helper class that performs one operation (read, write, lookup, delete, copy) on
+     *        a file that a CompoundStorageService has striped over several of its storage services.
+     *        The operation is split into one sub-operation per stripe, all sub-operations proceed
+     *        concurrently, and the operation completes when all of them have completed. Answers
+     *        are sent directly to the mailbox of the client that issued the operation. Deletions of
+     *        files that are not striped also go through this class (with the file as its single
+     *        stripe), so that the file is forgotten only once its deletion has succeeded.
+     */
+    class StripedFileOperationThread : public Service {
+
+    public:
+        /** @brief The operation performed on the striped file */
+        enum Operation {
+            READ,
+            WRITE,
+            LOOKUP,
+            DELETE,
+            COPY_TO_STRIPES,
+            COPY_FROM_STRIPES
+        };
+
+        StripedFileOperationThread(const std::string &hostname,
+                                   std::shared_ptr<CompoundStorageService> parent,
+                                   Operation operation,
+                                   std::shared_ptr<FileLocation> location,
+                                   std::vector<std::shared_ptr<FileLocation>> stripe_locations,
+                                   std::vector<double> num_bytes_per_stripe,
+                                   simgrid::s4u::Mailbox *answer_mailbox,
+                                   simgrid::s4u::Host *requesting_host,
+                                   std::shared_ptr<FileLocation> copy_src = nullptr,
+                                   std::shared_ptr<FileLocation> copy_dst = nullptr);
+
+        int main() override;
+        void cleanup(bool has_returned_from_main, int return_value) override;
+
+    private:
+        /** @brief A sub-operation, i.e., a read or a write of a (possibly partial) file at a location */
+        struct Transfer {
+            /** @brief The location */
+            std::shared_ptr<FileLocation> location;
+            /** @brief Whether this is a read (true) or a write (false) */
+            bool is_read;
+            /** @brief The number of bytes to read */
+            double num_bytes;
+            /** @brief The host whose network link the data goes through */
+            simgrid::s4u::Host *requesting_host;
+            /** @brief Whether this is a write that must be undone if the operation fails */
+            bool undo_on_failure;
+            /** @brief The mailbox on which answers are received */
+            simgrid::s4u::Mailbox *mailbox = nullptr;
+            /** @brief Whether the storage service has accepted the request */
+            bool started = false;
+        };
+
+        std::shared_ptr<CompoundStorageService> parent;
+        Operation operation;
+        std::shared_ptr<FileLocation> location;
+        std::vector<std::shared_ptr<FileLocation>> stripe_locations;
+        std::vector<double> num_bytes_per_stripe;
+        simgrid::s4u::Mailbox *answer_mailbox;
+        simgrid::s4u::Host *requesting_host;
+        std::shared_ptr<FileLocation> copy_src;
+        std::shared_ptr<FileLocation> copy_dst;
+
+        std::shared_ptr<FailureCause> performTransfers(std::vector<Transfer> &transfers, bool answer_client);
+        void undoWrites(std::vector<Transfer> &transfers);
+        void sendClientAnswer(const std::shared_ptr<FailureCause> &failure_cause);
+        void sendClientCopyAnswer(const std::shared_ptr<FailureCause> &failure_cause);
+        void performLookup();
+        void performDelete();
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+#endif//WRENCH_STRIPEDFILEOPERATIONTHREAD_H
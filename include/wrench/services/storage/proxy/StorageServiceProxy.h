@@ -12,9 +12,17 @@
 #include "wrench/services/storage/StorageService.h"
 #include "wrench/services/storage/StorageServiceMessage.h"
 #include "wrench/services/storage/StorageServiceMessagePayload.h"
+#include "wrench/services/storage/storage_helpers/BulkFileOperationThread.h"
 #include "StorageServiceProxyProperty.h"
+#include "StorageServiceProxyMessagePayload.h"
+
+#include <deque>
+#include <list>
 
 namespace wrench {
+
+    class WorkflowTask;
+
     /***********************/
     /** \cond DEVELOPER   **/
     /***********************/
@@ -65,6 +73,13 @@ namespace wrench {
 
         const std::shared_ptr<StorageService> getCache();
 
+        void prefetchFiles(const std::vector<std::shared_ptr<FileLocation>> &locations);
+        void prefetchInputFiles(const std::vector<std::shared_ptr<WorkflowTask>> &tasks,
+                                const std::shared_ptr<StorageService> &targetServer = nullptr);
+
+        void sync();
+        bool isFileDirty(const std::shared_ptr<DataFile> &file);
+
 
         double getLoad();//cache
 
@@ -138,13 +153,107 @@ namespace wrench {
         bool magicRead(unique_ptr<SimulationMessage> &message);
         bool readThrough(unique_ptr<SimulationMessage> &message);
 
+        void startBulkFileOperation(BulkFileOperationThread::Operation operation,
+                                    const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                    const std::vector<std::vector<std::shared_ptr<FileLocation>>> &sub_locations,
+                                    simgrid::s4u::Mailbox *answer_mailbox);
+
+        void startPendingPrefetches();
+        bool processPrefetchCopyAnswer(unique_ptr<SimulationMessage> &message);
+        void processCacheFreeSpaceAnswer(StorageServiceFreeSpaceAnswerMessage *msg);
+
+        /** @brief The maximum number of concurrent prefetches (0 means that prefetching is disabled) **/
+        unsigned long max_num_concurrent_prefetches;
+        /** @brief The locations (at remote storage services) of the files to prefetch, in order **/
+        std::deque<std::shared_ptr<FileLocation>> prefetch_queue;
+        /** @brief The files in the prefetch queue **/
+        std::set<std::shared_ptr<DataFile>> queued_prefetches;
+        /** @brief The files being prefetched **/
+        std::set<std::shared_ptr<DataFile>> ongoing_prefetches;
+        /** @brief The total size of the files being prefetched **/
+        double ongoing_prefetch_bytes = 0;
+        /** @brief Whether the cache evicts files to make room for new ones (in which case prefetches are bounded by its capacity) **/
+        bool cache_evicts_files = false;
+        /** @brief The capacity of the cache **/
+        double cache_capacity = 0;
+        /** @brief The free space in the cache, as last reported by the cache (-1 if it must be asked again) **/
+        double cache_free_space = -1;
+        /** @brief Whether a free space request was sent to the cache and not yet answered **/
+        bool cache_free_space_request_pending = false;
+
+        /** @brief A file that was written to the cache (in write-back mode) but not yet flushed to its remote storage service **/
+        struct DirtyFile {
+            /** @brief The remote storage service **/
+            std::shared_ptr<StorageService> target;
+            /** @brief The file's key in the flush queue (if it is not being flushed) **/
+            std::pair<double, unsigned long> queue_key;
+            /** @brief Whether the file is being flushed **/
+            bool being_flushed = false;
+            /** @brief Whether the file was written again while being flushed **/
+            bool rewritten = false;
+        };
+
+        /** @brief A sync that waits for files to be flushed **/
+        struct PendingSync {
+            /** @brief The mailbox to which the answer should be sent **/
+            simgrid::s4u::Mailbox *answer_mailbox;
+            /** @brief The files that have yet to be flushed **/
+            std::set<std::shared_ptr<DataFile>> files;
+            /** @brief The cause of the first flush failure, if any **/
+            std::shared_ptr<FailureCause> failure_cause;
+        };
+
+        /** @brief A deletion request that waits for the flushes of the files it deletes to complete **/
+        struct DeferredDeletion {
+            /** @brief The files that the request deletes **/
+            std::vector<std::shared_ptr<DataFile>> files;
+            /** @brief The request **/
+            std::unique_ptr<SimulationMessage> message;
+        };
+
+        void markFileDirty(const std::shared_ptr<DataFile> &file, const std::shared_ptr<StorageService> &target);
+        void forgetDirtyFile(const std::shared_ptr<DataFile> &file);
+        void queueFlush(const std::shared_ptr<DataFile> &file, double date);
+        void startPendingFlushes();
+        void fileFlushed(const std::shared_ptr<DataFile> &file, const std::shared_ptr<FailureCause> &failure_cause);
+        bool processFlushCopyAnswer(unique_ptr<SimulationMessage> &message);
+        void processSyncRequest(simgrid::s4u::Mailbox *answer_mailbox);
+        void removeFileFromPendingSyncs(const std::shared_ptr<DataFile> &file, const std::shared_ptr<FailureCause> &failure_cause);
+        void pinFileInCache(const std::shared_ptr<DataFile> &file, bool pin);
+        bool deferDeletionDuringFlushes(const std::vector<std::shared_ptr<DataFile>> &files, unique_ptr<SimulationMessage> &message);
+        void resumeDeferredDeletions();
+        void failPendingSyncsAndDeletions();
+
+        /** @brief Whether the proxy is in write-back mode **/
+        bool write_back;
+        /** @brief The time after which a dirty file is flushed **/
+        double write_back_flush_delay;
+        /** @brief The maximum number of concurrent flushes **/
+        unsigned long max_num_concurrent_flushes;
+        /** @brief The dirty files **/
+        std::map<std::shared_ptr<DataFile>, DirtyFile> dirty_files;
+        /** @brief The dirty files that are not being flushed, sorted by flush date (ties are broken by dirtying order) **/
+        std::map<std::pair<double, unsigned long>, std::shared_ptr<DataFile>> flush_queue;
+        /** @brief A counter used to order the flush queue **/
+        unsigned long flush_sequence_number = 0;
+        /** @brief The number of ongoing flushes **/
+        unsigned long num_ongoing_flushes = 0;
+        /** @brief The syncs that wait for files to be flushed **/
+        std::list<PendingSync> pending_syncs;
+        /** @brief The deletion requests that wait for files to be flushed, in arrival order **/
+        std::list<DeferredDeletion> deferred_deletions;
+
     private:
         /** @brief Default property values */
         WRENCH_PROPERTY_COLLECTION_TYPE default_property_values = {
                 {StorageServiceProperty::BUFFER_SIZE, "10000000"},// 10 MEGA BYTE
                 {StorageServiceProperty::CACHING_BEHAVIOR, "NONE"},
                 {StorageServiceProxyProperty::UNCACHED_READ_METHOD, "CopyThenRead"},
-                {StorageServiceProxyProperty::MESSAGE_OVERHEAD, "0"}};
+                {StorageServiceProxyProperty::MESSAGE_OVERHEAD, "0"},
+                {StorageServiceProxyProperty::PREFETCH_MAX_NUM_CONCURRENT_COPIES, "0"},
+                {StorageServiceProxyProperty::WRITE_BACK, "false"},
+                {StorageServiceProxyProperty::WRITE_BACK_FLUSH_DELAY, "0"},
+                {StorageServiceProxyProperty::WRITE_BACK_MAX_NUM_CONCURRENT_FLUSHES, "1"}};
 
 
         WRENCH_MESSAGE_PAYLOADCOLLECTION_TYPE default_messagepayload_values = {
@@ -162,6 +271,9 @@ namespace wrench {
                 {StorageServiceMessagePayload::FILE_WRITE_ANSWER_MESSAGE_PAYLOAD, 1024},
                 {StorageServiceMessagePayload::FILE_READ_REQUEST_MESSAGE_PAYLOAD, 1024},
                 {StorageServiceMessagePayload::FILE_READ_ANSWER_MESSAGE_PAYLOAD, 1024},
+                {StorageServiceProxyMessagePayload::PREFETCH_REQUEST_MESSAGE_PAYLOAD, 1024},
+                {StorageServiceProxyMessagePayload::SYNC_REQUEST_MESSAGE_PAYLOAD, 1024},
+                {StorageServiceProxyMessagePayload::SYNC_ANSWER_MESSAGE_PAYLOAD, 1024},
 
         };
     };
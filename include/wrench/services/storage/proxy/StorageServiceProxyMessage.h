@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+
+#ifndef WRENCH_STORAGESERVICEPROXYMESSAGE_H
+#define WRENCH_STORAGESERVICEPROXYMESSAGE_H
+
+#include <memory>
+#include <vector>
+
+#include "wrench/services/storage/StorageServiceMessage.h"
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief Top-level class for messages received/sent by a StorageServiceProxy (in addition
+     *        to the messages of a regular StorageService)
+     */
+    class StorageServiceProxyMessage : public StorageServiceMessage {
+    protected:
+        StorageServiceProxyMessage(double payload);
+    };
+
+    /**
+     * @brief A message sent to a StorageServiceProxy to give it hints about files that will be read soon
+     */
+    class StorageServiceProxyPrefetchRequestMessage : public StorageServiceProxyMessage {
+    public:
+        StorageServiceProxyPrefetchRequestMessage(std::vector<std::shared_ptr<FileLocation>> locations, double payload);
+
+        /** @brief The locations (at the remote storage services) of the files to prefetch, in order of expected use */
+        std::vector<std::shared_ptr<FileLocation>> locations;
+    };
+
+    /**
+     * @brief A message sent to a StorageServiceProxy to request that all its dirty files be flushed
+     */
+    class StorageServiceProxySyncRequestMessage : public StorageServiceProxyMessage {
+    public:
+        StorageServiceProxySyncRequestMessage(simgrid::s4u::Mailbox *answer_mailbox, double payload);
+
+        /** @brief The mailbox to which the answer message should be sent */
+        simgrid::s4u::Mailbox *answer_mailbox;
+    };
+
+    /**
+     * @brief A message sent by a StorageServiceProxy once all the files that were dirty when a sync was requested have been flushed
+     */
+    class StorageServiceProxySyncAnswerMessage : public StorageServiceProxyMessage {
+    public:
+        StorageServiceProxySyncAnswerMessage(std::shared_ptr<FailureCause> failure_cause, double payload);
+
+        /** @brief The cause of the failure of a flush, or nullptr if all flushes succeeded */
+        std::shared_ptr<FailureCause> failure_cause;
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+#endif//WRENCH_STORAGESERVICEPROXYMESSAGE_H
@@ -0,0 +1,34 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+
+#ifndef WRENCH_STORAGESERVICEPROXYMESSAGEPAYLOAD_H
+#define WRENCH_STORAGESERVICEPROXYMESSAGEPAYLOAD_H
+
+#include "wrench/services/storage/StorageServiceMessagePayload.h"
+
+namespace wrench {
+
+    /**
+    * @brief Configurable message payloads for a StorageServiceProxy
+    */
+    class StorageServiceProxyMessagePayload : public StorageServiceMessagePayload {
+    public:
+        /** @brief The number of bytes in the control message sent to the daemon to give it prefetching hints **/
+        DECLARE_MESSAGEPAYLOAD_NAME(PREFETCH_REQUEST_MESSAGE_PAYLOAD);
+        /** @brief The number of bytes in the control message sent to the daemon to request that all dirty files be flushed **/
+        DECLARE_MESSAGEPAYLOAD_NAME(SYNC_REQUEST_MESSAGE_PAYLOAD);
+        /** @brief The number of bytes in the control message sent by the daemon once all dirty files have been flushed **/
+        DECLARE_MESSAGEPAYLOAD_NAME(SYNC_ANSWER_MESSAGE_PAYLOAD);
+    };
+
+};// namespace wrench
+
+
+#endif//WRENCH_STORAGESERVICEPROXYMESSAGEPAYLOAD_H
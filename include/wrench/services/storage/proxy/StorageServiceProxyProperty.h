@@ -67,6 +67,31 @@ namespace wrench {
          *  </table>
          **/
         DECLARE_PROPERTY_NAME(UNCACHED_READ_METHOD);
+
+        /** @brief The maximum number of files that the proxy copies concurrently from remote storage services
+         * into its cache when given prefetching hints (see StorageServiceProxy::prefetchFiles()).  Prefetches
+         * proceed in the background, in the order of the hints, and never use more cache space than is
+         * available (or, for a cache with a caching behavior, more than the cache's capacity at any given time).
+         * A read of a file that is being prefetched waits for the prefetch to complete.
+         *  - "0" (default): prefetching is disabled, and prefetching hints are ignored
+         **/
+        DECLARE_PROPERTY_NAME(PREFETCH_MAX_NUM_CONCURRENT_COPIES);
+
+        /** @brief Whether the proxy operates in write-back mode. In this mode, a write completes once the file
+         * is in the cache, and the file is then "dirty" until a background flusher has copied it to its remote storage
+         * service (see WRITE_BACK_FLUSH_DELAY and WRITE_BACK_MAX_NUM_CONCURRENT_FLUSHES). Dirty files cannot be
+         * evicted from the cache. StorageServiceProxy::sync() waits until all currently dirty files have been flushed.
+         *  - "false" (default): once a write to the cache has completed, the file is copied to the remote storage
+         *    service right away
+         *  - "true": write-back mode
+         **/
+        DECLARE_PROPERTY_NAME(WRITE_BACK);
+
+        /** @brief In write-back mode, the time (in seconds) after which a dirty file is flushed (default: "0") **/
+        DECLARE_PROPERTY_NAME(WRITE_BACK_FLUSH_DELAY);
+
+        /** @brief In write-back mode, the maximum number of files that are flushed concurrently (default: "1") **/
+        DECLARE_PROPERTY_NAME(WRITE_BACK_MAX_NUM_CONCURRENT_FLUSHES);
     };
 
 }// namespace wrench
@@ -48,7 +48,8 @@ namespace wrench {
         WRENCH_PROPERTY_COLLECTION_TYPE default_property_values = {
                 {SimpleStorageServiceProperty::MAX_NUM_CONCURRENT_DATA_CONNECTIONS, "infinity"},
                 {SimpleStorageServiceProperty::BUFFER_SIZE, "10000000"},// 10 MEGA BYTE
-                {SimpleStorageServiceProperty::CACHING_BEHAVIOR, "NONE"}};
+                {SimpleStorageServiceProperty::CACHING_BEHAVIOR, "NONE"},
+                {SimpleStorageServiceProperty::CACHING_TTL, "infinity"}};
 
         /** @brief Default message payload values */
         WRENCH_MESSAGE_PAYLOADCOLLECTION_TYPE default_messagepayload_values = {
@@ -107,6 +108,10 @@ namespace wrench {
                                       simgrid::s4u::Mailbox *answer_mailbox);
         bool processFileLookupRequest(const std::shared_ptr<FileLocation> &location,
                                       simgrid::s4u::Mailbox *answer_mailbox);
+        bool processBulkFileDeleteRequest(const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                          simgrid::s4u::Mailbox *answer_mailbox);
+        bool processBulkFileLookupRequest(const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                          simgrid::s4u::Mailbox *answer_mailbox);
         bool processFreeSpaceRequest(simgrid::s4u::Mailbox *answer_mailbox);
 
 
@@ -115,6 +120,8 @@ namespace wrench {
 
         void validateProperties();
 
+        std::shared_ptr<FailureCause> removeFileAtLocation(const std::shared_ptr<FileLocation> &location);
+
         std::shared_ptr<MemoryManager> memory_manager;
     };
 
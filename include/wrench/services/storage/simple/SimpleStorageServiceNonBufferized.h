@@ -139,6 +139,7 @@ namespace wrench {
 
 
         void startPendingTransactions();
+        std::shared_ptr<Transaction> removeRunningTransaction(unsigned long index);
 
         void processTransactionCompletion(const std::shared_ptr<Transaction> &transaction);
         void processTransactionFailure(const std::shared_ptr<Transaction> &transaction);
@@ -146,6 +147,8 @@ namespace wrench {
 
         std::deque<std::shared_ptr<Transaction>> pending_transactions;
         std::vector<std::shared_ptr<Transaction>> running_transactions;
+        /** @brief The activities waited on by the main loop: the control comm, followed by the streams of the running transactions */
+        std::vector<simgrid::s4u::ActivityPtr> pending_activities;
 
         std::map<simgrid::s4u::IoPtr, std::shared_ptr<Transaction>> stream_to_transactions;
 
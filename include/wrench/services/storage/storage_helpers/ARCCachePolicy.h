@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_ARCCACHEPOLICY_H
+#define WRENCH_ARCCACHEPOLICY_H
+
+#include <wrench/services/storage/storage_helpers/CachePolicy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief An Adaptive Replacement Cache policy (Megiddo and Modha), adapted to files of
+     *        arbitrary sizes by accounting for all list sizes in bytes. Files read once are in T1, files
+     *        read more than once are in T2, and the B1/B2 ghost lists remember files recently evicted
+     *        from T1/T2 so as to adapt the target size of T1.
+     */
+    class ARCCachePolicy : public CachePolicy {
+
+    public:
+        explicit ARCCachePolicy(double capacity);
+
+        void fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        LogicalFileSystem::FileOnDisk *getVictim() override;
+        void fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        double getEvictableSize() override;
+
+    private:
+        double capacity;
+        // Target size of T1 (called "p" in the original paper)
+        double target_t1_size = 0;
+
+        // Evictable files in T1 and T2, from least to most recently used
+        LogicalFileSystem::FileOnDiskList t1;
+        LogicalFileSystem::FileOnDiskList t2;
+        // Files involved in running transactions (which still belong to T1 or T2)
+        LogicalFileSystem::FileOnDiskList pinned_list;
+        // Sizes of T1 and T2, including pinned files
+        double t1_size = 0;
+        double t2_size = 0;
+
+        GhostList b1;
+        GhostList b2;
+
+        LogicalFileSystem::FileOnDiskList *getList(const LogicalFileSystem::FileOnDisk *file_on_disk) {
+            return static_cast<LogicalFileSystem::FileOnDiskList *>(file_on_disk->cache_policy_data);
+        }
+        void insertInList(LogicalFileSystem::FileOnDisk *file_on_disk, LogicalFileSystem::FileOnDiskList *list);
+        void unlinkFile(LogicalFileSystem::FileOnDisk *file_on_disk);
+        void trimGhostLists();
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_ARCCACHEPOLICY_H
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_BULKFILEOPERATIONTHREAD_H
+#define WRENCH_BULKFILEOPERATIONTHREAD_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "wrench/services/Service.h"
+#include "wrench/services/storage/StorageService.h"
+
+namespace wrench {
+
+    class FailureCause;
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A helper class that answers a bulk lookup/delete request received by a storage service that
+     *        does not hold files itself (e.g., a CompoundStorageService or a StorageServiceProxy). Each
+     *        file of the request is mapped to one or more locations at other storage services, to which
+     *        a single bulk request per storage service is sent, and one answer is sent back to the client.
+     *        Locations at the parent storage service itself are handled with single-file requests.
+     *        An optional callback is invoked for each file whose deletion has succeeded, so that the
+     *        parent can forget about the file only once it is actually deleted.
+     */
+    class BulkFileOperationThread : public Service {
+
+    public:
+        /** @brief The operation performed on the files */
+        enum Operation {
+            LOOKUP,
+            DELETE
+        };
+
+        BulkFileOperationThread(const std::string &hostname,
+                                std::shared_ptr<StorageService> parent,
+                                Operation operation,
+                                std::vector<std::shared_ptr<FileLocation>> locations,
+                                std::vector<std::vector<std::shared_ptr<FileLocation>>> sub_locations,
+                                bool all_sub_deletions_must_succeed,
+                                simgrid::s4u::Mailbox *answer_mailbox,
+                                std::function<void(const std::shared_ptr<DataFile> &)> file_deleted_callback = nullptr);
+
+        int main() override;
+        void cleanup(bool has_returned_from_main, int return_value) override;
+
+    private:
+        std::shared_ptr<StorageService> parent;
+        Operation operation;
+        std::vector<std::shared_ptr<FileLocation>> locations;
+        std::vector<std::vector<std::shared_ptr<FileLocation>>> sub_locations;
+        bool all_sub_deletions_must_succeed;
+        simgrid::s4u::Mailbox *answer_mailbox;
+        std::function<void(const std::shared_ptr<DataFile> &)> file_deleted_callback;
+
+        void performSingleFileOperations(const std::vector<std::shared_ptr<FileLocation>> &single_locations,
+                                         std::vector<bool> &files_are_available,
+                                         std::vector<std::shared_ptr<FailureCause>> &failure_causes);
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+#endif//WRENCH_BULKFILEOPERATIONTHREAD_H
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_CACHEPOLICY_H
+#define WRENCH_CACHEPOLICY_H
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <wrench/services/storage/storage_helpers/LogicalFileSystem.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief An abstract cache replacement policy, used by a caching logical file system to
+     *        decide which files to evict. The file system notifies the policy of every event
+     *        in the life of a file record, and the policy keeps the records in its own (intrusive)
+     *        lists. A file is "pinned" while it is involved in at least one running transaction,
+     *        in which case it must never be returned as a victim.
+     */
+    class CachePolicy {
+
+    public:
+        static std::unique_ptr<CachePolicy> createCachePolicy(const std::string &name, double capacity, double ttl);
+
+        virtual ~CachePolicy() = default;
+
+        /**
+         * @brief Notify the policy that a file was written (it is not pinned and not known to the policy)
+         * @param file_on_disk: the file's record
+         */
+        virtual void fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) = 0;
+        /**
+         * @brief Notify the policy that a file was read (it may be pinned)
+         * @param file_on_disk: the file's record
+         */
+        virtual void fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) = 0;
+        /**
+         * @brief Notify the policy that a file is being removed (it may be pinned)
+         * @param file_on_disk: the file's record
+         */
+        virtual void fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) = 0;
+        /**
+         * @brief Notify the policy that a file is now involved in a running transaction
+         * @param file_on_disk: the file's record
+         */
+        virtual void filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) = 0;
+        /**
+         * @brief Notify the policy that a file is no longer involved in any running transaction
+         * @param file_on_disk: the file's record
+         */
+        virtual void fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) = 0;
+        /**
+         * @brief Get the file that should be evicted next
+         * @return a record of a file that is not pinned, or nullptr if there is no such file
+         */
+        virtual LogicalFileSystem::FileOnDisk *getVictim() = 0;
+        /**
+         * @brief Notify the policy that a file (returned by getVictim() or getExpiredFile()) is being evicted
+         * @param file_on_disk: the file's record
+         */
+        virtual void fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) = 0;
+        /**
+         * @brief Get the total size of the files that are not pinned
+         * @return a number of bytes
+         */
+        virtual double getEvictableSize() = 0;
+        /**
+         * @brief Get a file that has expired, if any
+         * @param date: the current date
+         * @return a record of a file that is not pinned, or nullptr if no file has expired
+         */
+        virtual LogicalFileSystem::FileOnDisk *getExpiredFile(double date) { return nullptr; }
+
+    protected:
+        /**
+         * @brief Next sequence number (used to order records in lists)
+         */
+        unsigned long next_sequence_number = 0;
+
+        /**
+         * @brief A FIFO list of recently evicted files, of which only the keys and sizes are
+         *        remembered (used by policies that adapt to their eviction history)
+         */
+        class GhostList {
+        public:
+            /**
+             * @brief Check whether a file is in the list
+             * @param key: the file's key
+             * @return true if the file is in the list
+             */
+            bool contains(const LogicalFileSystem::FileKey &key) const {
+                return this->index.find(key) != this->index.end();
+            }
+            /**
+             * @brief Remove a file from the list, if it is there
+             * @param key: the file's key
+             * @return true if the file was in the list
+             */
+            bool remove(const LogicalFileSystem::FileKey &key) {
+                auto it = this->index.find(key);
+                if (it == this->index.end()) {
+                    return false;
+                }
+                this->total_size -= it->second->second;
+                this->entries.erase(it->second);
+                this->index.erase(it);
+                return true;
+            }
+            /**
+             * @brief Append a file at the end of the list
+             * @param key: the file's key (which must not be in the list)
+             * @param size: the file's size
+             */
+            void pushBack(const LogicalFileSystem::FileKey &key, double size) {
+                this->entries.emplace_back(key, size);
+                this->index[key] = std::prev(this->entries.end());
+                this->total_size += size;
+            }
+            /**
+             * @brief Remove the first (oldest) file in the list
+             */
+            void popFront() {
+                this->total_size -= this->entries.front().second;
+                this->index.erase(this->entries.front().first);
+                this->entries.pop_front();
+            }
+            /**
+             * @brief Check whether the list is empty
+             * @return true if empty
+             */
+            bool empty() const { return this->entries.empty(); }
+            /**
+             * @brief Get the total size of the files in the list
+             * @return a number of bytes
+             */
+            double getTotalSize() const { return this->total_size; }
+
+        private:
+            std::list<std::pair<LogicalFileSystem::FileKey, double>> entries;
+            std::unordered_map<LogicalFileSystem::FileKey,
+                               std::list<std::pair<LogicalFileSystem::FileKey, double>>::iterator,
+                               LogicalFileSystem::FileKeyHash>
+                    index;
+            double total_size = 0;
+        };
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_CACHEPOLICY_H
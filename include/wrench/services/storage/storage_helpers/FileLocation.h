@@ -10,10 +10,13 @@
 #ifndef WRENCH_FILELOCATION_H
 #define WRENCH_FILELOCATION_H
 
+#include <cstdint>
 #include <memory>
 #include <iostream>
+#include <string>
 #include <utility>
 #include <unordered_map>
+#include <vector>
 
 
 namespace wrench {
@@ -129,10 +132,72 @@ namespace wrench {
                                                                 const std::shared_ptr<DataFile> &file,
                                                                 bool is_scratch);
 
-        static void reclaimFileLocations();
+        /**
+         * @brief A key that uniquely identifies a file location in the registry of
+         *        file locations (all strings are interned so that the key is cheap
+         *        to build, hash, and compare, and interned strings are reference-counted
+         *        by the registered locations that use them)
+         */
+        struct Key {
+            /** @brief The storage service (nullptr for SCRATCH) */
+            const StorageService *storage_service;
+            /** @brief The interned mount point */
+            uint32_t mount_point_id;
+            /** @brief The interned path at the mount point */
+            uint32_t path_id;
+            /** @brief The file */
+            const DataFile *file;
+            /** @brief Whether the location is SCRATCH */
+            bool is_scratch;
+
+            /**
+             * @brief Equality operator
+             * @param other: another key
+             * @return true if both keys are equal
+             */
+            bool operator==(const Key &other) const {
+                return (storage_service == other.storage_service) and
+                       (mount_point_id == other.mount_point_id) and
+                       (path_id == other.path_id) and
+                       (file == other.file) and
+                       (is_scratch == other.is_scratch);
+            }
+        };
 
-        static std::unordered_map<std::string, std::shared_ptr<FileLocation>> file_location_map;
-        static size_t file_location_map_previous_size;
+        /**
+         * @brief Hash functor for file location keys
+         */
+        struct KeyHash {
+            /**
+             * @brief Hash a key
+             * @param key: the key
+             * @return a hash value
+             */
+            size_t operator()(const Key &key) const {
+                size_t h = std::hash<const void *>()(key.storage_service);
+                h ^= std::hash<const void *>()(key.file) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+                h ^= ((static_cast<size_t>(key.mount_point_id) << 32) | key.path_id) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+                return h ^ static_cast<size_t>(key.is_scratch);
+            }
+        };
+
+        /**
+         * @brief An interned string's ID and the number of registered locations that use it
+         */
+        struct InternedString {
+            /** @brief The string's ID */
+            uint32_t id;
+            /** @brief The number of references to the string */
+            unsigned long num_references;
+        };
+
+        static uint32_t internString(const std::string &str);
+        static void releaseString(const std::string &str);
+        static void forgetFileLocation(const Key &key, const std::string &mp, const std::string &apamp);
+
+        static std::unordered_map<std::string, InternedString> interned_strings;
+        static std::vector<uint32_t> free_interned_string_ids;
+        static std::unordered_map<Key, std::weak_ptr<FileLocation>, KeyHash> file_location_map;
     };
 
     /***********************/
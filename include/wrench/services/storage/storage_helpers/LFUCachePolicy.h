@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_LFUCACHEPOLICY_H
+#define WRENCH_LFUCACHEPOLICY_H
+
+#include <wrench/services/storage/storage_helpers/CachePolicy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A Least Frequently Used cache replacement policy (ties are broken in LRU order). Files
+     *        are kept in a list of frequency buckets sorted by increasing frequency, so that all
+     *        operations are O(1): an accessed file only ever moves to the next bucket.
+     */
+    class LFUCachePolicy : public CachePolicy {
+
+    public:
+        LFUCachePolicy() = default;
+        ~LFUCachePolicy() override;
+
+        void fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        LogicalFileSystem::FileOnDisk *getVictim() override;
+        void fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        double getEvictableSize() override;
+
+    private:
+        // A bucket of files that have been accessed the same number of times. A pinned file
+        // keeps a reference to its bucket, so that it can go back in it once unpinned.
+        struct Bucket {
+            unsigned long frequency;
+            LogicalFileSystem::FileOnDiskList files;// evictable files, from least to most recently used
+            unsigned long num_pinned_files = 0;
+            Bucket *previous = nullptr;
+            Bucket *next = nullptr;
+        };
+
+        // Bucket with the lowest frequency
+        Bucket *first_bucket = nullptr;
+        // Files involved in running transactions
+        LogicalFileSystem::FileOnDiskList pinned_list;
+        double evictable_size = 0;
+
+        static Bucket *getBucket(const LogicalFileSystem::FileOnDisk *file_on_disk) {
+            return static_cast<Bucket *>(file_on_disk->cache_policy_data);
+        }
+        Bucket *getOrCreateBucketAfter(Bucket *bucket, unsigned long frequency);
+        void releaseBucketIfUnused(Bucket *bucket);
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_LFUCACHEPOLICY_H
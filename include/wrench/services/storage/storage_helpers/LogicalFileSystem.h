@@ -10,11 +10,14 @@
 #ifndef WRENCH_LOGICALFILESYSTEM_H
 #define WRENCH_LOGICALFILESYSTEM_H
 
+#include <cfloat>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <map>
 #include <unordered_map>
 #include <set>
+#include <vector>
 #include <memory>
 #include <iostream>
 
@@ -47,14 +50,208 @@ namespace wrench {
         public:
             /**
 	     * @brief Constructor
+	     * @param file: the file
+	     * @param directory_id: the (interned) ID of the directory that holds the file
 	     * @param last_write_date: the file's last write date
 	     */
-            explicit FileOnDisk(double last_write_date) : last_write_date(last_write_date) {}
+            FileOnDisk(std::shared_ptr<DataFile> file, uint32_t directory_id, double last_write_date) : file(std::move(file)),
+                                                                                                       directory_id(directory_id),
+                                                                                                       last_write_date(last_write_date) {}
 
+            /**
+	     * @brief the file
+	     */
+            std::shared_ptr<DataFile> file;
+            /**
+	     * @brief the (interned) ID of the directory that holds the file
+	     */
+            uint32_t directory_id;
             /**
 	     * @brief the file's last write date
 	     */
             double last_write_date;
+            /**
+             * @brief The number of transactions that involve this file (used by caching file systems,
+             *        for which a file is not evictable if > 0)
+             */
+            unsigned short num_current_transactions = 0;
+            /**
+             * @brief A sequence number used by caching file systems (lower means older)
+             */
+            unsigned long lru_sequence_number = 0;
+            /**
+             * @brief Opaque per-file data for the cache replacement policy, if any
+             */
+            void *cache_policy_data = nullptr;
+
+        private:
+            friend class LogicalFileSystem;
+            friend class FileOnDiskList;
+            // Intrusive links in the list of files of the same directory
+            FileOnDisk *previous_in_directory = nullptr;
+            FileOnDisk *next_in_directory = nullptr;
+            // Intrusive links in the (caching policy) list that holds this file, if any
+            FileOnDisk *previous_in_list = nullptr;
+            FileOnDisk *next_in_list = nullptr;
+        };
+
+        /**
+         * @brief An intrusive doubly-linked list of file records, in which all operations
+         *        are O(1) (a record can be in at most one such list at a time)
+         */
+        class FileOnDiskList {
+        public:
+            /**
+             * @brief Get the first record in the list
+             * @return a record, or nullptr if the list is empty
+             */
+            FileOnDisk *front() const { return this->head; }
+            /**
+             * @brief Get the last record in the list
+             * @return a record, or nullptr if the list is empty
+             */
+            FileOnDisk *back() const { return this->tail; }
+            /**
+             * @brief Get the record after a record in the list
+             * @param file_on_disk: a record in the list
+             * @return a record, or nullptr if at the end of the list
+             */
+            static FileOnDisk *next(const FileOnDisk *file_on_disk) { return file_on_disk->next_in_list; }
+            /**
+             * @brief Get the record before a record in the list
+             * @param file_on_disk: a record in the list
+             * @return a record, or nullptr if at the beginning of the list
+             */
+            static FileOnDisk *previous(const FileOnDisk *file_on_disk) { return file_on_disk->previous_in_list; }
+            /**
+             * @brief Determine whether the list is empty
+             * @return true or false
+             */
+            bool empty() const { return this->head == nullptr; }
+            /**
+             * @brief Get the number of records in the list
+             * @return a number of records
+             */
+            size_t size() const { return this->num_records; }
+            /**
+             * @brief Get the sum of the sizes of the files in the list
+             * @return a number of bytes
+             */
+            double getTotalSize() const { return this->total_size; }
+
+            /**
+             * @brief Append a record at the end of the list
+             * @param file_on_disk: a record that is not in any list
+             */
+            void pushBack(FileOnDisk *file_on_disk) { this->insertAfter(this->tail, file_on_disk); }
+
+            /**
+             * @brief Insert a record in a list sorted by sequence number. The scan starts from
+             *        the end of the list, where recently used records almost always belong.
+             * @param file_on_disk: a record that is not in any list
+             */
+            void insertBySequenceNumber(FileOnDisk *file_on_disk) {
+                auto position = this->tail;
+                while ((position != nullptr) and (position->lru_sequence_number > file_on_disk->lru_sequence_number)) {
+                    position = position->previous_in_list;
+                }
+                this->insertAfter(position, file_on_disk);
+            }
+
+            /**
+             * @brief Insert a record after a record of the list
+             * @param position: a record in the list (nullptr means "at the beginning of the list")
+             * @param file_on_disk: a record that is not in any list
+             */
+            void insertAfter(FileOnDisk *position, FileOnDisk *file_on_disk) {
+                file_on_disk->previous_in_list = position;
+                file_on_disk->next_in_list = position ? position->next_in_list : this->head;
+                if (file_on_disk->next_in_list) {
+                    file_on_disk->next_in_list->previous_in_list = file_on_disk;
+                } else {
+                    this->tail = file_on_disk;
+                }
+                if (position) {
+                    position->next_in_list = file_on_disk;
+                } else {
+                    this->head = file_on_disk;
+                }
+                this->num_records++;
+                this->total_size += file_on_disk->file->getSize();
+            }
+
+            /**
+             * @brief Remove a record from the list
+             * @param file_on_disk: a record in the list
+             */
+            void remove(FileOnDisk *file_on_disk) {
+                if (file_on_disk->previous_in_list) {
+                    file_on_disk->previous_in_list->next_in_list = file_on_disk->next_in_list;
+                } else {
+                    this->head = file_on_disk->next_in_list;
+                }
+                if (file_on_disk->next_in_list) {
+                    file_on_disk->next_in_list->previous_in_list = file_on_disk->previous_in_list;
+                } else {
+                    this->tail = file_on_disk->previous_in_list;
+                }
+                file_on_disk->previous_in_list = nullptr;
+                file_on_disk->next_in_list = nullptr;
+                this->num_records--;
+                this->total_size -= file_on_disk->file->getSize();
+            }
+
+        private:
+            FileOnDisk *head = nullptr;
+            FileOnDisk *tail = nullptr;
+            size_t num_records = 0;
+            double total_size = 0;
+        };
+
+        /**
+         * @brief A key for a file in a directory
+         */
+        struct FileKey {
+            /** @brief The (interned) directory ID */
+            uint32_t directory_id;
+            /** @brief The file */
+            const DataFile *file;
+
+            /**
+             * @brief Equality operator
+             * @param other: another key
+             * @return true if both keys are equal
+             */
+            bool operator==(const FileKey &other) const {
+                return (directory_id == other.directory_id) and (file == other.file);
+            }
+        };
+
+        /**
+         * @brief Hash functor for file keys
+         */
+        struct FileKeyHash {
+            /**
+             * @brief Hash a key
+             * @param key: the key
+             * @return a hash value
+             */
+            size_t operator()(const FileKey &key) const {
+                size_t h = std::hash<const void *>()(key.file);
+                return h ^ (static_cast<size_t>(key.directory_id) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+            }
+        };
+
+        /**
+         * @brief Cache statistics (only meaningful for file systems with a caching behavior)
+         */
+        struct CacheStatistics {
+            /** @brief Number of reads of files that were present */
+            unsigned long num_hits = 0;
+            /** @brief Number of reads of files that were not present */
+            unsigned long num_misses = 0;
+            /** @brief Number of files evicted (or expired) */
+            unsigned long num_evictions = 0;
         };
 
         /**
@@ -65,7 +262,8 @@ namespace wrench {
         static std::unique_ptr<LogicalFileSystem> createLogicalFileSystem(const std::string &hostname,
                                                                           StorageService *storage_service,
                                                                           const std::string &mount_point = DEV_NULL,
-                                                                          const std::string &eviction_policy = "NONE");
+                                                                          const std::string &eviction_policy = "NONE",
+                                                                          double caching_ttl = DBL_MAX);
 
         void init();
         bool isInitialized();
@@ -91,6 +289,10 @@ namespace wrench {
 
         double getFileLastWriteDate(const std::shared_ptr<DataFile> &file, const std::string &absolute_path);
 
+        std::string getCachingBehavior();
+        CacheStatistics getCacheStatistics();
+        void recordCacheMiss();
+
         /**
          * @brief Store file in directory
          *
@@ -158,6 +360,20 @@ namespace wrench {
          */
         virtual bool evictFiles(double needed_free_space) = 0;
 
+        /**
+         * @brief Method to remove files that have expired (based on caching policy), if any
+         */
+        virtual void evictExpiredFiles() {}
+
+        /**
+         * @brief The caching behavior
+         */
+        std::string caching_behavior = "NONE";
+        /**
+         * @brief Cache statistics
+         */
+        CacheStatistics cache_statistics;
+
         /**
          * @brief The disk
          */
@@ -182,19 +398,64 @@ namespace wrench {
          * @brief current amout of free space
          */
         double free_space = 0;
+        /**
+         * @brief A helper struct to describe a directory
+         */
+        struct Directory {
+            /** @brief The directory's sanitized path */
+            std::string path;
+            /** @brief Whether the directory currently exists */
+            bool exists = false;
+            /** @brief The number of files in the directory */
+            size_t num_files = 0;
+            /** @brief The head of the intrusive list of the files in the directory */
+            FileOnDisk *first_file = nullptr;
+        };
+
         /**
          * @brief list of space reservations
          */
-        std::map<std::string, double> reserved_space;
+        std::unordered_map<FileKey, double, FileKeyHash> reserved_space;
 
         /**
          * @brief whether the file system is initialized
          */
         bool initialized;
+
+        /**
+         * @brief All directories ever created (or reserved into), indexed by their interned IDs
+         */
+        std::vector<Directory> directories;
         /**
-         * @brief file system content
+         * @brief Map of (sanitized or not) directory paths to interned directory IDs
          */
-        std::unordered_map<std::string, std::map<std::shared_ptr<DataFile>, std::shared_ptr<LogicalFileSystem::FileOnDisk>>> content;
+        std::unordered_map<std::string, uint32_t> directory_ids;
+        /**
+         * @brief file system content, as a single table indexed by directory and file (records
+         *        are stored in the table's nodes, and thus never move)
+         */
+        std::unordered_map<FileKey, FileOnDisk, FileKeyHash> content;
+
+        /** @brief The ID returned when looking up a directory that was never interned */
+        static constexpr uint32_t NO_DIRECTORY = UINT32_MAX;
+
+        uint32_t internDirectory(const std::string &absolute_path);
+        uint32_t findDirectoryID(const std::string &absolute_path);
+        FileOnDisk *lookupFileOnDisk(const std::shared_ptr<DataFile> &file, uint32_t directory_id);
+        FileOnDisk *addFileOnDisk(const std::shared_ptr<DataFile> &file, uint32_t directory_id, double last_write_date);
+        void removeFileOnDisk(FileOnDisk *file_on_disk);
+        bool consumeReservation(const std::shared_ptr<DataFile> &file, uint32_t directory_id);
+
+        /**
+         * @brief Get the directory with the given ID, creating it if it does not exist
+         * @param directory_id: the directory ID
+         * @return the directory
+         */
+        Directory &ensureDirectoryExists(uint32_t directory_id) {
+            auto &dir = this->directories[directory_id];
+            dir.exists = true;
+            return dir;
+        }
 
         /**
          * @brief Assert that file system has been initialized
@@ -208,11 +469,14 @@ namespace wrench {
         /**
          * @brief Assert that a directory exists
          * @param absolute_path: the path
+         * @return the directory
          */
-        void assertDirectoryExist(const std::string &absolute_path) {
-            if (not this->doesDirectoryExist(absolute_path)) {
+        Directory &assertDirectoryExist(const std::string &absolute_path) {
+            auto directory_id = this->findDirectoryID(absolute_path);
+            if ((directory_id == NO_DIRECTORY) or (not this->directories[directory_id].exists)) {
                 throw std::invalid_argument("LogicalFileSystem::assertDirectoryExists(): directory " + absolute_path + " does not exist");
             }
+            return this->directories[directory_id];
         }
 
         /**
@@ -240,13 +504,16 @@ namespace wrench {
          * @brief Assert that a file is in a directory
          * @param file: the file
          * @param absolute_path: the path
+         * @return the file's record
          */
-        void assertFileIsInDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) {
-            assertDirectoryExist(absolute_path);
-            if (this->content[absolute_path].find(file) == this->content[absolute_path].end()) {
+        FileOnDisk *assertFileIsInDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) {
+            auto &dir = assertDirectoryExist(absolute_path);
+            auto file_on_disk = this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path));
+            if (file_on_disk == nullptr) {
                 throw std::invalid_argument("LogicalFileSystem::assertFileIsInDirectory(): File " + file->getID() +
-                                            " is not in directory " + absolute_path);
+                                            " is not in directory " + dir.path);
             }
+            return file_on_disk;
         }
     };
 
@@ -36,39 +36,11 @@ namespace wrench {
      */
     class LogicalFileSystemLRUCaching : public LogicalFileSystem {
 
-    public:
-        /**
-	 * @brief A helper struct to describe a file instance on disk
-	 */
-        struct FileOnDiskLRUCaching : public FileOnDisk {
-        public:
-            /**
-             * @brief Constructor
-             * @param last_write_date Last write date
-             * @param lru_sequence_number LRU sequence number
-             * @param num_current_transactions Number of current transactions using this file on disk
-             */
-            FileOnDiskLRUCaching(double last_write_date,
-                                 unsigned int lru_sequence_number,
-                                 unsigned short num_current_transactions) : FileOnDisk(last_write_date),
-                                                                            lru_sequence_number(lru_sequence_number),
-                                                                            num_current_transactions(num_current_transactions) {}
-
-            /**
-             * @brief The LRU sequence number (lower means older)
-             */
-            unsigned int lru_sequence_number;
-            /**
-             * @brief The number of transactions that involve this file, meaning that it's not evictable is > 0
-             */
-            unsigned short num_current_transactions;
-        };
-
     public:
         /**
          * @brief Next LRU sequence number
          */
-        unsigned int next_lru_sequence_number = 0;
+        unsigned long next_lru_sequence_number = 0;
 
         void storeFileInDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path, bool must_be_initialized) override;
         void removeFileFromDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) override;
@@ -89,12 +61,17 @@ namespace wrench {
                                              const std::string &mount_point);
 
 
-        std::map<unsigned int, std::tuple<std::string, std::shared_ptr<DataFile>>> lru_list;
+        // Evictable files, from least to most recently used
+        FileOnDiskList lru_list;
+        // Files involved in running transactions, which cannot be evicted
+        FileOnDiskList pinned_list;
+
+        void unlinkFile(FileOnDisk *file_on_disk);
 
         void print_lru_list() {
             std::cerr << "LRU LIST:\n";
-            for (auto const &lru: this->lru_list) {
-                std::cerr << "[" << lru.first << "] " << std::get<0>(lru.second) << ":" << std::get<1>(lru.second)->getID() << "\n";
+            for (auto f = this->lru_list.front(); f != nullptr; f = FileOnDiskList::next(f)) {
+                std::cerr << "[" << f->lru_sequence_number << "] " << this->directories[f->directory_id].path << ":" << f->file->getID() << "\n";
             }
         }
 
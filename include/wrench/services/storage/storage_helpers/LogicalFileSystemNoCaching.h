@@ -37,11 +37,6 @@ namespace wrench {
      */
     class LogicalFileSystemNoCaching : public LogicalFileSystem {
 
-        class FileOnDiskNoCaching : public FileOnDisk {
-        public:
-            explicit FileOnDiskNoCaching(double last_write_date) : FileOnDisk(last_write_date) {}
-        };
-
     public:
         void storeFileInDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path, bool must_be_initializede) override;
         void removeFileFromDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) override;
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_LOGICALFILESYSTEMPOLICYCACHING_H
+#define WRENCH_LOGICALFILESYSTEMPOLICYCACHING_H
+
+#include <string>
+#include <memory>
+
+#include <wrench/services/storage/storage_helpers/LogicalFileSystem.h>
+#include <wrench/services/storage/storage_helpers/CachePolicy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+
+    class StorageService;
+
+    /**
+     * @brief  A class that implements a weak file system abstraction, in which files are evicted
+     *         based on a pluggable cache replacement policy
+     */
+    class LogicalFileSystemPolicyCaching : public LogicalFileSystem {
+
+    public:
+        void storeFileInDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path, bool must_be_initialized) override;
+        void removeFileFromDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) override;
+        void removeAllFilesInDirectory(const std::string &absolute_path) override;
+        void updateReadDate(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) override;
+        void incrementNumRunningTransactionsForFileInDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) override;
+        void decrementNumRunningTransactionsForFileInDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) override;
+
+    protected:
+        bool evictFiles(double needed_free_space) override;
+        void evictExpiredFiles() override;
+
+    private:
+        friend class StorageService;
+        friend class LogicalFileSystem;
+
+        explicit LogicalFileSystemPolicyCaching(const std::string &hostname,
+                                                StorageService *storage_service,
+                                                const std::string &mount_point,
+                                                const std::string &caching_behavior,
+                                                double caching_ttl);
+
+        std::unique_ptr<CachePolicy> policy;
+
+        void evictFile(FileOnDisk *file_on_disk);
+    };
+
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_LOGICALFILESYSTEMPOLICYCACHING_H
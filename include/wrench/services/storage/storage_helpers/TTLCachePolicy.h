@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_TTLCACHEPOLICY_H
+#define WRENCH_TTLCACHEPOLICY_H
+
+#include <wrench/services/storage/storage_helpers/CachePolicy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A Time-To-Live cache replacement policy: a file expires a fixed amount of time after
+     *        it was written, and files are evicted in FIFO (i.e., write date) order when space is needed
+     *        before they expire.
+     */
+    class TTLCachePolicy : public CachePolicy {
+
+    public:
+        explicit TTLCachePolicy(double ttl);
+
+        void fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        LogicalFileSystem::FileOnDisk *getVictim() override;
+        void fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        double getEvictableSize() override;
+        LogicalFileSystem::FileOnDisk *getExpiredFile(double date) override;
+
+    private:
+        double ttl;
+
+        // Evictable files, by increasing write date
+        LogicalFileSystem::FileOnDiskList fifo_list;
+        // Files involved in running transactions
+        LogicalFileSystem::FileOnDiskList pinned_list;
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_TTLCACHEPOLICY_H
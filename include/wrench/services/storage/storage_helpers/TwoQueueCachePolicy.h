@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_TWOQUEUECACHEPOLICY_H
+#define WRENCH_TWOQUEUECACHEPOLICY_H
+
+#include <wrench/services/storage/storage_helpers/CachePolicy.h>
+
+namespace wrench {
+
+    /***********************/
+    /** \cond INTERNAL     */
+    /***********************/
+
+    /**
+     * @brief A 2Q cache replacement policy (Johnson and Shasha, full version), with all list sizes
+     *        accounted for in bytes. New files go in the A1in FIFO, files evicted from A1in are
+     *        remembered in the A1out ghost list, and files written again while in A1out go to
+     *        the Am LRU list.
+     */
+    class TwoQueueCachePolicy : public CachePolicy {
+
+    public:
+        explicit TwoQueueCachePolicy(double capacity);
+
+        void fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        void fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        LogicalFileSystem::FileOnDisk *getVictim() override;
+        void fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) override;
+        double getEvictableSize() override;
+
+    private:
+        // Target size of A1in ("Kin", 25% of the capacity in the original paper)
+        double a1in_target_size;
+        // Maximum size of A1out ("Kout", 50% of the capacity in the original paper)
+        double a1out_max_size;
+
+        // Evictable files in A1in (FIFO order) and in Am (from least to most recently used)
+        LogicalFileSystem::FileOnDiskList a1in;
+        LogicalFileSystem::FileOnDiskList am;
+        // Files involved in running transactions (which still belong to A1in or Am)
+        LogicalFileSystem::FileOnDiskList pinned_list;
+        // Size of A1in, including pinned files
+        double a1in_size = 0;
+
+        GhostList a1out;
+
+        LogicalFileSystem::FileOnDiskList *getList(const LogicalFileSystem::FileOnDisk *file_on_disk) {
+            return static_cast<LogicalFileSystem::FileOnDiskList *>(file_on_disk->cache_policy_data);
+        }
+        void insertInList(LogicalFileSystem::FileOnDisk *file_on_disk, LogicalFileSystem::FileOnDiskList *list);
+        void unlinkFile(LogicalFileSystem::FileOnDisk *file_on_disk);
+    };
+
+    /***********************/
+    /** \endcond           */
+    /***********************/
+
+}// namespace wrench
+
+
+#endif//WRENCH_TWOQUEUECACHEPOLICY_H
@@ -10,6 +10,9 @@
 
 #ifndef WRENCH_XROOTD_CACHE_H
 #define WRENCH_XROOTD_CACHE_H
+#include <deque>
+#include <map>
+#include <tuple>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -25,25 +28,44 @@ namespace wrench {
         /** \cond INTERNAL     */
         /***********************/
         /**
-         * @brief A class that implements the XRootD cache
+         * @brief A class that implements the XRootD cache, i.e., a map of data files to the locations at which
+         *        they were found, each with a time-to-live. Since all entries have the same time-to-live, the
+         *        order in which entries are added/updated is the order in which they expire, so entries are kept
+         *        in a FIFO queue and expired entries are removed lazily from its head, in O(1) amortized time.
          */
         class Cache {
+        public:
+            /** @brief Statistics of cache lookups */
+            struct Statistics {
+                /** @brief Number of lookups of files that were cached */
+                unsigned long num_hits = 0;
+                /** @brief Number of lookups of files that were not cached */
+                unsigned long num_misses = 0;
+                /** @brief Number of entries that expired */
+                unsigned long num_expirations = 0;
+            };
+
         private:
             /** @brief The internal cache data structure, currently just a map of data files pointers to a set of file locations, each with corresponding last update time */
             std::unordered_map<std::shared_ptr<DataFile>, std::map<std::shared_ptr<FileLocation>, double>> cache;//possibly change time to last access time
+            /** @brief The entries in the order in which they were added or updated (an entry that was updated also appears with its earlier update times, which are ignored) */
+            std::deque<std::tuple<double, std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>>> expiry_queue;
+            /** @brief The statistics */
+            Statistics statistics;
+
+            void removeExpiredEntries();
+
         public:
             /** @brief The maximum time an unupdated entry can remain in the cache.*/
             double maxCacheTime = std::numeric_limits<double>::infinity();
-            bool isCached(std::shared_ptr<DataFile> file);
+            bool isCached(const std::shared_ptr<DataFile> &file);
             void add(const std::shared_ptr<DataFile> &file, const std::shared_ptr<FileLocation> &location);
             void add(const std::shared_ptr<DataFile> &file, const std::set<std::shared_ptr<FileLocation>> &locations);
             std::set<std::shared_ptr<FileLocation>> get(const std::shared_ptr<DataFile> &file);
 
             std::set<std::shared_ptr<FileLocation>> operator[](const std::shared_ptr<DataFile> &file);
             void remove(const std::shared_ptr<DataFile> &file);
-#if 0
-            void clean();
-#endif
+            Statistics getStatistics() const;
         };
 
         /***********************/
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#ifndef WRENCH_XROOTD_COUNTINGBLOOMFILTER_H
+#define WRENCH_XROOTD_COUNTINGBLOOMFILTER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wrench {
+    namespace XRootD {
+
+        /***********************/
+        /** \cond INTERNAL     */
+        /***********************/
+
+        /**
+         * @brief A counting Bloom filter of strings, i.e., a Bloom filter whose cells are (8-bit) counters
+         *        so that elements can be removed as well as added. A lookup never yields a false negative,
+         *        and yields a false positive with a probability that depends on the number of counters,
+         *        of hash functions, and of elements. A counter that saturates is never decremented again
+         *        (which may cause false positives, but never false negatives).
+         */
+        class CountingBloomFilter {
+        public:
+            CountingBloomFilter(unsigned long num_counters, unsigned long num_hash_functions);
+
+            void add(const std::string &key);
+            void remove(const std::string &key);
+            bool mayContain(const std::string &key) const;
+
+        private:
+            std::vector<uint8_t> counters;
+            unsigned long num_hash_functions;
+
+            unsigned long getCounterIndex(uint64_t h1, uint64_t h2, unsigned long i) const;
+            static void hash(const std::string &key, uint64_t &h1, uint64_t &h2);
+        };
+
+        /***********************/
+        /** \endcond           */
+        /***********************/
+    }// namespace XRootD
+}// namespace wrench
+
+#endif//WRENCH_XROOTD_COUNTINGBLOOMFILTER_H
@@ -18,6 +18,8 @@
 #ifndef WRENCH_XROOTD_Deployment_H
 #define WRENCH_XROOTD_Deployment_H
 #include "wrench/services/Service.h"
+#include <map>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -78,6 +80,9 @@ namespace wrench {
 
             friend Node;
             std::vector<std::shared_ptr<Node>> getFileNodes(std::shared_ptr<DataFile> file);
+            void addFileLocation(const std::shared_ptr<DataFile> &file, const std::shared_ptr<Node> &location);
+            std::shared_ptr<Node> getBestFileNode(const std::shared_ptr<DataFile> &file, Node *subtree_root);
+            double getRouteLatency(Node *src, Node *dst);
             std::shared_ptr<Node> createNode(const std::string &hostname, WRENCH_PROPERTY_COLLECTION_TYPE property_list_override, WRENCH_MESSAGE_PAYLOADCOLLECTION_TYPE messagepayload_list_override);
             /** @brief All nodes that are connected to this XRootD data Federation */
             std::vector<std::shared_ptr<Node>> nodes;
@@ -87,6 +92,10 @@ namespace wrench {
             std::vector<std::shared_ptr<Node>> supervisors;
             /** @brief All files within the data federation regardless of which server */
             std::unordered_map<std::shared_ptr<DataFile>, std::vector<std::shared_ptr<Node>>> files;
+            /** @brief For each file, and for each node running a reduced simulation whose subtree has copies of the file, the nodes with these copies ranked by route latency from that node */
+            std::unordered_map<std::shared_ptr<DataFile>, std::unordered_map<Node *, std::vector<std::pair<double, std::shared_ptr<Node>>>>> ranked_file_nodes;
+            /** @brief The latencies of the routes between nodes, as they are computed */
+            std::map<std::pair<Node *, Node *>, double> route_latencies;
             /** @brief The simulation that this XRootD federation is connected too */
             std::shared_ptr<Simulation> simulation;
             /***********************/
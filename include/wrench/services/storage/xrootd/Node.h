@@ -13,14 +13,18 @@
 #include "wrench/services/storage/xrootd/XRootDMessagePayload.h"
 #include <stack>
 #include "wrench/services/storage/xrootd/Cache.h"
+#include "wrench/services/storage/xrootd/CountingBloomFilter.h"
 
 #include <wrench/services/storage/xrootd/XRootDProperty.h>
 
 //todo overload mountpoint functions
 namespace wrench {
+    class StorageServiceBulkFileLookupRequestMessage;
+
     namespace XRootD {
         class Deployment;
         class SearchStack;
+        struct BulkSearch;
         /**
          * @brief An XRootD node, this can be either a supervisor or a storage server.
          * All nodes are classified as storage services even though not all have physical storage
@@ -38,6 +42,8 @@ namespace wrench {
             std::shared_ptr<Node> getChild(unsigned int n);
             Node *getParent();
 
+            Cache::Statistics getCacheLookupStatistics();
+
             /***********************/
             /** \cond DEVELOPER    */
             /***********************/
@@ -62,11 +68,16 @@ namespace wrench {
                     {Property::CACHE_MAX_LIFETIME, "infinity"},
                     {StorageServiceProperty::BUFFER_SIZE, "1000000"},
                     {Property::REDUCED_SIMULATION, "false"},
-                    {Property::FILE_NOT_FOUND_TIMEOUT, "30"}};
+                    {Property::FILE_NOT_FOUND_TIMEOUT, "30"},
+                    {Property::SEARCH_WITH_BLOOM_FILTERS, "false"},
+                    {Property::BLOOM_FILTER_NUM_COUNTERS, "65536"},
+                    {Property::BLOOM_FILTER_NUM_HASH_FUNCTIONS, "4"}};
 
             WRENCH_MESSAGE_PAYLOADCOLLECTION_TYPE default_messagepayload_values = {
                     {MessagePayload::STOP_DAEMON_MESSAGE_PAYLOAD, 1024},
                     {MessagePayload::DAEMON_STOPPED_MESSAGE_PAYLOAD, 1024},
+                    {MessagePayload::FREE_SPACE_REQUEST_MESSAGE_PAYLOAD, 1024},
+                    {MessagePayload::FREE_SPACE_ANSWER_MESSAGE_PAYLOAD, 1024},
                     {MessagePayload::FILE_LOOKUP_REQUEST_MESSAGE_PAYLOAD, 1024},
                     {MessagePayload::FILE_LOOKUP_ANSWER_MESSAGE_PAYLOAD, 1024},
                     {MessagePayload::UPDATE_CACHE, 1024},
@@ -124,9 +135,20 @@ namespace wrench {
             map<Node *, vector<stack<Node *>>> splitStack(vector<stack<Node *>> search_stack);
             virtual std::shared_ptr<FileLocation> selectBest(std::set<std::shared_ptr<FileLocation>> locations);
             vector<stack<Node *>> constructFileSearchTree(const vector<shared_ptr<Node>> &targets);
+            vector<stack<Node *>> constructBestFileSearchTree(const std::shared_ptr<DataFile> &file);
             stack<Node *> constructSearchStack(Node *target);
             //std::shared_ptr<FileLocation> hasFile(shared_ptr<DataFile> file);
 
+            void addToSubtreeFilter(const std::shared_ptr<DataFile> &file);
+            void removeFromSubtreeFilter(const std::shared_ptr<DataFile> &file);
+            bool mayHaveFileInSubtree(const std::shared_ptr<DataFile> &file);
+
+            void startFileDeletion(const std::shared_ptr<DataFile> &file, double payload);
+            bool processBulkFileLookupRequest(StorageServiceBulkFileLookupRequestMessage *msg);
+            void broadcastBulkSearch(const std::shared_ptr<BulkSearch> &search, const std::vector<std::shared_ptr<DataFile>> &files,
+                                     Node *node, int timeToLive);
+            void answerBulkSearch(const std::shared_ptr<BulkSearch> &search);
+
             bool makeSupervisor();
             bool makeFileServer(std::set<std::string> path, WRENCH_PROPERTY_COLLECTION_TYPE property_list,
                                 WRENCH_MESSAGE_PAYLOADCOLLECTION_TYPE messagepayload_list);
@@ -141,8 +163,12 @@ namespace wrench {
             Node *supervisor = nullptr;
             /** @brief The Meta supervisor for this entire XRootD data federation */
             Deployment *metavisor = nullptr;
-            /** @brief Whether this node is running a reduced simulation.  Initilized from the properties in main */
+            /** @brief Whether this node is running a reduced simulation.  Initialized from the properties in the constructor */
             bool reduced;
+            /** @brief Whether this node maintains a Bloom filter of the files in its subtree.  Initialized from the properties in the constructor */
+            bool use_bloom_filter = false;
+            /** @brief The Bloom filter of the files in the subtree, IF it uses one and some files were added to it */
+            std::unique_ptr<CountingBloomFilter> subtree_filter = nullptr;
             friend Deployment;
             friend SearchStack;
             /***********************/
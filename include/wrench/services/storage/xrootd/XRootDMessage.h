@@ -12,7 +12,10 @@
 #define WRENCH_XRootDMessage_H
 
 
+#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "wrench/services/ServiceMessage.h"
 #include "wrench/failure_causes/FailureCause.h"
@@ -160,6 +163,70 @@ namespace wrench {
             std::vector<std::stack<Node *>> search_stack;
         };
 
+        /**
+         * @brief The state of an ongoing aggregated search for several files, which is shared by all the messages of the search
+         */
+        struct BulkSearch {
+            /** @brief Mailbox to which the FINAL answer message should be sent */
+            simgrid::s4u::Mailbox *answer_mailbox = nullptr;
+            /** @brief Whether each file of the request was found (in the order of the request's locations) */
+            std::vector<bool> files_are_available;
+            /** @brief The indices in the request of each file that is still searched for */
+            std::unordered_map<std::shared_ptr<DataFile>, std::vector<size_t>> pending_files;
+            /** @brief Whether or not the calling client has been answered yet */
+            bool answered = false;
+        };
+
+        /**
+         * @brief A message sent to a XRootD Node to continue an ongoing aggregated search for several files
+         */
+        class ContinueBulkSearchMessage : public Message {
+        public:
+            ContinueBulkSearchMessage(std::shared_ptr<BulkSearch> search,
+                                      std::vector<std::shared_ptr<DataFile>> files,
+                                      Node *node,
+                                      double payload,
+                                      int timeToLive);
+
+            /** @brief The state of the search */
+            std::shared_ptr<BulkSearch> search;
+            /** @brief The files being searched for in the subtree of the receiving node */
+            std::vector<std::shared_ptr<DataFile>> files;
+            /** @brief The node that originally received the bulk file lookup request */
+            Node *node;
+            /** @brief How many more hops this message can live for, to prevent messages living forever in improper configurations with loops.*/
+            int timeToLive;
+        };
+
+        /**
+         * @brief A message sent to a XRootD Node to update the cache with all the files found in a subtree during an aggregated search
+         */
+        class UpdateBulkCacheMessage : public Message {
+        public:
+            UpdateBulkCacheMessage(std::shared_ptr<BulkSearch> search,
+                                   Node *node,
+                                   std::map<std::shared_ptr<DataFile>, std::set<std::shared_ptr<FileLocation>>> locations,
+                                   double payload);
+            UpdateBulkCacheMessage(UpdateBulkCacheMessage *other);
+
+            /** @brief The state of the search */
+            std::shared_ptr<BulkSearch> search;
+            /** @brief The highest node in the tree to return to when caching (should be the node the original message was sent) */
+            Node *node;
+            /** @brief The locations to cache, for each file found */
+            std::map<std::shared_ptr<DataFile>, std::set<std::shared_ptr<FileLocation>>> locations;
+        };
+
+        /**
+         * @brief A message that acts as a timeout for aggregated searches in which some files were not found
+         */
+        class BulkFileNotFoundAlarm : public Message {
+        public:
+            explicit BulkFileNotFoundAlarm(std::shared_ptr<BulkSearch> search);
+
+            /** @brief The state of the search */
+            std::shared_ptr<BulkSearch> search;
+        };
 
         /***********************/
         /** \endcond           */
@@ -28,10 +28,26 @@ namespace wrench {
              * can be determined in zero simulation time based on data structure lookups). This
              * makes the simulation faster but less accurate, which may not be desirable if the overhead
              * and/or network load of the control
-             * messages involved in the search is an important part of the simulation (default is "false") **/
+             * messages involved in the search is an important part of the simulation. Searches then only go to
+             * the node that has the file and whose route from the searching node has the lowest latency, which
+             * is given in O(1) time by an index of file locations that is updated as files are created and
+             * deleted (default is "false") **/
             DECLARE_PROPERTY_NAME(REDUCED_SIMULATION);
             /** @brief The ammount of time a supervisor should wait after a file request before sending a "file not found" message. Default: 30, Default unit: second. Example: "30", "20s", "100ms", etc.  */
             DECLARE_PROPERTY_NAME(FILE_NOT_FOUND_TIMEOUT);
+            /** @brief If set to "true", then the node maintains a counting Bloom filter of the files stored in its
+             * subtree (which is updated in zero simulation time as files are created, written, and deleted through
+             * XRootD nodes), and the search broadcasts of its supervisor skip it when that filter shows that the file
+             * is not in its subtree. This reduces the number of control messages per search to roughly those sent
+             * along the paths to the nodes that have the file, plus those due to false positives. Files that are
+             * stored at a node without going through XRootD (e.g., copied to it) are not in the filters, and thus
+             * are only found by searches from the node itself (default is "false") **/
+            DECLARE_PROPERTY_NAME(SEARCH_WITH_BLOOM_FILTERS);
+            /** @brief The number of (8-bit) counters of the Bloom filter of a node, when SEARCH_WITH_BLOOM_FILTERS is "true". The larger
+             * the number of counters per file in the subtree, the lower the false positive rate (default is "65536") **/
+            DECLARE_PROPERTY_NAME(BLOOM_FILTER_NUM_COUNTERS);
+            /** @brief The number of hash functions of the Bloom filter of a node, when SEARCH_WITH_BLOOM_FILTERS is "true" (default is "4") **/
+            DECLARE_PROPERTY_NAME(BLOOM_FILTER_NUM_HASH_FUNCTIONS);
         };
 
     }// namespace XRootD
@@ -40,6 +40,7 @@ namespace wrench {
         static bool hostExists(const std::string &hostname);
         static bool linkExists(const std::string &link_name);
         static std::vector<std::string> getRoute(std::string &src_host, std::string &dst_host);
+        static double getRouteLatency(const std::string &src_host, const std::string &dst_host);
         static unsigned int getHostNumCores(const std::string &hostname);
         static unsigned int getNumCores();
         static double getHostFlopRate(const std::string &hostname);
@@ -12,6 +12,7 @@
 #define WRENCH_SIMULATION_H
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <nlohmann/json.hpp>
 #include <wrench/services/compute/bare_metal/BareMetalComputeServiceOneShot.h>
@@ -164,10 +165,13 @@ namespace wrench {
                                                     const std::string &write_mount_point);
         void writeToDisk(double num_bytes, const std::string &hostname, const std::string &mount_point);
 
-        void readWithMemoryCache(const std::shared_ptr<DataFile> &file, double n_bytes, const std::shared_ptr<FileLocation> &location);
+        void readWithMemoryCache(const std::shared_ptr<DataFile> &file, double n_bytes, const std::shared_ptr<FileLocation> &location, double offset = -1);
         void writebackWithMemoryCache(const std::shared_ptr<DataFile> &file, double n_bytes, const std::shared_ptr<FileLocation> &location, bool is_dirty);
         void writeThroughWithMemoryCache(const std::shared_ptr<DataFile> &file, double n_bytes, const std::shared_ptr<FileLocation> &location);
         MemoryManager *getMemoryManagerByHost(const std::string &hostname);
+        MemoryManager *getMemoryManagerByHost(simgrid::s4u::Host *host);
+        const std::vector<std::shared_ptr<ComputeService>> &getComputeServicesByHost(const std::string &hostname);
+        const std::vector<std::shared_ptr<StorageService>> &getStorageServicesByHost(const std::string &hostname);
 
         static double getMemoryCapacity();
         static unsigned long getNumCores();
@@ -178,6 +182,10 @@ namespace wrench {
         static double getLinkUsage(const std::string &link_name);
         static double getLinkBandwidth(const std::string &link_name);
         static bool isPageCachingEnabled();
+        static unsigned long getPageCacheMaxExtentsPerFile();
+        static double getPageCacheReadaheadInitialWindow();
+        static double getPageCacheReadaheadMaxWindow();
+        static unsigned long getPageCacheLogMaxNumSamples();
         static bool isHostShutdownSimulationEnabled();
         static bool isLinkShutdownSimulationEnabled();
         static bool isEnergySimulationEnabled();
@@ -211,6 +219,11 @@ namespace wrench {
 
         std::set<std::shared_ptr<MemoryManager>> memory_managers;
 
+        // Per-host registries of the above services
+        std::unordered_map<std::string, std::vector<std::shared_ptr<ComputeService>>> compute_services_by_host;
+        std::unordered_map<std::string, std::vector<std::shared_ptr<StorageService>>> storage_services_by_host;
+        std::unordered_map<std::string, MemoryManager *> memory_managers_by_host;
+
         static int unique_disk_sequence_number;
 
         void stageFile(const std::shared_ptr<FileLocation> &location);
@@ -239,6 +252,10 @@ namespace wrench {
         static bool host_shutdown_enabled;
         static bool link_shutdown_enabled;
         static bool pagecache_enabled;
+        static unsigned long pagecache_max_extents_per_file;
+        static double pagecache_readahead_initial_window;
+        static double pagecache_readahead_max_window;
+        static unsigned long pagecache_log_max_num_samples;
 
         static bool initialized;
 
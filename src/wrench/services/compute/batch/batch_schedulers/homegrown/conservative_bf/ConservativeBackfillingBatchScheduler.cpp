@@ -123,6 +123,8 @@ namespace wrench {
         // For each job in the order of the BatchComputeService queue:
         //   - remove the job from the schedule
         //   - re-insert it as early as possible
+        // A job that cannot start earlier would be re-inserted where it was, so it is
+        // left alone (which is the case of most jobs)
 
         // Reset the time origin
         auto now = (u_int32_t) Simulation::getCurrentSimulatedDate();
@@ -132,15 +134,29 @@ namespace wrench {
         for (auto const &batch_job: this->cs->batch_queue) {
             //            WRENCH_INFO("DEALING WITH JOB %lu", batch_job->getJobID());
 
-            // Remove the job from the schedule
-            //            WRENCH_INFO("REMOVING IT FROM SCHEDULE");
-            this->schedule->remove(batch_job->conservative_bf_start_date, batch_job->conservative_bf_expected_end_date + 100, batch_job);
-            //            this->schedule->print();
-
-            // Find the earliest start time
-            //            WRENCH_INFO("FINDING THE EARLIEST START TIME");
-            auto est = this->schedule->findEarliestStartTime(batch_job->getRequestedTime(), batch_job->getRequestedNumNodes());
-            //            WRENCH_INFO("EARLIEST START TIME FOR IT: %u", est);
+            u_int32_t est;
+            if (batch_job->conservative_bf_start_date >= now) {
+                // To start earlier, the job needs enough available nodes at some date before its start date
+                if (this->schedule->getMaxAvailableNodesBefore(batch_job->conservative_bf_start_date) < batch_job->getRequestedNumNodes()) {
+                    continue;
+                }
+                est = this->schedule->findEarlierStartTime(batch_job->getRequestedTime(), batch_job, batch_job->conservative_bf_start_date);
+                if (est == UINT32_MAX) {
+                    continue;
+                }
+                // Remove the job from the schedule
+                this->schedule->remove(batch_job->conservative_bf_start_date, batch_job->conservative_bf_expected_end_date + 100, batch_job);
+            } else {
+                // Remove the job from the schedule
+                //            WRENCH_INFO("REMOVING IT FROM SCHEDULE");
+                this->schedule->remove(batch_job->conservative_bf_start_date, batch_job->conservative_bf_expected_end_date + 100, batch_job);
+                //            this->schedule->print();
+
+                // Find the earliest start time
+                //            WRENCH_INFO("FINDING THE EARLIEST START TIME");
+                est = this->schedule->findEarliestStartTime(batch_job->getRequestedTime(), batch_job->getRequestedNumNodes());
+                //            WRENCH_INFO("EARLIEST START TIME FOR IT: %u", est);
+            }
             // Insert it in the schedule
             this->schedule->add(est, est + batch_job->getRequestedTime(), batch_job);
             //            WRENCH_INFO("RE-INSERTED THERE!");
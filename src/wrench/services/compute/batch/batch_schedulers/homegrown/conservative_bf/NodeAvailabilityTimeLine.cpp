@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2017-2021. The WRENCH Team.
+ * Copyright (c) 2017-2018. The WRENCH Team.
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -7,43 +7,31 @@
  * (at your option) any later version.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <set>
 #include "wrench/services/compute/batch/batch_schedulers/homegrown/conservative_bf/NodeAvailabilityTimeLine.h"
-#include <boost/icl/interval_map.hpp>
-#include <utility>
+#include <boost/icl/interval_set.hpp>
 #include <wrench/services/compute/batch/BatchJob.h>
 
 namespace wrench {
 
-    /**
-     * @brief Overloaded operator
-     * @param left: left-hand side
-     * @param right: right-hand side
-     * @return
-     */
-    bool operator==(const BatchJobSet &left, const BatchJobSet &right) {
-        return left.jobs == right.jobs;
-    }
-
     /**
      * @brief Constructor
      * @param max_num_nodes: number of nodes on the platform
      */
     NodeAvailabilityTimeLine::NodeAvailabilityTimeLine(unsigned long max_num_nodes) : max_num_nodes(max_num_nodes) {
-        std::set<BatchJob *> empty_set;
-        this->availability_timeslots += make_pair(boost::icl::interval<u_int32_t>::right_open(0, UINT32_MAX),
-                                                  BatchJobSet());
     }
 
     /**
      * @brief Method to clear the node availability timeline
      */
     void NodeAvailabilityTimeLine::clear() {
-        this->availability_timeslots.clear();
-        std::set<BatchJob *> empty_set;
-        this->availability_timeslots += make_pair(boost::icl::interval<u_int32_t>::right_open(0, UINT32_MAX),
-                                                  BatchJobSet());
+        this->time_origin = 0;
+        this->num_nodes_utilized.clear();
+        this->reservations.clear();
+        this->reservations_by_start.clear();
+        this->reservations_by_end.clear();
     }
 
     /**
@@ -51,22 +39,22 @@ namespace wrench {
      * @param t: a date
      */
     void NodeAvailabilityTimeLine::setTimeOrigin(u_int32_t t) {
-        while (true) {
-            auto ts = this->availability_timeslots.begin();
-            if (ts->first.lower() >= t) {
-                return;
-            } else if (ts->first.upper() <= t) {
-                this->availability_timeslots.erase(ts);
-                continue;
-            } else {
-                u_int32_t new_left = t;
-                u_int32_t new_right = ts->first.upper();
-                BatchJobSet job_set = ts->second;
-                this->availability_timeslots.erase(ts);
-                this->availability_timeslots += make_pair(
-                        boost::icl::interval<u_int32_t>::right_open(new_left, new_right), job_set);
-                return;
+        if (t <= this->time_origin) {
+            return;
+        }
+        this->time_origin = t;
+
+        // Forget about the jobs that are no longer in the timeline
+        while ((not this->reservations_by_end.empty()) and (this->reservations_by_end.begin()->first <= t)) {
+            auto job = this->reservations_by_end.begin()->second;
+            auto &reservation = this->reservations[job];
+            for (auto const &interval: reservation.intervals) {
+                this->num_nodes_utilized.add(boost::icl::first(interval), boost::icl::last_next(interval),
+                                             -((long) job->getRequestedNumNodes()));
             }
+            this->reservations_by_start.erase(reservation.by_start);
+            this->reservations_by_end.erase(reservation.by_end);
+            this->reservations.erase(job);
         }
     }
 
@@ -75,10 +63,10 @@ namespace wrench {
      */
     void NodeAvailabilityTimeLine::print() {
         std::cerr << "------ SCHEDULE -----\n";
-        for (auto &availability_timeslot: this->availability_timeslots) {
-            std::cerr << availability_timeslot.first << "(" << availability_timeslot.second.num_nodes_utilized << ") | ";
-            for (auto const &j: availability_timeslot.second.jobs) {
-                std::cerr << j->getJobID() << "(" << j->getRequestedNumNodes() << ") ";
+        for (auto const &entry: this->reservations_by_start) {
+            std::cerr << entry.second->getJobID() << "(" << entry.second->getRequestedNumNodes() << ") | ";
+            for (auto const &interval: this->reservations[entry.second].intervals) {
+                std::cerr << "[" << boost::icl::first(interval) << "," << boost::icl::last_next(interval) << ") ";
             }
             std::cerr << "\n";
         }
@@ -93,16 +81,56 @@ namespace wrench {
      * @param job: the BatchComputeService job
      */
     void NodeAvailabilityTimeLine::update(bool add, u_int32_t start, u_int32_t end, std::shared_ptr<BatchJob> job) {
-        auto job_set = new BatchJobSet();
-        job_set->add(std::move(job));
+        if (start >= end) {
+            return;
+        }
+
+        // A job is in the timeline at most once at any date, so only the dates at which it
+        // is not (resp. is) in the timeline are added (resp. removed)
+        boost::icl::interval_set<u_int32_t> dates;
+        dates += boost::icl::interval<u_int32_t>::right_open(start, end);
+        auto it = this->reservations.find(job);
+        if (add) {
+            if (it != this->reservations.end()) {
+                dates -= it->second.intervals;
+            }
+        } else {
+            if (it == this->reservations.end()) {
+                return;
+            }
+            dates &= it->second.intervals;
+        }
+        if (dates.empty()) {
+            return;
+        }
+
+        auto num_nodes = (long) job->getRequestedNumNodes();
+        for (auto const &interval: dates) {
+            this->num_nodes_utilized.add(boost::icl::first(interval), boost::icl::last_next(interval),
+                                         (add ? num_nodes : -num_nodes));
+        }
 
+        // Update the reservation table
+        if (it == this->reservations.end()) {
+            it = this->reservations.insert(std::make_pair(job, Reservation())).first;
+        } else {
+            this->reservations_by_start.erase(it->second.by_start);
+            this->reservations_by_end.erase(it->second.by_end);
+        }
+        auto &reservation = it->second;
         if (add) {
-            this->availability_timeslots +=
-                    make_pair(boost::icl::interval<u_int32_t>::right_open(start, end), *job_set);
+            reservation.intervals += dates;
         } else {
-            this->availability_timeslots -=
-                    make_pair(boost::icl::interval<u_int32_t>::right_open(start, end), *job_set);
+            reservation.intervals -= dates;
         }
+        if (reservation.intervals.empty()) {
+            this->reservations.erase(it);
+            return;
+        }
+        reservation.by_start = this->reservations_by_start.insert(
+                std::make_pair(boost::icl::first(*reservation.intervals.begin()), job));
+        reservation.by_end = this->reservations_by_end.insert(
+                std::make_pair(boost::icl::last_next(*reservation.intervals.rbegin()), job));
     }
 
     /**
@@ -112,34 +140,79 @@ namespace wrench {
      * @return a date
      */
     u_int32_t NodeAvailabilityTimeLine::findEarliestStartTime(uint32_t duration, unsigned long num_nodes) {
-        uint32_t start_time = UINT32_MAX;
-        uint32_t remaining_duration = duration;
+        return this->findEarliestStartTime(duration, num_nodes, UINT32_MAX);
+    }
 
-        for (auto &availability_timeslot: this->availability_timeslots) {
-            unsigned long available_nodes = this->max_num_nodes - availability_timeslot.second.num_nodes_utilized;
+    /**
+     * @brief Method to find whether a job that is in the timeline could start earlier than it does,
+     *        i.e., as if it were removed from the timeline
+     * @param duration: the job's duration
+     * @param job: the BatchComputeService job
+     * @param start: the job's current start date
+     * @return the earliest date before start at which the job could start, or UINT32_MAX if there is none
+     */
+    u_int32_t NodeAvailabilityTimeLine::findEarlierStartTime(uint32_t duration, const std::shared_ptr<BatchJob> &job, u_int32_t start) {
+        auto it = this->reservations.find(job);
+        if (it == this->reservations.end()) {
+            return this->findEarliestStartTime(duration, job->getRequestedNumNodes(), start);
+        }
+
+        // Temporarily take the job out of the utilization counts
+        auto num_nodes = (long) job->getRequestedNumNodes();
+        for (auto const &interval: it->second.intervals) {
+            this->num_nodes_utilized.add(boost::icl::first(interval), boost::icl::last_next(interval), -num_nodes);
+        }
+        auto est = this->findEarliestStartTime(duration, job->getRequestedNumNodes(), start);
+        for (auto const &interval: it->second.intervals) {
+            this->num_nodes_utilized.add(boost::icl::first(interval), boost::icl::last_next(interval), num_nodes);
+        }
+        return est;
+    }
 
-            // Nope!
-            if (available_nodes < num_nodes) {
-                start_time = UINT32_MAX;
-                continue;
+    /**
+     * @brief Method to find the earliest start time for a job spec
+     * @param duration: the job's duration
+     * @param num_nodes: the job's number of nodes
+     * @param latest_start: the date at or after which a start time is not looked for
+     * @return a date, or UINT32_MAX if there is none before latest_start
+     */
+    u_int32_t NodeAvailabilityTimeLine::findEarliestStartTime(uint32_t duration, unsigned long num_nodes, u_int32_t latest_start) {
+        if (num_nodes > this->max_num_nodes) {
+            return UINT32_MAX;
+        }
+        long max_num_nodes_utilized = (long) (this->max_num_nodes - num_nodes);
+
+        // Try the first date at which the job fits and, if the job does not fit for its whole
+        // duration, start over after the last date in that window at which it does not fit
+        u_int32_t start_time = this->time_origin;
+        while (true) {
+            start_time = this->num_nodes_utilized.findFirstAtMost(start_time, max_num_nodes_utilized);
+            if ((start_time == UINT32_MAX) or (start_time >= latest_start)) {
+                return UINT32_MAX;
             }
-            u_int32_t interval_length = availability_timeslot.first.upper() - availability_timeslot.first.lower();
-
-            // Yes!
-            if (interval_length >= remaining_duration) {
-                if (start_time == UINT32_MAX) {
-                    start_time = availability_timeslot.first.lower();
-                }
-                break;
+            auto end_time = (u_int32_t) std::min<uint64_t>((uint64_t) start_time + duration, UINT32_MAX);
+            auto blocked_time = this->num_nodes_utilized.findLastAbove(start_time, end_time, max_num_nodes_utilized);
+            if (blocked_time == UINT32_MAX) {
+                return start_time;
             }
+            start_time = blocked_time + 1;
+        }
+    }
 
-            // Maybe!
-            remaining_duration -= interval_length;
-            if (start_time == UINT32_MAX) {
-                start_time = availability_timeslot.first.lower();
-            }
+    /**
+     * @brief Method to find the maximum number of available nodes between the time origin and a date
+     * @param date: a date
+     * @return a number of nodes (0 if the date is not after the time origin)
+     */
+    unsigned long NodeAvailabilityTimeLine::getMaxAvailableNodesBefore(u_int32_t date) {
+        if (date <= this->time_origin) {
+            return 0;
         }
-        return start_time;
+        long min_num_nodes_utilized = this->num_nodes_utilized.getMin(this->time_origin, date);
+        if (min_num_nodes_utilized >= (long) this->max_num_nodes) {
+            return 0;
+        }
+        return this->max_num_nodes - (unsigned long) std::max<long>(0, min_num_nodes_utilized);
     }
 
     /**
@@ -148,8 +221,11 @@ namespace wrench {
      */
     std::set<std::shared_ptr<BatchJob>> NodeAvailabilityTimeLine::getJobsInFirstSlot() {
         std::set<std::shared_ptr<BatchJob>> to_return;
-        for (auto const &j: (*(this->availability_timeslots.begin())).second.jobs) {
-            to_return.insert(j);
+        for (auto it = this->reservations_by_start.begin();
+             (it != this->reservations_by_start.end()) and (it->first <= this->time_origin); ++it) {
+            if (boost::icl::contains(this->reservations[it->second].intervals, this->time_origin)) {
+                to_return.insert(it->second);
+            }
         }
         return to_return;
     }
@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2017-2018. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include "wrench/services/compute/batch/batch_schedulers/homegrown/conservative_bf/NodeUtilizationTree.h"
+
+// The tree covers all dates in [0, 2^32), i.e., 32 levels
+#define DOMAIN_UPPER ((uint64_t) 1 << 32)
+#define NOT_FOUND UINT64_MAX
+
+namespace wrench {
+
+    /**
+     * @brief Constructor (all counts are zero)
+     */
+    NodeUtilizationTree::NodeUtilizationTree() {
+        this->clear();
+    }
+
+    /**
+     * @brief Method to reset all counts to zero
+     */
+    void NodeUtilizationTree::clear() {
+        this->tree_nodes.clear();
+        this->free_tree_nodes.clear();
+        this->newTreeNode();
+    }
+
+    /**
+     * @brief Method to add a count (which may be negative) to all dates in a range
+     * @param start: the start date
+     * @param end: the end date (excluded)
+     * @param num_nodes: the count
+     */
+    void NodeUtilizationTree::add(u_int32_t start, u_int32_t end, long num_nodes) {
+        if ((start >= end) or (num_nodes == 0)) {
+            return;
+        }
+        this->update(0, 0, DOMAIN_UPPER, start, end, num_nodes);
+    }
+
+    /**
+     * @brief Method to find the min count over a (non-empty) date range
+     * @param start: the start date
+     * @param end: the end date (excluded)
+     * @return a count
+     */
+    long NodeUtilizationTree::getMin(u_int32_t start, u_int32_t end) {
+        return this->getMin(0, 0, DOMAIN_UPPER, start, end, 0);
+    }
+
+    /**
+     * @brief Method to find the last date in a range at which the count is above a threshold
+     * @param start: the start date
+     * @param end: the end date (excluded)
+     * @param threshold: the threshold
+     * @return a date, or UINT32_MAX if there is none
+     */
+    u_int32_t NodeUtilizationTree::findLastAbove(u_int32_t start, u_int32_t end, long threshold) {
+        if (start >= end) {
+            return UINT32_MAX;
+        }
+        auto date = this->findLastAbove(0, 0, DOMAIN_UPPER, start, end, 0, threshold);
+        return (date == NOT_FOUND ? UINT32_MAX : (u_int32_t) date);
+    }
+
+    /**
+     * @brief Method to find the first date, before UINT32_MAX, at which the count is at most a threshold
+     * @param start: the date from which to look
+     * @param threshold: the threshold
+     * @return a date, or UINT32_MAX if there is none
+     */
+    u_int32_t NodeUtilizationTree::findFirstAtMost(u_int32_t start, long threshold) {
+        if (start >= UINT32_MAX) {
+            return UINT32_MAX;
+        }
+        auto date = this->findFirstAtMost(0, 0, DOMAIN_UPPER, start, UINT32_MAX, 0, threshold);
+        return (date == NOT_FOUND ? UINT32_MAX : (u_int32_t) date);
+    }
+
+    /**
+     * @brief Create a tree node whose counts are zero
+     * @return the tree node's index
+     */
+    int NodeUtilizationTree::newTreeNode() {
+        TreeNode tree_node = {0, 0, 0, {-1, -1}};
+        if (not this->free_tree_nodes.empty()) {
+            int index = this->free_tree_nodes.back();
+            this->free_tree_nodes.pop_back();
+            this->tree_nodes[index] = tree_node;
+            return index;
+        }
+        this->tree_nodes.push_back(tree_node);
+        return (int) this->tree_nodes.size() - 1;
+    }
+
+    /**
+     * @brief Add a count to all dates of a range within the subtree of a tree node
+     * @param index: the tree node's index
+     * @param lower: the first date covered by the tree node
+     * @param upper: the date after the last date covered by the tree node
+     * @param start: the start date of the range
+     * @param end: the end date of the range (excluded)
+     * @param num_nodes: the count
+     */
+    void NodeUtilizationTree::update(int index, uint64_t lower, uint64_t upper, uint64_t start, uint64_t end, long num_nodes) {
+        if ((start <= lower) and (upper <= end)) {
+            this->tree_nodes[index].added += num_nodes;
+            this->tree_nodes[index].min += num_nodes;
+            this->tree_nodes[index].max += num_nodes;
+            return;
+        }
+
+        uint64_t middle = lower + (upper - lower) / 2;
+        for (int c = 0; c < 2; c++) {
+            uint64_t child_lower = (c == 0 ? lower : middle);
+            uint64_t child_upper = (c == 0 ? middle : upper);
+            if ((end <= child_lower) or (child_upper <= start)) {
+                continue;
+            }
+            int child = this->tree_nodes[index].children[c];
+            if (child < 0) {
+                child = this->newTreeNode();
+                this->tree_nodes[index].children[c] = child;
+            }
+            this->update(child, child_lower, child_upper, start, end, num_nodes);
+            // A child whose counts are all back to zero is no longer needed
+            auto &child_node = this->tree_nodes[child];
+            if ((child_node.added == 0) and (child_node.children[0] < 0) and (child_node.children[1] < 0)) {
+                this->free_tree_nodes.push_back(child);
+                this->tree_nodes[index].children[c] = -1;
+            }
+        }
+
+        auto &tree_node = this->tree_nodes[index];
+        long min = LONG_MAX, max = LONG_MIN;
+        for (int child: tree_node.children) {
+            min = std::min<long>(min, (child < 0 ? 0 : this->tree_nodes[child].min));
+            max = std::max<long>(max, (child < 0 ? 0 : this->tree_nodes[child].max));
+        }
+        tree_node.min = tree_node.added + min;
+        tree_node.max = tree_node.added + max;
+    }
+
+    /**
+     * @brief Find the min count over a range within the subtree of a tree node
+     * @param index: the tree node's index, or -1 for a subtree whose counts are all zero
+     * @param lower: the first date covered by the tree node
+     * @param upper: the date after the last date covered by the tree node
+     * @param start: the start date of the range
+     * @param end: the end date of the range (excluded)
+     * @param offset: the count added by the ancestors of the tree node
+     * @return a count
+     */
+    long NodeUtilizationTree::getMin(int index, uint64_t lower, uint64_t upper, uint64_t start, uint64_t end, long offset) {
+        if (index < 0) {
+            return offset;
+        }
+        auto &tree_node = this->tree_nodes[index];
+        if ((start <= lower) and (upper <= end)) {
+            return offset + tree_node.min;
+        }
+
+        long min = LONG_MAX;
+        uint64_t middle = lower + (upper - lower) / 2;
+        if (start < middle) {
+            min = std::min<long>(min, this->getMin(tree_node.children[0], lower, middle, start, end, offset + tree_node.added));
+        }
+        if (end > middle) {
+            min = std::min<long>(min, this->getMin(tree_node.children[1], middle, upper, start, end, offset + tree_node.added));
+        }
+        return min;
+    }
+
+    /**
+     * @brief Find the first date of a range, within the subtree of a tree node, at which
+     *        the count is at most a threshold
+     * @param index: the tree node's index, or -1 for a subtree whose counts are all zero
+     * @param lower: the first date covered by the tree node
+     * @param upper: the date after the last date covered by the tree node
+     * @param start: the start date of the range
+     * @param end: the end date of the range (excluded)
+     * @param offset: the count added by the ancestors of the tree node
+     * @param threshold: the threshold
+     * @return a date, or NOT_FOUND
+     */
+    uint64_t NodeUtilizationTree::findFirstAtMost(int index, uint64_t lower, uint64_t upper, uint64_t start, uint64_t end, long offset,
+                                            long threshold) {
+        if (index < 0) {
+            return (offset <= threshold ? std::max<uint64_t>(lower, start) : NOT_FOUND);
+        }
+        auto &tree_node = this->tree_nodes[index];
+        if (offset + tree_node.min > threshold) {
+            return NOT_FOUND;
+        }
+        // All dates have the same count
+        if (tree_node.min == tree_node.max) {
+            return std::max<uint64_t>(lower, start);
+        }
+
+        int children[2] = {tree_node.children[0], tree_node.children[1]};
+        offset += tree_node.added;
+        uint64_t middle = lower + (upper - lower) / 2;
+        if (start < middle) {
+            auto date = this->findFirstAtMost(children[0], lower, middle, start, end, offset, threshold);
+            if (date != NOT_FOUND) {
+                return date;
+            }
+        }
+        if (end > middle) {
+            return this->findFirstAtMost(children[1], middle, upper, start, end, offset, threshold);
+        }
+        return NOT_FOUND;
+    }
+
+    /**
+     * @brief Find the last date of a range, within the subtree of a tree node, at which
+     *        the count is above a threshold
+     * @param index: the tree node's index, or -1 for a subtree whose counts are all zero
+     * @param lower: the first date covered by the tree node
+     * @param upper: the date after the last date covered by the tree node
+     * @param start: the start date of the range
+     * @param end: the end date of the range (excluded)
+     * @param offset: the count added by the ancestors of the tree node
+     * @param threshold: the threshold
+     * @return a date, or NOT_FOUND
+     */
+    uint64_t NodeUtilizationTree::findLastAbove(int index, uint64_t lower, uint64_t upper, uint64_t start, uint64_t end, long offset,
+                                                long threshold) {
+        if (index < 0) {
+            return (offset > threshold ? std::min<uint64_t>(upper, end) - 1 : NOT_FOUND);
+        }
+        auto &tree_node = this->tree_nodes[index];
+        if (offset + tree_node.max <= threshold) {
+            return NOT_FOUND;
+        }
+        // All dates have the same count
+        if (tree_node.min == tree_node.max) {
+            return std::min<uint64_t>(upper, end) - 1;
+        }
+
+        int children[2] = {tree_node.children[0], tree_node.children[1]};
+        offset += tree_node.added;
+        uint64_t middle = lower + (upper - lower) / 2;
+        if (end > middle) {
+            auto date = this->findLastAbove(children[1], middle, upper, start, end, offset, threshold);
+            if (date != NOT_FOUND) {
+                return date;
+            }
+        }
+        if (start < middle) {
+            return this->findLastAbove(children[0], lower, middle, start, end, offset, threshold);
+        }
+        return NOT_FOUND;
+    }
+
+}// namespace wrench
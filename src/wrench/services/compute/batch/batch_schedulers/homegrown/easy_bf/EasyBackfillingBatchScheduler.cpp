@@ -0,0 +1,302 @@
+/**
+ * Copyright (c) 2017-2021. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/logging/TerminalOutput.h>
+#include <wrench/simulation/Simulation.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "wrench/services/compute/batch/batch_schedulers/homegrown/easy_bf/EasyBackfillingBatchScheduler.h"
+#include "wrench/services/compute/batch/batch_schedulers/homegrown/conservative_bf/NodeAvailabilityTimeLine.h"
+
+WRENCH_LOG_CATEGORY(wrench_core_easy_bf_batch_scheduler, "Log category for EasyBackfillingBatchScheduler");
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param cs: The BatchComputeService for which this scheduler is working
+     */
+    EasyBackfillingBatchScheduler::EasyBackfillingBatchScheduler(BatchComputeService *cs) : HomegrownBatchScheduler(cs) {
+    }
+
+    /**
+     * @brief Method to process a job submission
+     * @param batch_job: the newly submitted BatchComputeService job
+     */
+    void EasyBackfillingBatchScheduler::processJobSubmission(std::shared_ptr<BatchJob> batch_job) {
+        WRENCH_INFO("Queuing a new BatchComputeService job, %lu, that needs %lu nodes",
+                    batch_job->getJobID(), batch_job->getRequestedNumNodes());
+        this->queue_needs_scan = true;
+    }
+
+    /**
+     * @brief Method to schedule (possibly) the next jobs to be scheduled
+     */
+    void EasyBackfillingBatchScheduler::processQueuedJobs() {
+        // Nothing can have changed since the last scan unless a job was submitted or has finished
+        if (this->cs->batch_queue.empty() or (not this->queue_needs_scan)) {
+            return;
+        }
+
+        // Start jobs in queue order for as long as they fit
+        while (not this->cs->batch_queue.empty()) {
+            auto head_job = this->cs->batch_queue.front();
+            if (head_job->getRequestedNumNodes() > this->cs->total_num_of_nodes - this->num_busy_nodes) {
+                break;
+            }
+            if (not this->startJob(head_job)) {
+                return;
+            }
+        }
+        if (this->cs->batch_queue.empty()) {
+            this->queue_needs_scan = false;
+            return;
+        }
+
+        // Compute the reservation of the job at the head of the queue: the shadow time is the
+        // earliest expected end date at which enough nodes are free, and the extra nodes are
+        // those that this job will not need at that date
+        auto now = Simulation::getCurrentSimulatedDate();
+        auto head_job = this->cs->batch_queue.front();
+        unsigned long num_free_nodes = this->cs->total_num_of_nodes - this->num_busy_nodes;
+        double shadow_time = now;
+        unsigned long num_extra_nodes = 0;
+        unsigned long num_nodes_at_shadow_time = num_free_nodes;
+        for (auto const &entry: this->running_jobs_by_expected_end_date) {
+            num_nodes_at_shadow_time += entry.second->getRequestedNumNodes();
+            if (num_nodes_at_shadow_time >= head_job->getRequestedNumNodes()) {
+                shadow_time = std::max<double>(now, entry.first);
+                num_extra_nodes = num_nodes_at_shadow_time - head_job->getRequestedNumNodes();
+                break;
+            }
+        }
+
+        WRENCH_INFO("BatchComputeService job %lu is reserved %lu nodes at time %lf (%lu extra nodes)",
+                    head_job->getJobID(), head_job->getRequestedNumNodes(), shadow_time, num_extra_nodes);
+
+        // Backfill the jobs that fit now and either end before the shadow time or only use extra nodes
+        std::vector<std::shared_ptr<BatchJob>> backfilled_jobs;
+        for (auto it = std::next(this->cs->batch_queue.begin());
+             (it != this->cs->batch_queue.end()) and (num_free_nodes > 0); ++it) {
+            auto const &batch_job = *it;
+            auto num_nodes = batch_job->getRequestedNumNodes();
+            if (num_nodes > num_free_nodes) {
+                continue;
+            }
+            bool ends_before_shadow_time = (now + (double) batch_job->getRequestedTime() <= shadow_time);
+            if ((not ends_before_shadow_time) and (num_nodes > num_extra_nodes)) {
+                continue;
+            }
+            num_free_nodes -= num_nodes;
+            if (not ends_before_shadow_time) {
+                num_extra_nodes -= num_nodes;
+            }
+            backfilled_jobs.push_back(batch_job);
+        }
+
+        for (auto const &batch_job: backfilled_jobs) {
+            WRENCH_INFO("Backfilling BatchComputeService job %lu", batch_job->getJobID());
+            if (not this->startJob(batch_job)) {
+                return;
+            }
+        }
+
+        this->queue_needs_scan = false;
+    }
+
+    /**
+     * @brief Start a queued job right now
+     * @param batch_job: the job
+     * @return true if the job was started, false if the resources are not available (yet)
+     */
+    bool EasyBackfillingBatchScheduler::startJob(const std::shared_ptr<BatchJob> &batch_job) {
+        // Get the workflow job associated to the picked BatchComputeService job
+        std::shared_ptr<CompoundJob> compound_job = batch_job->getCompoundJob();
+
+        // Find on which resources to actually run the job
+        unsigned long cores_per_node_asked_for = batch_job->getRequestedCoresPerNode();
+        unsigned long num_nodes_asked_for = batch_job->getRequestedNumNodes();
+        unsigned long requested_time = batch_job->getRequestedTime();
+
+        auto resources = this->scheduleOnHosts(num_nodes_asked_for, cores_per_node_asked_for, ComputeService::ALL_RAM);
+        if (resources.empty()) {
+            // Hmmm... we don't have the resources right now... we should get an update soon....
+            return false;
+        }
+
+        WRENCH_INFO("Starting BatchComputeService job %lu ", batch_job->getJobID());
+
+        // Keep track of it
+        auto expected_end_date = Simulation::getCurrentSimulatedDate() + (double) requested_time;
+        this->running_job_positions[batch_job] =
+                this->running_jobs_by_expected_end_date.insert(std::make_pair(expected_end_date, batch_job));
+        this->num_busy_nodes += num_nodes_asked_for;
+
+        // Remove the job from the BatchComputeService queue
+        this->cs->removeJobFromBatchQueue(batch_job);
+
+        // Add it to the running list
+        this->cs->running_jobs[batch_job->getCompoundJob()] = batch_job;
+
+        // Start it!
+        this->cs->startJob(resources, compound_job, batch_job, num_nodes_asked_for, requested_time,
+                           cores_per_node_asked_for);
+        return true;
+    }
+
+    /**
+     * @brief Stop keeping track of a job that is no longer running or pending
+     * @param batch_job: the job
+     */
+    void EasyBackfillingBatchScheduler::forgetJob(const std::shared_ptr<BatchJob> &batch_job) {
+        auto it = this->running_job_positions.find(batch_job);
+        if (it != this->running_job_positions.end()) {
+            this->running_jobs_by_expected_end_date.erase(it->second);
+            this->running_job_positions.erase(it);
+            this->num_busy_nodes -= batch_job->getRequestedNumNodes();
+        }
+        this->queue_needs_scan = true;
+    }
+
+    /**
+     * @brief Method to process a job completion
+     * @param batch_job: the job that completed
+     */
+    void EasyBackfillingBatchScheduler::processJobCompletion(std::shared_ptr<BatchJob> batch_job) {
+        WRENCH_INFO("Notified of completion of BatchComputeService job, %lu", batch_job->getJobID());
+        this->forgetJob(batch_job);
+    }
+
+    /**
+    * @brief Method to process a job termination
+    * @param batch_job: the job that was terminated
+    */
+    void EasyBackfillingBatchScheduler::processJobTermination(std::shared_ptr<BatchJob> batch_job) {
+        // Just like a job Completion to me!
+        this->processJobCompletion(batch_job);
+    }
+
+    /**
+    * @brief Method to process a job failure
+    * @param batch_job: the job that failed
+    */
+    void EasyBackfillingBatchScheduler::processJobFailure(std::shared_ptr<BatchJob> batch_job) {
+        // Just like a job Completion to me!
+        this->processJobCompletion(batch_job);
+    }
+
+    /**
+     * @brief Method to figure out on which actual resources a job could be scheduled right now
+     * @param num_nodes: number of nodes
+     * @param cores_per_node: number of cores per node
+     * @param ram_per_node: amount of RAM
+     * @return a host:<core,RAM> map
+     *
+     */
+    std::map<std::string, std::tuple<unsigned long, double>>
+    EasyBackfillingBatchScheduler::scheduleOnHosts(unsigned long num_nodes, unsigned long cores_per_node, double ram_per_node) {
+        if (ram_per_node == ComputeService::ALL_RAM) {
+            ram_per_node = Simulation::getHostMemoryCapacity(cs->available_nodes_to_cores.begin()->first);
+        }
+        if (cores_per_node == ComputeService::ALL_CORES) {
+            cores_per_node = Simulation::getHostNumCores(cs->available_nodes_to_cores.begin()->first);
+        }
+
+        if (ram_per_node > Simulation::getHostMemoryCapacity(cs->available_nodes_to_cores.begin()->first)) {
+            throw std::runtime_error("EasyBackfillingBatchScheduler::scheduleOnHosts(): Asking for too much RAM per host");
+        }
+        if (num_nodes > cs->available_nodes_to_cores.size()) {
+            throw std::runtime_error("EasyBackfillingBatchScheduler::scheduleOnHosts(): Asking for too many hosts");
+        }
+        if (cores_per_node > Simulation::getHostNumCores(cs->available_nodes_to_cores.begin()->first)) {
+            throw std::runtime_error("EasyBackfillingBatchScheduler::scheduleOnHosts(): Asking for too many cores per host (asking  for " +
+                                     std::to_string(cores_per_node) + " but hosts have " +
+                                     std::to_string(Simulation::getHostNumCores(cs->available_nodes_to_cores.begin()->first)) + "cores)");
+        }
+
+        // IMPORTANT: We always give all cores to a job on a node!
+        cores_per_node = Simulation::getHostNumCores(cs->available_nodes_to_cores.begin()->first);
+
+        std::map<std::string, std::tuple<unsigned long, double>> resources = {};
+        std::vector<std::string> hosts_assigned = {};
+
+        unsigned long host_count = 0;
+        for (auto &available_nodes_to_core: cs->available_nodes_to_cores) {
+            if (available_nodes_to_core.second >= cores_per_node) {
+                //Remove that many cores from the available_nodes_to_core
+                available_nodes_to_core.second -= cores_per_node;
+                hosts_assigned.push_back(available_nodes_to_core.first);
+                resources.insert(std::make_pair(available_nodes_to_core.first, std::make_tuple(cores_per_node, ram_per_node)));
+                if (++host_count >= num_nodes) {
+                    break;
+                }
+            }
+        }
+        if (resources.size() < num_nodes) {
+            resources = {};
+            // undo!
+            for (auto const &host: hosts_assigned) {
+                cs->available_nodes_to_cores[host] += cores_per_node;
+            }
+        }
+
+        return resources;
+    }
+
+    /**
+     * @brief Method to obtain start time estimates. Since EASY only makes a reservation for the job at
+     *        the head of the queue, estimates are computed on a conservative schedule in which
+     *        running jobs use their nodes until their expected end dates and queued jobs are placed as
+     *        early as possible in queue order (i.e., possible future backfilling is not accounted for)
+     * @param set_of_jobs: a set of job specs
+     * @return map of estimates
+     */
+    std::map<std::string, double> EasyBackfillingBatchScheduler::getStartTimeEstimates(
+            std::set<std::tuple<std::string, unsigned long, unsigned long, double>> set_of_jobs) {
+        std::map<std::string, double> to_return;
+
+        auto now = (u_int32_t) Simulation::getCurrentSimulatedDate();
+        NodeAvailabilityTimeLine schedule(this->cs->total_num_of_nodes);
+        schedule.setTimeOrigin(now);
+
+        for (auto const &entry: this->running_jobs_by_expected_end_date) {
+            auto expected_end_date = (u_int32_t) entry.first;
+            if (expected_end_date > now) {
+                schedule.add(now, expected_end_date, entry.second);
+            }
+        }
+        for (auto const &batch_job: this->cs->batch_queue) {
+            auto est = schedule.findEarliestStartTime(batch_job->getRequestedTime(), batch_job->getRequestedNumNodes());
+            if ((est < UINT32_MAX) and (batch_job->getRequestedTime() > 0)) {
+                schedule.add(est, est + batch_job->getRequestedTime(), batch_job);
+            }
+        }
+
+        for (auto const &j: set_of_jobs) {
+            const std::string &id = std::get<0>(j);
+            u_int64_t num_nodes = std::get<1>(j);
+            if (std::get<3>(j) > UINT32_MAX) {
+                throw std::runtime_error("EasyBackfillingBatchScheduler::getStartTimeEstimates(): job duration too large");
+            }
+            auto duration = (u_int32_t) (std::get<3>(j));
+
+            auto est = schedule.findEarliestStartTime(duration, num_nodes);
+            if (est < UINT32_MAX) {
+                to_return[id] = (double) est;
+            } else {
+                to_return[id] = -1.0;
+            }
+        }
+        return to_return;
+    }
+
+}// namespace wrench
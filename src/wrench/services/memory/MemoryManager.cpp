@@ -8,10 +8,15 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include <wrench/logging/TerminalOutput.h>
 #include <wrench/simgrid_S4U_util/S4U_Simulation.h>
 #include <wrench/failure_causes/HostError.h>
 #include <wrench/services/memory/MemoryManager.h>
+#include <wrench/services/memory/MemoryManagerMessage.h>
+#include <wrench/simgrid_S4U_util/S4U_Mailbox.h>
 
 WRENCH_LOG_CATEGORY(wrench_periodic_flush, "Log category for Periodic Flush");
 
@@ -36,6 +41,23 @@ namespace wrench {
         this->free = total;
         this->dirty = 0;
         this->cached = 0;
+        this->max_blocks_per_file = Simulation::getPageCacheMaxExtentsPerFile();
+        this->readahead_initial_window = Simulation::getPageCacheReadaheadInitialWindow();
+        this->readahead_max_window = Simulation::getPageCacheReadaheadMaxWindow();
+        this->log_max_num_samples = Simulation::getPageCacheLogMaxNumSamples();
+    }
+
+    /**
+     * @brief Destructor
+     */
+    MemoryManager::~MemoryManager() {
+        for (auto list: {&this->inactive_list, &this->active_list}) {
+            Block *next;
+            for (Block *blk = list->head; blk != nullptr; blk = next) {
+                next = blk->lru_next;
+                delete blk;
+            }
+        }
     }
 
     /**
@@ -61,14 +83,36 @@ namespace wrench {
         return memory_manager;
     }
 
+    /**
+     * @brief Main method of the daemon, which flushes expired dirty data periodically. The daemon
+     *        only wakes up at the periods at which some dirty data has expired (which are the
+     *        periods at which flushing actually does something), and waits for a message when
+     *        there is no dirty data at all, so that an idle page cache costs no simulation events.
+     * @return 0 on termination
+     */
     int MemoryManager::main() {
         TerminalOutput::setThisProcessLoggingColor(TerminalOutput::COLOR_MAGENTA);
         WRENCH_INFO(
                 "Periodic Flush starting with interval = %d , expired time = %d",
                 this->interval, this->expired_time);
 
+        // The date of the next period
+        double next_tick = S4U_Simulation::getClock();
+
         while (this->getState() == State::UP) {
-            double start_time = S4U_Simulation::getClock();
+            if (this->dirty_times.empty()) {
+                // Wait until some dirty data is added to the cache
+                this->flusher_idle = true;
+                S4U_Mailbox::getMessage(this->mailbox);
+                this->flusher_idle = false;
+                continue;
+            }
+
+            double start_time = this->getNextFlushDate(next_tick);
+            if (start_time > S4U_Simulation::getClock()) {
+                S4U_Simulation::sleep(start_time - S4U_Simulation::getClock());
+            }
+            start_time = S4U_Simulation::getClock();
             double amt = pdflush();
             double end_time = S4U_Simulation::getClock();
             if (amt > 0) {
@@ -77,7 +121,9 @@ namespace wrench {
             }
 
             if (end_time - start_time < interval) {
-                S4U_Simulation::sleep(interval + start_time - end_time);
+                next_tick = start_time + interval;
+            } else {
+                next_tick = end_time;
             }
         }
 
@@ -85,6 +131,33 @@ namespace wrench {
         return 0;
     }
 
+    /**
+     * @brief Compute the date of the first period at which some dirty data will have expired
+     * @param next_tick: the date of the next period
+     * @return a date
+     */
+    double MemoryManager::getNextFlushDate(double next_tick) {
+        double now = S4U_Simulation::getClock();
+        double earliest_dirty_time = this->dirty_times.begin()->first;
+
+        if (interval <= 0) {
+            return std::max<double>(now, earliest_dirty_time + expired_time);
+        }
+
+        double date = next_tick;
+        if (date < now) {
+            date += std::ceil((now - date) / interval) * interval;
+        }
+        if (date - earliest_dirty_time < expired_time) {
+            date += std::ceil((earliest_dirty_time + expired_time - date) / interval) * interval;
+            // Guard against rounding errors
+            if (date - earliest_dirty_time < expired_time) {
+                date += interval;
+            }
+        }
+        return date;
+    }
+
     /**
      * @brief Immediately terminate periodical flushing
      */
@@ -171,11 +244,7 @@ namespace wrench {
      * @return a number of bytes
      */
     double MemoryManager::getEvictableMemory() {
-        double sum = 0;
-        for (unsigned int i = 0; i < inactive_list.size(); i++) {
-            sum += inactive_list[i]->getSize();
-        }
-        return sum;
+        return this->inactive_list.cached;
     }
 
     /**
@@ -201,23 +270,25 @@ namespace wrench {
      * @param excluded_filename: filename excluded from the flush
      * @return flushed amount
      */
-    double MemoryManager::flushLruList(std::vector<Block *> &list,
+    double MemoryManager::flushLruList(LruList &list,
                                        double amount,
                                        const std::string &excluded_filename) {
-        if (amount <= 0) return 0;
+        if (amount <= 0 or list.dirty <= 0) return 0;
         double flushed = 0;
 
         std::map<std::string, double> flushing_map;
 
-        for (const auto &blk: list) {
-            if (!excluded_filename.empty() && blk->getFileId().compare(excluded_filename) == 0) {
+        CachedFile *excluded = this->getCachedFile(excluded_filename, false);
+
+        for (Block *blk = list.head; blk != nullptr; blk = blk->lru_next) {
+            if (excluded && blk->cached_file == excluded) {
                 continue;
             }
 
             if (blk->isDirty()) {
                 if (flushed + blk->getSize() <= amount) {
                     // flush whole block
-                    blk->setDirty(false);
+                    setBlockDirty(blk, false);
                     flushed += blk->getSize();
                     flushing_map[blk->getLocation()->getMountPoint()] += blk->getSize();
                 } else if (flushed < amount && amount < flushed + blk->getSize()) {
@@ -226,10 +297,10 @@ namespace wrench {
 
                     flushed = amount;
                     // split
-                    blk->setSize(blk->getSize() - blk_flushed);
+                    resizeBlock(blk, blk->getSize() - blk_flushed);
 
                     std::string fn = blk->getFileId();
-                    inactive_list.push_back(new Block(fn, blk->getLocation(), blk_flushed, blk->getLastAccess(),
+                    pushBack(inactive_list, new Block(fn, blk->getLocation(), blk_flushed, blk->getLastAccess(),
                                                       false, blk->getDirtyTime()));
                 } else {
                     // done flushing
@@ -287,29 +358,33 @@ namespace wrench {
      * @param list: the LRU to be flushed
      * @return flushed amount
      */
-    double MemoryManager::flushExpiredData(std::vector<Block *> &list) {
+    double MemoryManager::flushExpiredData(LruList &list) {
         double flushed = 0;
 
         while (true) {
             this->acquireDaemonLock();
             Block *block_to_deal_with = nullptr;
-            for (auto blk: list) {
-                if (!blk->isDirty()) continue;
-                if (S4U_Simulation::getClock() - blk->getDirtyTime() < expired_time) continue;
-                block_to_deal_with = blk;
-                break;
+            if (list.dirty > 0) {
+                for (Block *blk = list.head; blk != nullptr; blk = blk->lru_next) {
+                    if (!blk->isDirty()) continue;
+                    if (S4U_Simulation::getClock() - blk->getDirtyTime() < expired_time) continue;
+                    block_to_deal_with = blk;
+                    break;
+                }
             }
             this->releaseDaemonLock();
             if (block_to_deal_with == nullptr) break;
 
-            block_to_deal_with->setDirty(false);
-            flushed += block_to_deal_with->getSize();
+            setBlockDirty(block_to_deal_with, false);
+            // (the block, which is now clean, may be evicted while it is written)
+            double size = block_to_deal_with->getSize();
+            flushed += size;
 
             simgrid::s4u::Disk *disk = getDisk(block_to_deal_with->getLocation()->getMountPoint(), this->hostname);
-            disk->write(block_to_deal_with->getSize());
+            disk->write(size);
 
-            this->dirty -= block_to_deal_with->getSize();
-            flushed += block_to_deal_with->getSize();
+            this->dirty -= size;
+            flushed += size;
         }
 
         return flushed;
@@ -322,6 +397,10 @@ namespace wrench {
      */
     double MemoryManager::pdflush() {
         double flushed = 0;
+        if (this->dirty_times.empty() or
+            (S4U_Simulation::getClock() - this->dirty_times.begin()->first < expired_time)) {
+            return flushed;
+        }
         flushed += flushExpiredData(inactive_list);
         flushed += flushExpiredData(active_list);
         return flushed;
@@ -352,27 +431,32 @@ namespace wrench {
      * @param excluded_filename: name of file that cannot be evicted
      * @return evicted amount
      */
-    double MemoryManager::evictLruList(std::vector<Block *> &lru_list,
+    double MemoryManager::evictLruList(LruList &lru_list,
                                        double amount,
                                        std::string excluded_filename) {
         if (amount <= 0) return 0;
 
         double evicted = 0;
 
-        for (unsigned int i = 0; i < lru_list.size(); i++) {
-            Block *blk = lru_list.at(i);
+        CachedFile *excluded = this->getCachedFile(excluded_filename, false);
+
+        Block *next;
+        for (Block *blk = lru_list.head; blk != nullptr; blk = next) {
+            next = blk->lru_next;
 
-            if (!excluded_filename.empty() && blk->getFileId().compare(excluded_filename) == 0) {
+            if (excluded && blk->cached_file == excluded) {
                 continue;
             }
 
             if (blk->isDirty()) continue;
             if (evicted + blk->getSize() <= amount) {
                 evicted += blk->getSize();
-                lru_list.erase(lru_list.begin() + i);
-                i--;
+                auto cached_file = blk->cached_file;
+                remove(lru_list, blk);
+                delete blk;
+                releaseCachedFile(cached_file);
             } else if (evicted < amount && evicted + blk->getSize() > amount) {
-                blk->setSize(blk->getSize() - amount + evicted);
+                resizeBlock(blk, blk->getSize() - amount + evicted);
                 // done eviction
                 evicted = amount;
                 break;
@@ -404,7 +488,7 @@ namespace wrench {
         free -= amount;
         cached += amount;
         // Push cached data to inactive list
-        inactive_list.push_back(new Block(filename, location, amount, S4U_Simulation::getClock(), false, 0));
+        pushBack(inactive_list, new Block(filename, location, amount, S4U_Simulation::getClock(), false, 0));
         balanceLruLists();
 
         simgrid::s4u::Disk *disk = getDisk(location->getMountPoint(), this->hostname);
@@ -428,75 +512,73 @@ namespace wrench {
         double clean_reaccessed = 0;
         double read = 0;
 
-        for (unsigned int i = 0; i < inactive_list.size(); i++) {
-            if (read >= amount) {
-                break;
+        CachedFile *cached_file = this->getCachedFile(filename, false);
+        if (cached_file == nullptr) {
+            return;
+        }
+
+        // The file's blocks in the inactive list
+        Block *next;
+        for (Block *blk = cached_file->inactive_head; blk != nullptr and read < amount; blk = next) {
+            next = blk->file_next;
+            if (location == nullptr) {
+                location = blk->getLocation();
             }
 
-            Block *blk = inactive_list.at(i);
-            if (blk->getFileId().compare(filename) == 0) {
-                if (location == nullptr) {
-                    location = blk->getLocation();
+            if (read + blk->getSize() <= amount) {
+                read += blk->getSize();
+                // remove the existing old block from inactive list
+                remove(inactive_list, blk);
+                if (blk->isDirty()) {
+                    dirty_reaccessed += blk->getSize();
+                    pushBack(active_list, blk);
+                } else {
+                    clean_reaccessed += blk->getSize();
+                    delete blk;
                 }
-
-                if (read + blk->getSize() <= amount) {
-                    read += blk->getSize();
-                    if (blk->isDirty()) {
-                        dirty_reaccessed += blk->getSize();
-                        this->active_list.push_back(blk);
-                    } else {
-                        clean_reaccessed += blk->getSize();
-                    }
-                    // remove the existing old block from inactive list
-                    inactive_list.erase(inactive_list.begin() + i);
-                    i--;
+            } else {
+                double blk_read_amt = amount - read;
+                read += blk_read_amt;
+                Block *read_blk = splitBlock(blk, blk->getSize() - blk_read_amt);
+                if (blk->isDirty()) {
+                    dirty_reaccessed += blk_read_amt;
+                    pushBack(active_list, read_blk);
                 } else {
-                    double blk_read_amt = amount - read;
-                    read += blk_read_amt;
-                    Block *read_blk = blk->split(blk->getSize() - blk_read_amt);
-                    if (blk->isDirty()) {
-                        dirty_reaccessed += blk_read_amt;
-                        this->active_list.push_back(read_blk);
-                    } else {
-                        clean_reaccessed += blk_read_amt;
-                    }
+                    clean_reaccessed += blk_read_amt;
+                    delete read_blk;
                 }
             }
         }
 
-        for (unsigned int i = 0; i < active_list.size(); i++) {
-            if (read >= amount) {
-                break;
+        // The file's blocks in the active list
+        for (Block *blk = cached_file->active_head; blk != nullptr and read < amount; blk = next) {
+            next = blk->file_next;
+            if (location == nullptr) {
+                location = blk->getLocation();
             }
 
-            Block *blk = active_list.at(i);
-            if (blk->getFileId().compare(filename) == 0) {
-                if (location == nullptr) {
-                    location = blk->getLocation();
+            if (read + blk->getSize() <= amount) {
+                read += blk->getSize();
+                remove(active_list, blk);
+                if (blk->isDirty()) {
+                    // move the block to the end of the list
+                    dirty_reaccessed += blk->getSize();
+                    pushBack(active_list, blk);
+                } else {
+                    // delete to create a new clean block
+                    clean_reaccessed += blk->getSize();
+                    delete blk;
                 }
-
-                if (read + blk->getSize() <= amount) {
-                    read += blk->getSize();
-                    if (blk->isDirty()) {
-                        // move the block to the end of the list
-                        dirty_reaccessed += blk->getSize();
-                        std::rotate(active_list.begin() + i, active_list.begin() + i + 1, active_list.end());
-                    } else {
-                        // delete to create a new clean block
-                        clean_reaccessed += blk->getSize();
-                        active_list.erase(active_list.begin() + i);
-                    }
-                    i--;
+            } else {
+                double blk_read_amt = amount - read;
+                read += blk_read_amt;
+                Block *read_blk = splitBlock(blk, blk->getSize() - blk_read_amt);
+                if (blk->isDirty()) {
+                    dirty_reaccessed += blk_read_amt;
+                    pushBack(active_list, read_blk);
                 } else {
-                    double blk_read_amt = amount - read;
-                    read += blk_read_amt;
-                    Block *read_blk = blk->split(blk->getSize() - blk_read_amt);
-                    if (blk->isDirty()) {
-                        dirty_reaccessed += blk_read_amt;
-                        this->active_list.push_back(read_blk);
-                    } else {
-                        clean_reaccessed += blk_read_amt;
-                    }
+                    clean_reaccessed += blk_read_amt;
+                    delete read_blk;
                 }
             }
         }
@@ -504,18 +586,101 @@ namespace wrench {
         // create new blocks and put in the active list
         if (clean_reaccessed > 0) {
             Block *new_blk = new Block(filename, location, clean_reaccessed, S4U_Simulation::getClock(), false, 0);
-            active_list.push_back(new_blk);
+            pushBack(active_list, new_blk);
         }
-        //        if (dirty_reaccessed > 0) {
-        //            Block *new_blk = new Block(filename, mnt_pt, dirty_reaccessed, S4U_Simulation::getClock(), true);
-        //            active_list.push_back(new_blk);
-        //        }
 
         balanceLruLists();
 
         memory->read(clean_reaccessed + dirty_reaccessed);
     }
 
+    /**
+     * @brief Detect whether a read of a file is sequential, update the file's readahead window (which
+     *        grows on sequential reads and is reset on other reads), and determine how much of the
+     *        read is served by data that was read ahead (waiting for the readahead disk read to complete
+     *        if need be)
+     * @param filename: name of the file read
+     * @param offset: the offset of the read in the file (or -1 if unknown, in which case the read is not sequential)
+     * @param amount: number of bytes
+     * @return the number of bytes that were read ahead
+     */
+    double MemoryManager::readFromReadahead(const std::string &filename, double offset, double amount) {
+        if (this->readahead_max_window <= 0) {
+            return 0;
+        }
+
+        CachedFile *cached_file = this->getCachedFile(filename, true);
+        if (offset == 0) {
+            // A new sequential read of the file
+            cached_file->readahead_window = this->readahead_initial_window;
+            cached_file->readahead = 0;
+        } else if ((offset > 0) and (offset == cached_file->readahead_next_offset)) {
+            if (cached_file->readahead_window > 0) {
+                cached_file->readahead_window = std::min<double>(2 * cached_file->readahead_window, this->readahead_max_window);
+            } else {
+                cached_file->readahead_window = this->readahead_initial_window;
+            }
+        } else {
+            // Random access: stop reading ahead
+            cached_file->readahead_window = 0;
+            cached_file->readahead = 0;
+        }
+        cached_file->readahead_next_offset = (offset < 0 ? -1 : offset + amount);
+
+        // (read-ahead data may have been evicted)
+        double from_readahead = std::min<double>(std::min<double>(amount, cached_file->readahead), cached_file->cached);
+        cached_file->readahead -= from_readahead;
+        if (cached_file->readahead_io) {
+            if ((from_readahead > 0) and (not cached_file->readahead_io->test())) {
+                cached_file->readahead_io->wait();
+                cached_file->readahead_io = nullptr;
+            } else if (cached_file->readahead_io->test()) {
+                cached_file->readahead_io = nullptr;
+            }
+        }
+        return from_readahead;
+    }
+
+    /**
+     * @brief Start an asynchronous disk read of the data that follows the last read of a file,
+     *        so that the amount of data read ahead fills the file's readahead window. Data is read
+     *        into free or evictable memory only, and one readahead disk read at most is pending per file.
+     * @param filename: name of the file
+     * @param location: file location
+     * @param file_size: the file size
+     */
+    void MemoryManager::readAhead(const std::string &filename, const std::shared_ptr<FileLocation> &location, double file_size) {
+        if (this->readahead_max_window <= 0) {
+            return;
+        }
+
+        CachedFile *cached_file = this->getCachedFile(filename, false);
+        if ((cached_file == nullptr) or (cached_file->readahead_window <= 0)) {
+            return;
+        }
+        if (cached_file->readahead_io and (not cached_file->readahead_io->test())) {
+            return;
+        }
+        cached_file->readahead_io = nullptr;
+
+        double amount = std::min<double>(cached_file->readahead_window - cached_file->readahead,
+                                         file_size - cached_file->readahead_next_offset - cached_file->readahead);
+        amount = std::min<double>(amount, file_size - cached_file->cached);
+        if (amount <= 0) {
+            return;
+        }
+
+        this->evict(amount - this->free, filename);
+        amount = std::min<double>(amount, this->free);
+        if (amount <= 0) {
+            return;
+        }
+
+        WRENCH_DEBUG("Reading ahead %lf bytes of file %s", amount, filename.c_str());
+        cached_file->readahead_io = this->readToCache(filename, location, amount, true);
+        cached_file->readahead += amount;
+    }
+
     /**
      * @brief Simulate a file write to cache
      * @param filename: name of the file written
@@ -545,7 +710,7 @@ namespace wrench {
                                    bool is_dirty) {
         auto *bl = new Block(filename, location, amount, S4U_Simulation::getClock(), is_dirty,
                              S4U_Simulation::getClock());
-        inactive_list.push_back(bl);
+        pushBack(inactive_list, bl);
 
         this->cached += amount;
         this->free -= amount;
@@ -570,15 +735,8 @@ namespace wrench {
      * move blocks from the active list to the inactive list to make their sizes equal.
      */
     void MemoryManager::balanceLruLists() {
-        double inactive_size = 0;
-        for (unsigned int i = 0; i < inactive_list.size(); i++) {
-            inactive_size += inactive_list[i]->getSize();
-        }
-
-        double active_size = 0;
-        for (unsigned int i = 0; i < active_list.size(); i++) {
-            active_size += active_list[i]->getSize();
-        }
+        double inactive_size = inactive_list.cached;
+        double active_size = active_list.cached;
 
         // Active list should not be large then twice the size of the inactive list
         // Balance the lists: make their sizes equal
@@ -586,22 +744,22 @@ namespace wrench {
             double to_move_amt = (active_size - inactive_size) / 2;
             double moved_amt = 0;
 
-            for (unsigned int i = 0; i < active_list.size(); i++) {
-                Block *blk = active_list.at(i);
+            Block *next;
+            for (Block *blk = active_list.head; blk != nullptr; blk = next) {
+                next = blk->lru_next;
 
                 // move the whole block
                 if (to_move_amt - (moved_amt + blk->getSize()) >= 0) {
-                    inactive_list.push_back(blk);
-                    active_list.erase(active_list.begin() + i);
-                    i--;
+                    moved_amt += blk->getSize();
+                    remove(active_list, blk);
+                    pushBack(inactive_list, blk);
                 } else {
                     // split the block
                     std::string fn = blk->getFileId();
                     Block *new_blk = new Block(fn, blk->getLocation(), to_move_amt - moved_amt, blk->getLastAccess(),
                                                blk->isDirty(), blk->getDirtyTime());
-                    inactive_list.push_back(new_blk);
-
-                    blk->setSize(blk->getSize() + moved_amt - to_move_amt);
+                    resizeBlock(blk, blk->getSize() + moved_amt - to_move_amt);
+                    pushBack(inactive_list, new_blk);
 
                     // finish moving
                     break;
@@ -616,45 +774,312 @@ namespace wrench {
      * @return the amount of cached data
      */
     double MemoryManager::getCachedAmount(std::string filename) {
-        double amt = 0;
+        CachedFile *cached_file = this->getCachedFile(filename, false);
+        return (cached_file ? cached_file->cached : 0);
+    }
 
-        for (unsigned int i = 0; i < inactive_list.size(); i++) {
-            if (inactive_list[i]->getFileId().compare(filename) == 0) {
-                amt += inactive_list[i]->getSize();
-            }
+    /**
+     * @brief Get list of cached blocks of a file
+     * @param filename : name of the file
+     * @return a vector of cached blocks of the file (which are owned by the memory manager and
+     *         only valid until the next cache operation), sorted by last access
+     */
+    std::vector<Block *> MemoryManager::getCachedBlocks(std::string filename) {
+        std::vector<Block *> block_list;
+
+        CachedFile *cached_file = this->getCachedFile(filename, false);
+        if (cached_file == nullptr) {
+            return block_list;
+        }
+        for (Block *blk = cached_file->inactive_head; blk != nullptr; blk = blk->file_next) {
+            block_list.push_back(blk);
+        }
+        for (Block *blk = cached_file->active_head; blk != nullptr; blk = blk->file_next) {
+            block_list.push_back(blk);
         }
 
-        for (unsigned int i = 0; i < active_list.size(); i++) {
-            if (active_list[i]->getFileId().compare(filename) == 0) {
-                amt += active_list[i]->getSize();
-            }
+        std::stable_sort(block_list.begin(), block_list.end(), compare_last_access);
+
+        return block_list;
+    }
+
+    /**
+     * @brief Get the record of a file in the per-file block index
+     * @param filename: name of the file
+     * @param create: whether to create the record if it does not exist
+     * @return the record, or nullptr if it does not exist (and create is false)
+     */
+    CachedFile *MemoryManager::getCachedFile(const std::string &filename, bool create) {
+        if (filename.empty()) {
+            return nullptr;
+        }
+        auto it = this->cached_files.find(filename);
+        if (it != this->cached_files.end()) {
+            return it->second.get();
+        }
+        if (not create) {
+            return nullptr;
         }
+        auto cached_file = new CachedFile();
+        cached_file->file_id = filename;
+        this->cached_files[filename] = std::unique_ptr<CachedFile>(cached_file);
+        return cached_file;
+    }
 
-        return amt;
+    /**
+     * @brief Remove the record of a file from the per-file block index if the file no longer has
+     *        blocks, unless its readahead state is still needed (the file is being read sequentially,
+     *        or a readahead disk read is pending)
+     * @param cached_file: the record (which must not be used after this call)
+     */
+    void MemoryManager::releaseCachedFile(CachedFile *cached_file) {
+        if ((cached_file == nullptr) or (cached_file->num_blocks > 0) or (cached_file->readahead_window > 0)) {
+            return;
+        }
+        if (cached_file->readahead_io and (not cached_file->readahead_io->test())) {
+            return;
+        }
+        this->cached_files.erase(cached_file->file_id);
     }
 
     /**
-     * @brief Get list of cached blocks of a file
-     * @param filename : name of the file
-     * @return a vector of cached blocks of the file
+     * @brief Add a block at the end of a LRU list. The block is coalesced with the last block of
+     *        the list if they form a single extent (same file and disk, same dirty state and, for
+     *        dirty blocks, same dirty time), or with another of its file's blocks in the list if the
+     *        file has reached the maximum number of blocks per file.
+     * @param list: the inactive or active list
+     * @param blk: the block (which must not be in a list, and which is deleted if it is coalesced)
      */
-    std::vector<Block *> MemoryManager::getCachedBlocks(std::string filename) {
-        std::vector<Block *> block_list;
+    void MemoryManager::pushBack(LruList &list, Block *blk) {
+        Block *target = this->findCoalescingTarget(list, blk);
+        if (target == nullptr) {
+            this->append(list, blk);
+            return;
+        }
 
-        for (unsigned int i = 0; i < inactive_list.size(); i++) {
-            if (inactive_list[i]->getFileId().compare(filename) == 0) {
-                block_list.push_back(new Block(inactive_list[i]));
+        if (target != list.tail) {
+            // The extent now holds recently used data
+            this->remove(list, target);
+            this->append(list, target);
+        }
+        if (blk->isDirty() and (blk->getDirtyTime() < target->getDirtyTime())) {
+            // (the extent is flushed when its oldest data expires)
+            trackDirtyBlock(target, false);
+            target->setDirtyTime(blk->getDirtyTime());
+            trackDirtyBlock(target, true);
+        }
+        target->setLastAccess(std::max<double>(target->getLastAccess(), blk->getLastAccess()));
+        resizeBlock(target, target->getSize() + blk->getSize());
+        delete blk;
+    }
+
+    /**
+     * @brief Find the block of a LRU list with which a new block should be coalesced
+     * @param list: the inactive or active list
+     * @param blk: the new block
+     * @return a block, or nullptr if the new block should not be coalesced
+     */
+    Block *MemoryManager::findCoalescingTarget(LruList &list, Block *blk) {
+        CachedFile *cached_file = this->getCachedFile(blk->getFileId(), false);
+        if ((cached_file == nullptr) or (cached_file->num_blocks == 0)) {
+            return nullptr;
+        }
+
+        // Adjacent blocks that form a single extent
+        Block *tail = list.tail;
+        if ((tail != nullptr) and
+            (tail->cached_file == cached_file) and
+            (tail->isDirty() == blk->isDirty()) and
+            ((not blk->isDirty()) or (tail->getDirtyTime() == blk->getDirtyTime())) and
+            (tail->getLocation()->getMountPoint() == blk->getLocation()->getMountPoint())) {
+            return tail;
+        }
+
+        // Too many blocks: coalesce with the file's most recent compatible block in the list
+        if ((this->max_blocks_per_file > 0) and (cached_file->num_blocks >= this->max_blocks_per_file)) {
+            Block *file_tail = (&list == &this->active_list ? cached_file->active_tail : cached_file->inactive_tail);
+            for (Block *b = file_tail; b != nullptr; b = b->file_prev) {
+                if ((b->isDirty() == blk->isDirty()) and
+                    (b->getLocation()->getMountPoint() == blk->getLocation()->getMountPoint())) {
+                    return b;
+                }
             }
         }
-        for (unsigned int i = 0; i < active_list.size(); i++) {
-            if (active_list[i]->getFileId().compare(filename) == 0) {
-                block_list.push_back(new Block(active_list[i]));
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Append a block to a LRU list
+     * @param list: the inactive or active list
+     * @param blk: the block (which must not be in a list)
+     */
+    void MemoryManager::append(LruList &list, Block *blk) {
+        blk->lru_prev = list.tail;
+        blk->lru_next = nullptr;
+        if (list.tail) {
+            list.tail->lru_next = blk;
+        } else {
+            list.head = blk;
+        }
+        list.tail = blk;
+        list.cached += blk->getSize();
+        if (blk->isDirty()) {
+            list.dirty += blk->getSize();
+            trackDirtyBlock(blk, true);
+        }
+        linkBlock(blk, &list == &this->active_list);
+    }
+
+    /**
+     * @brief Remove a block from a LRU list
+     * @param list: the inactive or active list
+     * @param blk: the block
+     */
+    void MemoryManager::remove(LruList &list, Block *blk) {
+        unlinkBlock(blk);
+        if (blk->lru_prev) {
+            blk->lru_prev->lru_next = blk->lru_next;
+        } else {
+            list.head = blk->lru_next;
+        }
+        if (blk->lru_next) {
+            blk->lru_next->lru_prev = blk->lru_prev;
+        } else {
+            list.tail = blk->lru_prev;
+        }
+        blk->lru_prev = blk->lru_next = nullptr;
+        list.cached -= blk->getSize();
+        if (blk->isDirty()) {
+            list.dirty -= blk->getSize();
+            trackDirtyBlock(blk, false);
+        }
+    }
+
+    /**
+     * @brief Get the LRU list that a block is in
+     * @param blk: the block
+     * @return the inactive or active list
+     */
+    LruList &MemoryManager::getList(Block *blk) {
+        return (blk->active ? this->active_list : this->inactive_list);
+    }
+
+    /**
+     * @brief Mark a block (that is in a list) as dirty or clean
+     * @param blk: the block
+     * @param is_dirty: true or false
+     */
+    void MemoryManager::setBlockDirty(Block *blk, bool is_dirty) {
+        if (blk->isDirty() != is_dirty) {
+            getList(blk).dirty += (is_dirty ? 1 : -1) * blk->getSize();
+            trackDirtyBlock(blk, is_dirty);
+        }
+        blk->setDirty(is_dirty);
+    }
+
+    /**
+     * @brief Account for a block (that is in a list) becoming dirty or clean, and wake up
+     *        periodical flushing if it was waiting for dirty data
+     * @param blk: the block
+     * @param is_dirty: true if the block becomes dirty, false if it becomes clean
+     */
+    void MemoryManager::trackDirtyBlock(Block *blk, bool is_dirty) {
+        if (is_dirty) {
+            this->dirty_times[blk->getDirtyTime()]++;
+            if (this->flusher_idle) {
+                this->flusher_idle = false;
+                S4U_Mailbox::dputMessage(this->mailbox, new MemoryManagerWakeUpMessage(0));
+            }
+        } else {
+            auto it = this->dirty_times.find(blk->getDirtyTime());
+            if (it != this->dirty_times.end() and (--(it->second) == 0)) {
+                this->dirty_times.erase(it);
             }
         }
+    }
 
-        std::sort(block_list.begin(), block_list.end(), compare_last_access);
+    /**
+     * @brief Add a block at the end of its file's blocks in the inactive or active list
+     * @param blk: the block
+     * @param active: whether the block is in the active list
+     */
+    void MemoryManager::linkBlock(Block *blk, bool active) {
+        if (blk->cached_file == nullptr) {
+            blk->cached_file = this->getCachedFile(blk->getFileId(), true);
+        }
+        auto cached_file = blk->cached_file;
+        Block *&head = (active ? cached_file->active_head : cached_file->inactive_head);
+        Block *&tail = (active ? cached_file->active_tail : cached_file->inactive_tail);
+
+        blk->active = active;
+        blk->file_prev = tail;
+        blk->file_next = nullptr;
+        if (tail) {
+            tail->file_next = blk;
+        } else {
+            head = blk;
+        }
+        tail = blk;
+        cached_file->cached += blk->getSize();
+        cached_file->num_blocks++;
+    }
 
-        return block_list;
+    /**
+     * @brief Remove a block from its file's blocks
+     * @param blk: the block
+     */
+    void MemoryManager::unlinkBlock(Block *blk) {
+        auto cached_file = blk->cached_file;
+        Block *&head = (blk->active ? cached_file->active_head : cached_file->inactive_head);
+        Block *&tail = (blk->active ? cached_file->active_tail : cached_file->inactive_tail);
+
+        if (blk->file_prev) {
+            blk->file_prev->file_next = blk->file_next;
+        } else {
+            head = blk->file_next;
+        }
+        if (blk->file_next) {
+            blk->file_next->file_prev = blk->file_prev;
+        } else {
+            tail = blk->file_prev;
+        }
+        blk->file_prev = blk->file_next = nullptr;
+        cached_file->cached -= blk->getSize();
+        cached_file->num_blocks--;
+    }
+
+    /**
+     * @brief Change the size of a block (that is in a list)
+     * @param blk: the block
+     * @param size: the new size
+     */
+    void MemoryManager::resizeBlock(Block *blk, double size) {
+        double delta = size - blk->getSize();
+        auto &list = getList(blk);
+        list.cached += delta;
+        if (blk->isDirty()) {
+            list.dirty += delta;
+        }
+        blk->cached_file->cached += delta;
+        blk->setSize(size);
+    }
+
+    /**
+     * @brief Split a block (that is in a list)
+     * @param blk: the block
+     * @param remaining: the number of bytes that remain in the block
+     * @return a new block (that is not in a list) with the other bytes
+     */
+    Block *MemoryManager::splitBlock(Block *blk, double remaining) {
+        Block *new_blk = blk->split(remaining);
+        auto &list = getList(blk);
+        list.cached -= new_blk->getSize();
+        if (blk->isDirty()) {
+            list.dirty -= new_blk->getSize();
+        }
+        blk->cached_file->cached -= new_blk->getSize();
+        return new_blk;
     }
 
     /**
@@ -688,29 +1113,83 @@ namespace wrench {
      * @brief Append to the log
      */
     void MemoryManager::log() {
-        this->time_log.push_back(this->simulation->getCurrentSimulatedDate());
-        this->dirty_log.push_back(this->dirty);
-        this->cached_log.push_back(this->cached);
-        this->free_log.push_back(this->free);
+        LogSample sample = {this->simulation->getCurrentSimulatedDate(), this->dirty, this->cached, this->free};
+
+        if ((not this->log_samples.empty()) and (this->log_num_calls_in_last_sample < this->log_num_calls_per_sample)) {
+            mergeLogSamples(this->log_samples.back(), sample);
+            this->log_num_calls_in_last_sample++;
+            return;
+        }
+
+        if (this->log_samples.size() >= this->log_max_num_samples) {
+            // Merge adjacent samples pairwise
+            unsigned long num_samples = this->log_samples.size();
+            for (unsigned long i = 0; i < num_samples / 2; i++) {
+                this->log_samples[i] = this->log_samples[2 * i];
+                mergeLogSamples(this->log_samples[i], this->log_samples[2 * i + 1]);
+            }
+            if (num_samples % 2) {
+                this->log_samples[num_samples / 2] = this->log_samples[num_samples - 1];
+            }
+            this->log_samples.resize((num_samples + 1) / 2);
+            this->log_num_calls_in_last_sample = ((num_samples % 2) ? this->log_num_calls_per_sample : 2 * this->log_num_calls_per_sample);
+            this->log_num_calls_per_sample *= 2;
+
+            if (this->log_num_calls_in_last_sample < this->log_num_calls_per_sample) {
+                mergeLogSamples(this->log_samples.back(), sample);
+                this->log_num_calls_in_last_sample++;
+                return;
+            }
+        }
+
+        this->log_samples.push_back(sample);
+        this->log_num_calls_in_last_sample = 1;
+    }
+
+    /**
+     * @brief Merge a log sample into another (keeping peak usage)
+     * @param sample: the sample
+     * @param other: a later sample
+     */
+    void MemoryManager::mergeLogSamples(LogSample &sample, const LogSample &other) {
+        sample.dirty = std::max<double>(sample.dirty, other.dirty);
+        sample.cached = std::max<double>(sample.cached, other.cached);
+        sample.free = std::min<double>(sample.free, other.free);
     }
 
     /**
-     * @brief Export the log to a file
+     * @brief Export the log to a file, in CSV format (one line per sample, with dates relative to the
+     *        first sample and amounts in MB)
      * @param filename: file path
+     *
+     * @throw std::invalid_argument
      */
     void MemoryManager::export_log(std::string filename) {
         FILE *log_file = fopen(filename.c_str(), "w");
-        fprintf(log_file, "time, total_mem, dirty, cache, used_mem\n");
+        if (log_file == nullptr) {
+            throw std::invalid_argument("MemoryManager::export_log(): Cannot open file " + filename);
+        }
 
-        double start = this->time_log.at(0);
-        for (unsigned int i = 0; i < this->time_log.size(); i++) {
-            fprintf(log_file, "%lf, %lf, %lf, %lf, %lf\n",
-                    this->time_log.at(i) - start,
-                    total / 1000000.0,
-                    this->dirty_log.at(i) / 1000000.0,
-                    this->cached_log.at(i) / 1000000.0,
-                    (total - this->free_log.at(i)) / 1000000.0);
+        // Lines are formatted into a buffer that is written in large chunks
+        std::string buffer = "time, total_mem, dirty, cache, used_mem\n";
+        const size_t chunk_size = 1 << 16;
+        char line[256];
+
+        double start = (this->log_samples.empty() ? 0 : this->log_samples.front().time);
+        for (auto const &sample: this->log_samples) {
+            snprintf(line, sizeof(line), "%lf, %lf, %lf, %lf, %lf\n",
+                     sample.time - start,
+                     total / 1000000.0,
+                     sample.dirty / 1000000.0,
+                     sample.cached / 1000000.0,
+                     (total - sample.free) / 1000000.0);
+            buffer += line;
+            if (buffer.size() >= chunk_size) {
+                fwrite(buffer.data(), 1, buffer.size(), log_file);
+                buffer.clear();
+            }
         }
+        fwrite(buffer.data(), 1, buffer.size(), log_file);
 
         fclose(log_file);
     }
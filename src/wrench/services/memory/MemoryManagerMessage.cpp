@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/memory/MemoryManagerMessage.h>
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     *
+     * @param payload: the message size in bytes
+     */
+    MemoryManagerMessage::MemoryManagerMessage(double payload)
+        : ServiceMessage(payload) {}
+
+    /**
+     * @brief Constructor
+     *
+     * @param payload: the message size in bytes
+     */
+    MemoryManagerWakeUpMessage::MemoryManagerWakeUpMessage(double payload)
+        : MemoryManagerMessage(payload) {}
+
+}// namespace wrench
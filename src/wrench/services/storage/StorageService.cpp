@@ -19,6 +19,8 @@
 #include <wrench/simgrid_S4U_util/S4U_Mailbox.h>
 #include <wrench/simulation/Simulation.h>
 #include <wrench/simgrid_S4U_util/S4U_PendingCommunication.h>
+#include <wrench/simgrid_S4U_util/S4U_Simulation.h>
+#include <wrench/failure_causes/NetworkError.h>
 
 #include <memory>
 
@@ -357,6 +359,142 @@ namespace wrench {
         }
     }
 
+    /**
+     * @brief Synchronously asks storage services whether they hold files, using a single
+     *        request/answer exchange per storage service
+     *
+     * @param locations: the file locations
+     *
+     * @return whether each file is available, in the order of the locations
+     *
+     * @throw ExecutionException
+     * @throw std::invalid_arguments
+     */
+    std::vector<bool> StorageService::lookupFiles(const std::vector<std::shared_ptr<FileLocation>> &locations) {
+        std::vector<bool> files_are_available;
+        std::vector<std::shared_ptr<FailureCause>> failure_causes;
+        StorageService::lookupOrDeleteFiles(true, locations, files_are_available, failure_causes);
+        for (auto const &failure_cause: failure_causes) {
+            if (failure_cause) {
+                throw ExecutionException(failure_cause);
+            }
+        }
+        return files_are_available;
+    }
+
+    /**
+     * @brief Lookup or delete files, by sending a single bulk request to each storage service involved
+     *        (all requests are sent before any answer is waited for). The payload of a bulk request
+     *        is the payload of the corresponding single-file request times the number of files.
+     *
+     * @param lookup: true to lookup files, false to delete them
+     * @param locations: the file locations
+     * @param files_are_available: set to whether each file is available (lookup only)
+     * @param failure_causes: set to the cause of the failure for each file (nullptr if none)
+     *
+     * @throw std::invalid_arguments
+     * @throw std::runtime_error
+     */
+    void StorageService::lookupOrDeleteFiles(bool lookup,
+                                             const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                             std::vector<bool> &files_are_available,
+                                             std::vector<std::shared_ptr<FailureCause>> &failure_causes) {
+        files_are_available.assign(locations.size(), false);
+        failure_causes.assign(locations.size(), nullptr);
+
+        // Group locations by storage service (in order of first appearance)
+        std::vector<std::shared_ptr<StorageService>> storage_services;
+        std::map<StorageService *, std::vector<size_t>> indices;
+        for (size_t i = 0; i < locations.size(); i++) {
+            if (locations[i] == nullptr) {
+                throw std::invalid_argument("StorageService::lookupOrDeleteFiles(): Invalid nullptr location");
+            }
+            auto storage_service = locations[i]->getStorageService();
+            auto &group = indices[storage_service.get()];
+            if (group.empty()) {
+                storage_services.push_back(storage_service);
+            }
+            group.push_back(i);
+        }
+
+        // Send all requests
+        std::vector<simgrid::s4u::Mailbox *> answer_mailboxes(storage_services.size(), nullptr);
+        for (size_t k = 0; k < storage_services.size(); k++) {
+            auto storage_service = storage_services[k];
+            auto &group = indices[storage_service.get()];
+            std::vector<std::shared_ptr<FileLocation>> group_locations;
+            group_locations.reserve(group.size());
+            for (auto i: group) {
+                group_locations.push_back(locations[i]);
+            }
+            auto answer_mailbox = S4U_Mailbox::getTemporaryMailbox();
+            try {
+                assertServiceIsUp(storage_service);
+                if (lookup) {
+                    S4U_Mailbox::putMessage(
+                            storage_service->mailbox,
+                            new StorageServiceBulkFileLookupRequestMessage(
+                                    answer_mailbox,
+                                    group_locations,
+                                    (double) group.size() * storage_service->getMessagePayloadValue(
+                                                                    StorageServiceMessagePayload::FILE_LOOKUP_REQUEST_MESSAGE_PAYLOAD)));
+                } else {
+                    S4U_Mailbox::putMessage(
+                            storage_service->mailbox,
+                            new StorageServiceBulkFileDeleteRequestMessage(
+                                    answer_mailbox,
+                                    group_locations,
+                                    (double) group.size() * storage_service->getMessagePayloadValue(
+                                                                    StorageServiceMessagePayload::FILE_DELETE_REQUEST_MESSAGE_PAYLOAD)));
+                }
+            } catch (ExecutionException &e) {
+                S4U_Mailbox::retireTemporaryMailbox(answer_mailbox);
+                for (auto i: group) {
+                    failure_causes[i] = e.getCause();
+                }
+                continue;
+            }
+            answer_mailboxes[k] = answer_mailbox;
+        }
+
+        // Wait for all answers
+        std::string unexpected_message_error;
+        for (size_t k = 0; k < storage_services.size(); k++) {
+            if (answer_mailboxes[k] == nullptr) {
+                continue;
+            }
+            auto storage_service = storage_services[k];
+            auto &group = indices[storage_service.get()];
+            std::unique_ptr<SimulationMessage> message;
+            try {
+                message = S4U_Mailbox::getMessage(answer_mailboxes[k], storage_service->network_timeout);
+            } catch (ExecutionException &e) {
+                S4U_Mailbox::retireTemporaryMailbox(answer_mailboxes[k]);
+                for (auto i: group) {
+                    failure_causes[i] = e.getCause();
+                }
+                continue;
+            }
+            S4U_Mailbox::retireTemporaryMailbox(answer_mailboxes[k]);
+
+            if (auto msg = dynamic_cast<StorageServiceBulkFileLookupAnswerMessage *>(message.get())) {
+                for (size_t j = 0; (j < group.size()) and (j < msg->files_are_available.size()); j++) {
+                    files_are_available[group[j]] = msg->files_are_available[j];
+                }
+            } else if (auto msg = dynamic_cast<StorageServiceBulkFileDeleteAnswerMessage *>(message.get())) {
+                for (size_t j = 0; (j < group.size()) and (j < msg->failure_causes.size()); j++) {
+                    failure_causes[group[j]] = msg->failure_causes[j];
+                }
+            } else {
+                unexpected_message_error = "StorageService::lookupOrDeleteFiles(): Unexpected [" + message->getName() + "] message";
+            }
+        }
+
+        if (not unexpected_message_error.empty()) {
+            throw std::runtime_error(unexpected_message_error);
+        }
+    }
+
     /**
      * @brief Synchronously read a file from the storage service
      *
@@ -495,40 +633,53 @@ namespace wrench {
 
 
     /**
- * @brief Synchronously and sequentially read a set of files from storage services
+ * @brief Synchronously read a set of files from storage services. Files are read in
+ *        lexicographic order of their IDs, and up to max_num_concurrent_reads of them are
+ *        read concurrently.
  *
  * @param locations: a map of files to locations
+ * @param max_num_concurrent_reads: the maximum number of concurrent reads (1 means sequential reads)
  *
  * @throw std::runtime_error
  * @throw ExecutionException
  */
-    void StorageService::readFiles(std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations) {
-        StorageService::writeOrReadFiles(READ, std::move(locations));
+    void StorageService::readFiles(std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations,
+                                   unsigned long max_num_concurrent_reads) {
+        StorageService::writeOrReadFiles(READ, std::move(locations), max_num_concurrent_reads);
     }
 
     /**
- * @brief Synchronously and sequentially upload a set of files from storage services
+ * @brief Synchronously upload a set of files to storage services. Files are written in
+ *        lexicographic order of their IDs, and up to max_num_concurrent_writes of them are
+ *        written concurrently.
  *
  * @param locations: a map of files to locations
+ * @param max_num_concurrent_writes: the maximum number of concurrent writes (1 means sequential writes)
  *
  * @throw std::runtime_error
  * @throw ExecutionException
  */
-    void StorageService::writeFiles(std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations) {
-        StorageService::writeOrReadFiles(WRITE, std::move(locations));
+    void StorageService::writeFiles(std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations,
+                                    unsigned long max_num_concurrent_writes) {
+        StorageService::writeOrReadFiles(WRITE, std::move(locations), max_num_concurrent_writes);
     }
 
     /**
- * @brief Synchronously and sequentially write/read a set of files to/from storage services
+ * @brief Synchronously write/read a set of files to/from storage services
  *
  * @param action: FileOperation::READ (download) or FileOperation::WRITE
  * @param locations: a map of files to locations
+ * @param max_num_concurrent_operations: the maximum number of concurrent reads/writes
  *
  * @throw std::runtime_error
  * @throw ExecutionException
  */
     void StorageService::writeOrReadFiles(FileOperation action,
-                                          std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations) {
+                                          std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> locations,
+                                          unsigned long max_num_concurrent_operations) {
+        if (max_num_concurrent_operations < 1) {
+            throw std::invalid_argument("StorageService::writeOrReadFiles(): the maximum number of concurrent operations should be >= 1");
+        }
         for (auto const &f: locations) {
             if ((f.first == nullptr) or (f.second == nullptr)) {
                 throw std::invalid_argument("StorageService::writeOrReadFiles(): invalid argument");
@@ -541,6 +692,16 @@ namespace wrench {
             sorted_files[f.first->getID()] = f.first;
         }
 
+        if (max_num_concurrent_operations > 1) {
+            std::vector<std::shared_ptr<FileLocation>> sorted_locations;
+            sorted_locations.reserve(sorted_files.size());
+            for (auto const &f: sorted_files) {
+                sorted_locations.push_back(locations[f.second]);
+            }
+            StorageService::writeOrReadFilesConcurrently(action, sorted_locations, max_num_concurrent_operations);
+            return;
+        }
+
         for (auto const &f: sorted_files) {
             auto file = f.second;
             auto location = locations[file];
@@ -564,6 +725,269 @@ namespace wrench {
         }
     }
 
+    /**
+ * @brief Synchronously write/read a set of files to/from storage services, with overlapping
+ *        transfers. Operations are started in the given order, and each operation uses its own
+ *        answer mailbox so that the messages of concurrent operations are never mixed up. All
+ *        communications (including the file chunks of bufferized writes) are asynchronous, so
+ *        that ongoing transfers progress simultaneously. The same network timeouts as for
+ *        sequential operations apply. If operations fail, the ongoing ones are still completed
+ *        (so that storage services are never left blocked on a transfer), and the failure of the
+ *        first failed operation, in the given order, is thrown.
+ *
+ * @param action: FileOperation::READ (download) or FileOperation::WRITE
+ * @param sorted_locations: the file locations, in the order in which operations should be started
+ * @param max_num_concurrent_operations: the maximum number of concurrent reads/writes
+ *
+ * @throw std::runtime_error
+ * @throw ExecutionException
+ */
+    void StorageService::writeOrReadFilesConcurrently(FileOperation action,
+                                                      const std::vector<std::shared_ptr<FileLocation>> &sorted_locations,
+                                                      unsigned long max_num_concurrent_operations) {
+        // The state of an ongoing operation, as a function of the communication it is waiting for
+        enum OperationState {
+            WAITING_FOR_ANSWER,
+            WAITING_FOR_CHUNK,
+            SENDING_CHUNK,
+            WAITING_FOR_ACK
+        };
+        struct Operation {
+            size_t index;
+            std::shared_ptr<FileLocation> location;
+            simgrid::s4u::Mailbox *answer_mailbox;
+            simgrid::s4u::Mailbox *content_mailbox;
+            OperationState state;
+            // Date by which the awaited message must have arrived (-1 means no timeout)
+            double deadline;
+            // Bufferized writes: chunk size and number of bytes not sent yet
+            double buffer_size;
+            double remaining_bytes;
+        };
+
+        std::vector<Operation> ongoing_operations;
+        std::vector<std::shared_ptr<S4U_PendingCommunication>> pending_comms;
+        // Failures, indexed by position in sorted_locations (so that the one thrown is deterministic)
+        std::map<size_t, std::shared_ptr<FailureCause>> failures;
+        std::string unexpected_message_error;
+        size_t next_to_start = 0;
+
+        auto finish_operation = [&](size_t i) {
+            // Bufferized writes do not own the mailbox they send chunks to
+            if (ongoing_operations[i].content_mailbox and (action == READ)) {
+                S4U_Mailbox::retireTemporaryMailbox(ongoing_operations[i].content_mailbox);
+            }
+            S4U_Mailbox::retireTemporaryMailbox(ongoing_operations[i].answer_mailbox);
+            ongoing_operations.erase(ongoing_operations.begin() + (long) i);
+            pending_comms.erase(pending_comms.begin() + (long) i);
+        };
+
+        auto wait_for_answer = [&](size_t i, double timeout) {
+            auto &operation = ongoing_operations[i];
+            operation.deadline = (timeout < 0 ? -1 : S4U_Simulation::getClock() + timeout);
+            pending_comms[i] = S4U_Mailbox::igetMessage(operation.answer_mailbox);
+        };
+
+        // Send the next chunk of a bufferized write (the last chunk carries the remaining bytes)
+        auto send_next_chunk = [&](size_t i) {
+            auto &operation = ongoing_operations[i];
+            auto file = operation.location->getFile();
+            bool last_chunk = (operation.remaining_bytes - operation.buffer_size <= DBL_EPSILON);
+            double chunk_size = (last_chunk ? operation.remaining_bytes : operation.buffer_size);
+            operation.remaining_bytes -= chunk_size;
+            operation.state = SENDING_CHUNK;
+            operation.deadline = -1;
+            pending_comms[i] = S4U_Mailbox::iputMessage(operation.content_mailbox,
+                                                        new StorageServiceFileContentChunkMessage(file, chunk_size, last_chunk));
+        };
+
+        while ((next_to_start < sorted_locations.size()) or (not ongoing_operations.empty())) {
+
+            // Start as many operations as allowed, unless something has gone wrong already
+            while ((next_to_start < sorted_locations.size()) and
+                   (ongoing_operations.size() < max_num_concurrent_operations) and
+                   failures.empty() and unexpected_message_error.empty()) {
+                auto location = sorted_locations[next_to_start];
+                auto storage_service = location->getStorageService();
+                auto file = location->getFile();
+                auto answer_mailbox = S4U_Mailbox::getTemporaryMailbox();
+                try {
+                    assertServiceIsUp(storage_service);
+                    if (action == READ) {
+                        WRENCH_INFO("Reading file %s from location %s", file->getID().c_str(), location->toString().c_str());
+                        S4U_Mailbox::putMessage(storage_service->mailbox,
+                                                new StorageServiceFileReadRequestMessage(
+                                                        answer_mailbox,
+                                                        simgrid::s4u::this_actor::get_host(),
+                                                        location,
+                                                        file->getSize(),
+                                                        storage_service->getMessagePayloadValue(
+                                                                StorageServiceMessagePayload::FILE_READ_REQUEST_MESSAGE_PAYLOAD)));
+                    } else {
+                        WRENCH_INFO("Writing file %s to location %s", file->getID().c_str(), location->toString().c_str());
+                        S4U_Mailbox::putMessage(storage_service->mailbox,
+                                                new StorageServiceFileWriteRequestMessage(
+                                                        answer_mailbox,
+                                                        simgrid::s4u::this_actor::get_host(),
+                                                        location,
+                                                        storage_service->buffer_size,
+                                                        storage_service->getMessagePayloadValue(
+                                                                StorageServiceMessagePayload::FILE_WRITE_REQUEST_MESSAGE_PAYLOAD)));
+                    }
+                    pending_comms.push_back(nullptr);
+                    ongoing_operations.push_back({next_to_start, location, answer_mailbox, nullptr, WAITING_FOR_ANSWER, -1, 0, 0});
+                    wait_for_answer(ongoing_operations.size() - 1, storage_service->network_timeout);
+                } catch (ExecutionException &e) {
+                    if ((not ongoing_operations.empty()) and (ongoing_operations.back().index == next_to_start)) {
+                        ongoing_operations.pop_back();
+                        pending_comms.pop_back();
+                    }
+                    S4U_Mailbox::retireTemporaryMailbox(answer_mailbox);
+                    failures[next_to_start] = e.getCause();
+                    break;
+                }
+                next_to_start++;
+            }
+
+            if (ongoing_operations.empty()) {
+                break;
+            }
+
+            // Wait for the next communication of any ongoing operation to complete, but
+            // no longer than the earliest deadline
+            double earliest_deadline = -1;
+            for (auto const &operation: ongoing_operations) {
+                if ((operation.deadline >= 0) and ((earliest_deadline < 0) or (operation.deadline < earliest_deadline))) {
+                    earliest_deadline = operation.deadline;
+                }
+            }
+            double timeout = (earliest_deadline < 0 ? -1 : std::max<double>(0, earliest_deadline - S4U_Simulation::getClock()));
+            auto i = S4U_PendingCommunication::waitForSomethingToHappen(pending_comms, timeout);
+
+            if (i == ULONG_MAX) {
+                // Time out the operations whose awaited message is overdue
+                for (size_t j = ongoing_operations.size(); j-- > 0;) {
+                    if (ongoing_operations[j].deadline == earliest_deadline) {
+                        pending_comms[j]->comm_ptr->cancel();
+                        failures[ongoing_operations[j].index] = std::make_shared<NetworkError>(
+                                NetworkError::RECEIVING, NetworkError::TIMEOUT, ongoing_operations[j].answer_mailbox->get_name());
+                        finish_operation(j);
+                    }
+                }
+                continue;
+            }
+
+            auto &operation = ongoing_operations[i];
+            auto file = operation.location->getFile();
+            std::unique_ptr<SimulationMessage> message;
+            try {
+                message = pending_comms[i]->wait();
+            } catch (ExecutionException &e) {
+                failures[operation.index] = e.getCause();
+                finish_operation(i);
+                continue;
+            }
+
+            // Sending/receiving the next message may fail, in which case the operation is over
+            try {
+                switch (operation.state) {
+                    case WAITING_FOR_ANSWER: {
+                        bool success;
+                        std::shared_ptr<FailureCause> failure_cause;
+                        double buffer_size;
+                        simgrid::s4u::Mailbox *data_mailbox;
+                        if (auto read_msg = dynamic_cast<StorageServiceFileReadAnswerMessage *>(message.get())) {
+                            success = read_msg->success;
+                            failure_cause = read_msg->failure_cause;
+                            buffer_size = read_msg->buffer_size;
+                            data_mailbox = read_msg->mailbox_to_receive_the_file_content;
+                        } else if (auto write_msg = dynamic_cast<StorageServiceFileWriteAnswerMessage *>(message.get())) {
+                            success = write_msg->success;
+                            failure_cause = write_msg->failure_cause;
+                            buffer_size = (write_msg->location ? write_msg->location->getStorageService()->buffer_size : 0);
+                            data_mailbox = write_msg->data_write_mailbox;
+                        } else {
+                            unexpected_message_error = "StorageService::writeOrReadFiles(): Received an unexpected [" +
+                                                       message->getName() + "] message!";
+                            finish_operation(i);
+                            break;
+                        }
+                        if (not success) {
+                            failures[operation.index] = failure_cause;
+                            finish_operation(i);
+                            break;
+                        }
+                        if (buffer_size < 1) {
+                            // Non-bufferized: just wait for the final ack (no timeout!)
+                            operation.state = WAITING_FOR_ACK;
+                            wait_for_answer(i, -1);
+                        } else if (action == READ) {
+                            // Bufferized read: receive the file chunks until the last one
+                            operation.content_mailbox = data_mailbox;
+                            operation.state = WAITING_FOR_CHUNK;
+                            operation.deadline = -1;
+                            pending_comms[i] = S4U_Mailbox::igetMessage(operation.content_mailbox);
+                        } else {
+                            // Bufferized write: send the file chunks one at a time, then wait for the final ack
+                            operation.content_mailbox = data_mailbox;
+                            operation.buffer_size = buffer_size;
+                            operation.remaining_bytes = file->getSize();
+                            send_next_chunk(i);
+                        }
+                        break;
+                    }
+                    case WAITING_FOR_CHUNK: {
+                        auto chunk_msg = dynamic_cast<StorageServiceFileContentChunkMessage *>(message.get());
+                        if (not chunk_msg) {
+                            unexpected_message_error = "StorageService::writeOrReadFiles(): Received an unexpected [" +
+                                                       message->getName() + "] message! (was expecting a StorageServiceFileContentChunkMessage)";
+                            finish_operation(i);
+                            break;
+                        }
+                        if (chunk_msg->last_chunk) {
+                            S4U_Mailbox::retireTemporaryMailbox(operation.content_mailbox);
+                            operation.content_mailbox = nullptr;
+                            operation.state = WAITING_FOR_ACK;
+                            wait_for_answer(i, operation.location->getStorageService()->network_timeout);
+                        } else {
+                            pending_comms[i] = S4U_Mailbox::igetMessage(operation.content_mailbox);
+                        }
+                        break;
+                    }
+                    case SENDING_CHUNK: {
+                        if (operation.remaining_bytes > 0) {
+                            send_next_chunk(i);
+                        } else {
+                            operation.state = WAITING_FOR_ACK;
+                            wait_for_answer(i, operation.location->getStorageService()->network_timeout);
+                        }
+                        break;
+                    }
+                    case WAITING_FOR_ACK: {
+                        if (not dynamic_cast<StorageServiceAckMessage *>(message.get())) {
+                            unexpected_message_error = "StorageService::writeOrReadFiles(): Received an unexpected [" +
+                                                       message->getName() + "] message instead of final ack!";
+                        } else {
+                            WRENCH_INFO("File %s %s", file->getID().c_str(), (action == READ ? "read" : "written"));
+                        }
+                        finish_operation(i);
+                        break;
+                    }
+                }
+            } catch (ExecutionException &e) {
+                failures[operation.index] = e.getCause();
+                finish_operation(i);
+            }
+        }
+
+        if (not failures.empty()) {
+            throw ExecutionException(failures.begin()->second);
+        }
+        if (not unexpected_message_error.empty()) {
+            throw std::runtime_error(unexpected_message_error);
+        }
+    }
+
     /**
      * @brief Synchronously delete a file at a location
      *
@@ -614,6 +1038,43 @@ namespace wrench {
         }
     }
 
+    /**
+     * @brief Synchronously delete files at locations, using a single request/answer exchange per
+     *        storage service. All deletions are attempted even if some fail.
+     *
+     * @param locations: the file locations
+     * @param file_registry_service: a file registry service that should be updated once the
+     *         file deletions have (successfully) completed (none if nullptr)
+     *
+     * @throw ExecutionException (for the first failed deletion, in the order of the locations)
+     * @throw std::invalid_arguments
+     */
+    void StorageService::deleteFiles(const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                     const std::shared_ptr<FileRegistryService> &file_registry_service) {
+        std::vector<bool> ignored;
+        std::vector<std::shared_ptr<FailureCause>> failure_causes;
+        StorageService::lookupOrDeleteFiles(false, locations, ignored, failure_causes);
+
+        std::shared_ptr<FailureCause> first_failure_cause = nullptr;
+        for (size_t i = 0; i < locations.size(); i++) {
+            if (failure_causes[i]) {
+                if (first_failure_cause == nullptr) {
+                    first_failure_cause = failure_causes[i];
+                }
+                continue;
+            }
+            WRENCH_INFO("Deleted file %s at location %s",
+                        locations[i]->getFile()->getID().c_str(), locations[i]->toString().c_str());
+            if (file_registry_service) {
+                file_registry_service->removeEntry(locations[i]);
+            }
+        }
+
+        if (first_failure_cause) {
+            throw ExecutionException(first_failure_cause);
+        }
+    }
+
     /**
      * @brief Synchronously ask the storage service to read a file from another storage service
      *
@@ -755,6 +1216,54 @@ namespace wrench {
         return to_return;
     }
 
+    /**
+ * @brief Get the cache statistics (hits, misses, evictions) of the storage service (in zero simulation time)
+ * @return cache statistics for each mount point, in a map
+ */
+    std::map<std::string, LogicalFileSystem::CacheStatistics> StorageService::getCacheStatistics() {
+        std::map<std::string, LogicalFileSystem::CacheStatistics> to_return;
+        for (auto const &fs: this->file_systems) {
+            to_return[fs.first] = fs.second->getCacheStatistics();
+        }
+        return to_return;
+    }
+
+    /**
+     * @brief Pin a file, so that it cannot be evicted from the storage service if the storage service has
+     *        a caching behavior (in zero simulation time). Pins are counted, i.e., a file that is pinned
+     *        twice must be unpinned twice. Pinning a file that is not there does nothing.
+     * @param location: the file's location at the storage service
+     *
+     * @throw std::invalid_argument
+     */
+    void StorageService::pinFile(const std::shared_ptr<FileLocation> &location) {
+        if (location->getStorageService().get() != this) {
+            throw std::invalid_argument("StorageService::pinFile(): Location is not at this storage service");
+        }
+        auto fs = this->file_systems.find(location->getMountPoint());
+        if (fs == this->file_systems.end()) {
+            throw std::invalid_argument("StorageService::pinFile(): Unknown mount point " + location->getMountPoint());
+        }
+        fs->second->incrementNumRunningTransactionsForFileInDirectory(location->getFile(), location->getAbsolutePathAtMountPoint());
+    }
+
+    /**
+     * @brief Unpin a file that was pinned with pinFile() (in zero simulation time)
+     * @param location: the file's location at the storage service
+     *
+     * @throw std::invalid_argument
+     */
+    void StorageService::unpinFile(const std::shared_ptr<FileLocation> &location) {
+        if (location->getStorageService().get() != this) {
+            throw std::invalid_argument("StorageService::unpinFile(): Location is not at this storage service");
+        }
+        auto fs = this->file_systems.find(location->getMountPoint());
+        if (fs == this->file_systems.end()) {
+            throw std::invalid_argument("StorageService::unpinFile(): Unknown mount point " + location->getMountPoint());
+        }
+        fs->second->decrementNumRunningTransactionsForFileInDirectory(location->getFile(), location->getAbsolutePathAtMountPoint());
+    }
+
     /**
  * @brief Get the mount point (will throw is more than one)
  * @return the (sole) mount point of the service
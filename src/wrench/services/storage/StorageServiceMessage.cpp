@@ -17,6 +17,7 @@
 #include <wrench/services/compute/virtualized_cluster/VirtualizedClusterComputeService.h>
 #include <wrench/services/storage/StorageService.h>
 
+#include <algorithm>
 #include <utility>
 
 namespace wrench {
@@ -165,6 +166,72 @@ namespace wrench {
         this->failure_cause = std::move(failure_cause);
     }
 
+    /**
+     * @brief Constructor
+     * @param answer_mailbox: the mailbox to which to send the answer
+     * @param locations: the file locations
+     * @param payload: the message size in bytes
+     *
+     * @throw std::invalid_argument
+     */
+    StorageServiceBulkFileLookupRequestMessage::StorageServiceBulkFileLookupRequestMessage(simgrid::s4u::Mailbox *answer_mailbox,
+                                                                                           std::vector<std::shared_ptr<FileLocation>> locations,
+                                                                                           double payload)
+        : StorageServiceMessage(payload) {
+#ifdef WRENCH_INTERNAL_EXCEPTIONS
+        if ((answer_mailbox == nullptr) || (std::find(locations.begin(), locations.end(), nullptr) != locations.end())) {
+            throw std::invalid_argument(
+                    "StorageServiceBulkFileLookupRequestMessage::StorageServiceBulkFileLookupRequestMessage(): Invalid arguments");
+        }
+#endif
+        this->answer_mailbox = answer_mailbox;
+        this->locations = std::move(locations);
+    }
+
+    /**
+     * @brief Constructor
+     * @param files_are_available: whether each file is available on the storage system
+     * @param payload: the message size in bytes
+     */
+    StorageServiceBulkFileLookupAnswerMessage::StorageServiceBulkFileLookupAnswerMessage(std::vector<bool> files_are_available,
+                                                                                         double payload)
+        : StorageServiceMessage(payload) {
+        this->files_are_available = std::move(files_are_available);
+    }
+
+    /**
+     * @brief Constructor
+     * @param answer_mailbox: the mailbox to which to send the answer
+     * @param locations: the file locations
+     * @param payload: the message size in bytes
+     *
+     * @throw std::invalid_argument
+     */
+    StorageServiceBulkFileDeleteRequestMessage::StorageServiceBulkFileDeleteRequestMessage(simgrid::s4u::Mailbox *answer_mailbox,
+                                                                                           std::vector<std::shared_ptr<FileLocation>> locations,
+                                                                                           double payload)
+        : StorageServiceMessage(payload) {
+#ifdef WRENCH_INTERNAL_EXCEPTIONS
+        if ((answer_mailbox == nullptr) || (std::find(locations.begin(), locations.end(), nullptr) != locations.end())) {
+            throw std::invalid_argument(
+                    "StorageServiceBulkFileDeleteRequestMessage::StorageServiceBulkFileDeleteRequestMessage(): Invalid arguments");
+        }
+#endif
+        this->answer_mailbox = answer_mailbox;
+        this->locations = std::move(locations);
+    }
+
+    /**
+     * @brief Constructor
+     * @param failure_causes: the cause of the failure of each deletion (nullptr means "no failure")
+     * @param payload: the message size in bytes
+     */
+    StorageServiceBulkFileDeleteAnswerMessage::StorageServiceBulkFileDeleteAnswerMessage(std::vector<std::shared_ptr<FailureCause>> failure_causes,
+                                                                                         double payload)
+        : StorageServiceMessage(payload) {
+        this->failure_causes = std::move(failure_causes);
+    }
+
     /**
     * @brief Constructor
     * @param answer_mailbox: the mailbox to which to send the answer (if nullptr, no answer will be sent)
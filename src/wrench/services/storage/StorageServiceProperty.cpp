@@ -15,5 +15,6 @@ namespace wrench {
 
     SET_PROPERTY_NAME(StorageServiceProperty, BUFFER_SIZE);
     SET_PROPERTY_NAME(StorageServiceProperty, CACHING_BEHAVIOR);
+    SET_PROPERTY_NAME(StorageServiceProperty, CACHING_TTL);
 
 };// namespace wrench
@@ -9,6 +9,10 @@
 #include <wrench/failure_causes/NotAllowed.h>
 #include <wrench/exceptions/ExecutionException.h>
 #include <wrench/logging/TerminalOutput.h>
+#include <wrench/simulation/Simulation.h>
+
+#include <algorithm>
+#include <cmath>
 
 WRENCH_LOG_CATEGORY(wrench_core_compound_storage_system,
                     "Log category for Compound Storage Service");
@@ -111,6 +115,19 @@ namespace wrench {
             }
             */
 
+        this->stripe_count = this->getPropertyValueAsUnsignedLong(CompoundStorageServiceProperty::STRIPE_COUNT);
+        this->stripe_size = this->getPropertyValueAsSizeInByte(CompoundStorageServiceProperty::STRIPE_SIZE);
+        if (this->stripe_count < 1) {
+            throw std::invalid_argument("CompoundStorageService::CompoundStorageService(): Invalid STRIPE_COUNT property value (must be >= 1)");
+        }
+        if (this->stripe_size <= 0) {
+            throw std::invalid_argument("CompoundStorageService::CompoundStorageService(): Invalid STRIPE_SIZE property value (must be > 0)");
+        }
+        if ((this->stripe_count > 1) and
+            std::any_of(storage_services.begin(), storage_services.end(), [](const auto &elem) { return elem->isBufferized(); })) {
+            throw std::invalid_argument("CompoundStorageService::CompoundStorageService(): Striping (STRIPE_COUNT > 1) requires all storage services to be non-bufferized");
+        }
+
         // CSS should be non-bufferized, as it actually doesn't copy / transfer anything
         // and this allows it to receive message requests for copy (otherwise, src storage service might receive it)
         this->buffer_size = 0;
@@ -118,6 +135,26 @@ namespace wrench {
         this->storage_selection = storage_selection;
         this->isStorageSelectionUserProvided = storage_selection_user_provided;
 
+        // Built-in storage selection method
+        auto storage_selection_method = this->getPropertyValueAsString(CompoundStorageServiceProperty::STORAGE_SELECTION_METHOD);
+        if (storage_selection_method != "external") {
+            if (storage_selection_user_provided) {
+                throw std::invalid_argument("CompoundStorageService::CompoundStorageService(): Cannot use both a storage selection callback "
+                                            "and the built-in storage selection method " + storage_selection_method);
+            }
+            auto strategy = StorageSelectionStrategy::createStorageSelectionStrategy(
+                    storage_selection_method,
+                    storage_services,
+                    this->getPropertyValueAsBoolean(CompoundStorageServiceProperty::STORAGE_SELECTION_WEIGHTED_BY_CAPACITY));
+            this->storage_selection_strategy = strategy;
+            this->storage_selection = [strategy](const std::shared_ptr<DataFile> &file,
+                                                 const std::set<std::shared_ptr<StorageService>> &resources,
+                                                 const std::map<std::shared_ptr<DataFile>, std::shared_ptr<FileLocation>> &mapping) {
+                return strategy->selectLocation(file, resources);
+            };
+            this->isStorageSelectionUserProvided = true;
+        }
+
         // Dummy logical file system
         this->file_systems[LogicalFileSystem::DEV_NULL] = LogicalFileSystem::createLogicalFileSystem(
                 this->getHostname(),
@@ -220,6 +257,15 @@ namespace wrench {
         } else if (auto msg = dynamic_cast<StorageServiceFileLookupRequestMessage *>(message)) {
             return processFileLookupRequest(msg);
 
+        } else if (auto msg = dynamic_cast<StorageServiceBulkFileDeleteRequestMessage *>(message)) {
+            return processBulkFileRequest(BulkFileOperationThread::DELETE, msg->locations, msg->answer_mailbox);
+
+        } else if (auto msg = dynamic_cast<StorageServiceBulkFileLookupRequestMessage *>(message)) {
+            return processBulkFileRequest(BulkFileOperationThread::LOOKUP, msg->locations, msg->answer_mailbox);
+
+        } else if (auto msg = dynamic_cast<StorageServiceFreeSpaceRequestMessage *>(message)) {
+            return processFreeSpaceRequest(msg);
+
         } else if (auto msg = dynamic_cast<StorageServiceFileWriteRequestMessage *>(message)) {
             return processFileWriteRequest(msg);
 
@@ -271,6 +317,159 @@ namespace wrench {
     }
 
 
+    /**
+     * @brief Lookup for the stripes of a DataFile that the CompoundStorageService has striped over several storage services
+     *
+     * @param file: the file of interest
+     *
+     * @return The locations of the file's stripes (in stripe order), or an empty vector if the file is not a known striped file
+     */
+    std::vector<std::shared_ptr<FileLocation>> CompoundStorageService::lookupFileStripeLocations(const std::shared_ptr<DataFile> &file) {
+        auto it = this->stripe_location_mapping.find(file);
+        if (it == this->stripe_location_mapping.end()) {
+            return {};
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Compute the number of stripes a file should be striped over
+     *
+     * @param file: the file of interest
+     *
+     * @return a number of stripes (1 means that the file is not striped)
+     */
+    unsigned long CompoundStorageService::getNumStripes(const std::shared_ptr<DataFile> &file) {
+        if (this->stripe_count <= 1) {
+            return 1;
+        }
+        auto num_units = (unsigned long) std::ceil(file->getSize() / this->stripe_size);
+        return std::max<unsigned long>(1, std::min<unsigned long>({this->stripe_count, this->storage_services.size(), num_units}));
+    }
+
+    /**
+     * @brief Compute how many bytes of each stripe hold the first bytes of a file, given that
+     *        stripe units are placed on stripes in a round-robin fashion
+     *
+     * @param num_bytes: a number of bytes from the beginning of the file (e.g., the file size)
+     * @param num_stripes: the number of stripes
+     *
+     * @return a number of bytes for each stripe
+     */
+    std::vector<double> CompoundStorageService::computeStripeSizes(double num_bytes, unsigned long num_stripes) {
+        std::vector<double> stripe_sizes(num_stripes, 0);
+        auto num_full_units = (unsigned long) std::floor(num_bytes / this->stripe_size);
+        for (unsigned long i = 0; i < num_stripes; i++) {
+            stripe_sizes.at(i) = (double) (num_full_units / num_stripes + (i < num_full_units % num_stripes ? 1 : 0)) * this->stripe_size;
+        }
+        stripe_sizes.at(num_full_units % num_stripes) += num_bytes - (double) num_full_units * this->stripe_size;
+        return stripe_sizes;
+    }
+
+    /**
+     * @brief Place the stripes of a file on distinct storage services, using the 'storage_selection' callback
+     *        (each stripe is a file named after the file, e.g., "f_stripe_0", which is private to this
+     *        service and thus not registered with the simulation, so that it cannot collide with user files)
+     *
+     * @param file: the file of interest
+     *
+     * @return The locations of the file's stripes, or an empty vector if they could not all be placed
+     */
+    std::vector<std::shared_ptr<FileLocation>> CompoundStorageService::designateStripeLocations(const std::shared_ptr<DataFile> &file) {
+        auto num_stripes = this->getNumStripes(file);
+        auto stripe_sizes = this->computeStripeSizes(file->getSize(), num_stripes);
+        auto candidate_services = this->storage_services;
+        std::vector<std::shared_ptr<FileLocation>> stripe_locations;
+
+        for (unsigned long i = 0; i < num_stripes; i++) {
+            auto stripe_id = file->getID() + "_stripe_" + std::to_string(i);
+            auto stripe_file = std::shared_ptr<DataFile>(new DataFile(stripe_id, stripe_sizes.at(i)));
+
+            auto stripe_location = this->storage_selection(stripe_file, candidate_services, this->file_location_mapping);
+            if ((!stripe_location) or (candidate_services.find(stripe_location->getStorageService()) == candidate_services.end())) {
+                WRENCH_DEBUG("designateStripeLocations: Stripe %s could not be placed on a distinct ss", stripe_id.c_str());
+                for (auto const &l: stripe_locations) {
+                    this->forgetFile(l->getFile());
+                }
+                return {};
+            }
+
+            WRENCH_DEBUG("designateStripeLocations: Registering stripe %s on storage service %s, at path %s",
+                         stripe_id.c_str(),
+                         stripe_location->getStorageService()->getName().c_str(),
+                         stripe_location->getFullAbsolutePath().c_str());
+            candidate_services.erase(stripe_location->getStorageService());
+            this->file_location_mapping[stripe_file] = stripe_location;
+            stripe_locations.push_back(stripe_location);
+        }
+
+        this->stripe_location_mapping[file] = stripe_locations;
+        return stripe_locations;
+    }
+
+    /**
+     * @brief Remove a file from the internal file mapping (and account for it in the built-in storage selection strategy, if any)
+     *
+     * @param file: the file of interest
+     */
+    void CompoundStorageService::forgetFile(const std::shared_ptr<DataFile> &file) {
+        auto it = this->file_location_mapping.find(file);
+        if (it == this->file_location_mapping.end()) {
+            return;
+        }
+        if (this->storage_selection_strategy) {
+            this->storage_selection_strategy->fileRemoved(it->second);
+        }
+        this->file_location_mapping.erase(it);
+    }
+
+    /**
+     * @brief Remove a striped file, and its stripes, from the internal file mapping
+     *
+     * @param file: the file of interest
+     */
+    void CompoundStorageService::forgetStripedFile(const std::shared_ptr<DataFile> &file) {
+        for (auto const &stripe_location: this->lookupFileStripeLocations(file)) {
+            this->forgetFile(stripe_location->getFile());
+        }
+        this->stripe_location_mapping.erase(file);
+    }
+
+    /**
+     * @brief Start a thread that performs an operation on a striped file and answers the client
+     *
+     * @param operation: the operation
+     * @param location: the location of the file at this CompoundStorageService
+     * @param stripe_locations: the locations of the file's stripes
+     * @param num_bytes_per_stripe: the number of bytes to transfer for each stripe (for reads, writes and copies)
+     * @param answer_mailbox: the client's answer mailbox
+     * @param requesting_host: the host whose network link the data goes through
+     * @param copy_src: the source location of a copy (nullptr if not a copy)
+     * @param copy_dst: the destination location of a copy (nullptr if not a copy)
+     */
+    void CompoundStorageService::startStripedFileOperation(StripedFileOperationThread::Operation operation,
+                                                           const std::shared_ptr<FileLocation> &location,
+                                                           const std::vector<std::shared_ptr<FileLocation>> &stripe_locations,
+                                                           const std::vector<double> &num_bytes_per_stripe,
+                                                           simgrid::s4u::Mailbox *answer_mailbox,
+                                                           simgrid::s4u::Host *requesting_host,
+                                                           const std::shared_ptr<FileLocation> &copy_src,
+                                                           const std::shared_ptr<FileLocation> &copy_dst) {
+        auto thread = std::make_shared<StripedFileOperationThread>(
+                this->getHostname(),
+                this->getSharedPtr<CompoundStorageService>(),
+                operation,
+                location,
+                stripe_locations,
+                num_bytes_per_stripe,
+                answer_mailbox,
+                requesting_host,
+                copy_src,
+                copy_dst);
+        thread->setSimulation(this->simulation);
+        thread->start(thread, true, false);// Daemonize, non-auto-restart
+    }
+
     /**
      *  @brief Lookup for a DataFile in the internal file mapping of the CompoundStorageService, and if it is not found, 
      *         try to allocate the file on one of the underlying storage services, using the user-provided 'storage_selection'
@@ -327,6 +526,13 @@ namespace wrench {
      * @return true if this process should keep running
      */
     bool CompoundStorageService::processFileDeleteRequest(StorageServiceFileDeleteRequestMessage *msg) {
+        auto stripe_locations = this->lookupFileStripeLocations(msg->location->getFile());
+        if (not stripe_locations.empty()) {
+            this->startStripedFileOperation(StripedFileOperationThread::DELETE, msg->location, stripe_locations, {},
+                                            msg->answer_mailbox, nullptr);
+            return true;
+        }
+
         auto designated_location = this->lookupFileLocation(msg->location);
         if (!designated_location) {
             WRENCH_WARN("processFileDeleteRequest: Unable to find file %s",
@@ -346,13 +552,9 @@ namespace wrench {
             return true;
         }
 
-        S4U_Mailbox::putMessage(
-                designated_location->getStorageService()->mailbox,
-                new StorageServiceFileDeleteRequestMessage(
-                        msg->answer_mailbox,
-                        designated_location,
-                        designated_location->getStorageService()->getMessagePayloadValue(
-                                StorageServiceMessagePayload::FILE_DELETE_REQUEST_MESSAGE_PAYLOAD)));
+        // The file is forgotten only if its deletion succeeds, which a helper finds out
+        this->startStripedFileOperation(StripedFileOperationThread::DELETE, msg->location, {designated_location}, {},
+                                        msg->answer_mailbox, nullptr);
 
         return true;
     }
@@ -365,6 +567,13 @@ namespace wrench {
      * @return true if this process should keep running
      */
     bool CompoundStorageService::processFileLookupRequest(StorageServiceFileLookupRequestMessage *msg) {
+        auto stripe_locations = this->lookupFileStripeLocations(msg->location->getFile());
+        if (not stripe_locations.empty()) {
+            this->startStripedFileOperation(StripedFileOperationThread::LOOKUP, msg->location, stripe_locations, {},
+                                            msg->answer_mailbox, nullptr);
+            return true;
+        }
+
         auto designated_location = this->lookupFileLocation(msg->location);
         if (!designated_location) {
             WRENCH_WARN("processFileLookupRequest: Unable to find file %s", msg->location->getFile()->getID().c_str());
@@ -396,6 +605,81 @@ namespace wrench {
         return true;
     }
 
+    /**
+     * @brief Handle a bulk file lookup/delete request: the files are mapped to their locations (or stripe
+     *        locations) at the underlying storage services, and a helper sends a single bulk request
+     *        to each of these services before sending a single answer back to the client
+     *
+     * @param operation: the operation (lookup or delete)
+     * @param locations: the file locations
+     * @param answer_mailbox: the client's answer mailbox
+     *
+     * @return true if this process should keep running
+     */
+    bool CompoundStorageService::processBulkFileRequest(BulkFileOperationThread::Operation operation,
+                                                        const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                                        simgrid::s4u::Mailbox *answer_mailbox) {
+        std::vector<std::vector<std::shared_ptr<FileLocation>>> sub_locations;
+        sub_locations.reserve(locations.size());
+        for (auto const &location: locations) {
+            auto file = location->getFile();
+            auto stripe_locations = this->lookupFileStripeLocations(file);
+            if (stripe_locations.empty()) {
+                if (auto designated_location = this->lookupFileLocation(file)) {
+                    stripe_locations.push_back(designated_location);
+                } else {
+                    WRENCH_WARN("processBulkFileRequest: Unable to find file %s", file->getID().c_str());
+                }
+            }
+            sub_locations.push_back(stripe_locations);
+        }
+
+        // Deleted files are forgotten only once (and if) their deletion has succeeded
+        std::function<void(const std::shared_ptr<DataFile> &)> file_deleted_callback = nullptr;
+        if (operation == BulkFileOperationThread::DELETE) {
+            auto css = this->getSharedPtr<CompoundStorageService>();
+            file_deleted_callback = [css](const std::shared_ptr<DataFile> &file) {
+                if (not css->lookupFileStripeLocations(file).empty()) {
+                    css->forgetStripedFile(file);
+                } else {
+                    css->forgetFile(file);
+                }
+            };
+        }
+
+        auto thread = std::make_shared<BulkFileOperationThread>(
+                this->getHostname(),
+                this->getSharedPtr<CompoundStorageService>(),
+                operation,
+                locations,
+                sub_locations,
+                true,// All stripes must be deleted
+                answer_mailbox,
+                file_deleted_callback);
+        thread->setSimulation(this->simulation);
+        thread->start(thread, true, false);// Daemonize, non-auto-restart
+        return true;
+    }
+
+    /**
+     * @brief Handle a free space request
+     *
+     * @param msg: The StorageServiceFreeSpaceRequestMessage received by a CompoundStorageService
+     *
+     * @return true if this process should keep running
+     */
+    bool CompoundStorageService::processFreeSpaceRequest(StorageServiceFreeSpaceRequestMessage *msg) {
+        // The storage services are asked by a helper, since waiting for their answers here
+        // would prevent this daemon from processing other requests in the meantime
+        auto thread = std::make_shared<FreeSpaceRequestThread>(
+                this->getHostname(),
+                this->getSharedPtr<CompoundStorageService>(),
+                msg->answer_mailbox);
+        thread->setSimulation(this->simulation);
+        thread->start(thread, true, false);// Daemonize, non-auto-restart
+        return true;
+    }
+
     /**
      * @brief Handle (and intercept) a file copy request
      *
@@ -404,6 +688,16 @@ namespace wrench {
      * @return true if this process should keep running
      */
     bool CompoundStorageService::processFileCopyRequest(StorageServiceFileCopyRequestMessage *msg) {
+        // Copies to or from striped files are handled separately
+        auto file = msg->src->getFile();
+        bool src_is_compound = (std::dynamic_pointer_cast<CompoundStorageService>(msg->src->getStorageService()) != nullptr);
+        bool dst_is_compound = (std::dynamic_pointer_cast<CompoundStorageService>(msg->dst->getStorageService()) != nullptr);
+        bool is_striped = (not this->lookupFileStripeLocations(file).empty());
+        bool must_be_striped = (not is_striped) and (not this->lookupFileLocation(file)) and (this->getNumStripes(file) > 1);
+        if ((src_is_compound and is_striped) or (dst_is_compound and (is_striped or must_be_striped))) {
+            return this->processStripedFileCopyRequest(msg, src_is_compound, dst_is_compound);
+        }
+
         // If source location references a CSS, it must already be known to the CSS
         auto final_src = msg->src;
         if (std::dynamic_pointer_cast<CompoundStorageService>(msg->src->getStorageService())) {
@@ -502,6 +796,85 @@ namespace wrench {
         return true;
     }
 
+    /**
+     * @brief Handle a file copy request to or from a striped file. The file is streamed between the other storage
+     *        service, which must be non-bufferized, and all stripes concurrently.
+     *
+     * @param msg: The StorageServiceFileCopyRequestMessage received by a CompoundStorageService
+     * @param src_is_compound: whether the source is a CompoundStorageService
+     * @param dst_is_compound: whether the destination is a CompoundStorageService
+     *
+     * @return true if this process should keep running
+     */
+    bool CompoundStorageService::processStripedFileCopyRequest(StorageServiceFileCopyRequestMessage *msg,
+                                                               bool src_is_compound, bool dst_is_compound) {
+        auto file = msg->src->getFile();
+        std::shared_ptr<FailureCause> failure_cause = nullptr;
+        std::vector<std::shared_ptr<FileLocation>> stripe_locations;
+
+        std::string error;
+        if (src_is_compound and dst_is_compound) {
+            error = "CompoundStorageService can't copy a striped file to a CompoundStorageService";
+        } else if (src_is_compound and msg->dst->getStorageService()->isBufferized()) {
+            error = "CompoundStorageService can't copy a striped file to a bufferized storage service";
+        } else if (dst_is_compound and msg->src->getStorageService()->isBufferized()) {
+            error = "CompoundStorageService can't copy a striped file from a bufferized storage service";
+        } else {
+            stripe_locations = this->lookupFileStripeLocations(file);
+            if (stripe_locations.empty()) {
+                stripe_locations = this->designateStripeLocations(file);
+            }
+            if (stripe_locations.empty()) {
+                WRENCH_WARN("processStripedFileCopyRequest: Stripes of destination file %s could not be placed",
+                            file->getID().c_str());
+                if (!this->isStorageSelectionUserProvided) {
+                    error = "CompoundStorageService doesn't know dst file and can't allocate it because no storage_selection callback was provided";
+                } else {
+                    failure_cause = std::make_shared<StorageServiceNotEnoughSpace>(
+                            file,
+                            this->getSharedPtr<CompoundStorageService>());
+                }
+            }
+        }
+        if (not error.empty()) {
+            failure_cause = std::make_shared<NotAllowed>(
+                    this->getSharedPtr<CompoundStorageService>(),
+                    error);
+        }
+
+        if (failure_cause) {
+            try {
+                S4U_Mailbox::putMessage(
+                        msg->answer_mailbox,
+                        new StorageServiceFileCopyAnswerMessage(
+                                msg->src,
+                                msg->dst,
+                                nullptr,
+                                false,
+                                false,
+                                failure_cause,
+                                this->getMessagePayloadValue(
+                                        CompoundStorageServiceMessagePayload::FILE_COPY_ANSWER_MESSAGE_PAYLOAD)));
+            } catch (ExecutionException &e) {}
+
+            return true;
+        }
+
+        // The data goes through the network link of the other storage service's host
+        auto other_location = (src_is_compound ? msg->dst : msg->src);
+        auto requesting_host = simgrid::s4u::Host::by_name(other_location->getStorageService()->getHostname());
+
+        this->startStripedFileOperation(src_is_compound ? StripedFileOperationThread::COPY_FROM_STRIPES : StripedFileOperationThread::COPY_TO_STRIPES,
+                                        src_is_compound ? msg->src : msg->dst,
+                                        stripe_locations,
+                                        this->computeStripeSizes(file->getSize(), stripe_locations.size()),
+                                        msg->answer_mailbox,
+                                        requesting_host,
+                                        msg->src,
+                                        msg->dst);
+        return true;
+    }
+
     /**
      * @brief Handle (and intercept) a file write request. 
      *        Note: Currently it's not reachable, because we also override a writeFile,
@@ -511,8 +884,19 @@ namespace wrench {
      * @return true if this process should keep running
      */
     bool CompoundStorageService::processFileWriteRequest(StorageServiceFileWriteRequestMessage *msg) {
-        auto designated_location = this->lookupOrDesignateStorageService(msg->location);
-        if (!designated_location) {
+        auto file = msg->location->getFile();
+        auto stripe_locations = this->lookupFileStripeLocations(file);
+        bool must_be_striped = stripe_locations.empty() and (not this->lookupFileLocation(file)) and (this->getNumStripes(file) > 1);
+        if (must_be_striped) {
+            stripe_locations = this->designateStripeLocations(file);
+        }
+
+        std::shared_ptr<FileLocation> designated_location = nullptr;
+        if ((not must_be_striped) and stripe_locations.empty()) {
+            designated_location = this->lookupOrDesignateStorageService(msg->location);
+        }
+
+        if (stripe_locations.empty() and (!designated_location)) {
             WRENCH_WARN("processFileWriteRequest: Destination file %s not found or not enough space left",
                         msg->location->getFile()->getID().c_str());
             try {
@@ -530,6 +914,13 @@ namespace wrench {
             return true;
         }
 
+        if (not stripe_locations.empty()) {
+            this->startStripedFileOperation(StripedFileOperationThread::WRITE, msg->location, stripe_locations,
+                                            this->computeStripeSizes(file->getSize(), stripe_locations.size()),
+                                            msg->answer_mailbox, msg->requesting_host);
+            return true;
+        }
+
         // The file is known or added to the local mapping, we can forward the request to the underlying designated StorageService
         S4U_Mailbox::putMessage(
                 designated_location->getStorageService()->mailbox,
@@ -551,6 +942,16 @@ namespace wrench {
      * @return true if this process should keep running
      */
     bool CompoundStorageService::processFileReadRequest(StorageServiceFileReadRequestMessage *msg) {
+        auto stripe_locations = this->lookupFileStripeLocations(msg->location->getFile());
+        if (not stripe_locations.empty()) {
+            WRENCH_DEBUG("processFileReadRequest: Going to read file %s from %lu stripes",
+                         msg->location->getFile()->getID().c_str(), stripe_locations.size());
+            this->startStripedFileOperation(StripedFileOperationThread::READ, msg->location, stripe_locations,
+                                            this->computeStripeSizes(msg->num_bytes_to_read, stripe_locations.size()),
+                                            msg->answer_mailbox, msg->requesting_host);
+            return true;
+        }
+
         auto designated_location = this->lookupFileLocation(msg->location);
         if (!designated_location) {
             WRENCH_WARN("processFileReadRequest: file %s not found", msg->location->getFile()->getID().c_str());
@@ -619,9 +1020,9 @@ namespace wrench {
 
     /**
      * @brief Synchronously asks the storage services inside the compound storage service 
-     *        for their free space at all of their mount points
+     *        for their free space at all of their mount points (all services are asked concurrently)
      * 
-     * @return The free space in bytes of each mount point, as a map
+     * @return A map of service name and total free space in bytes of all mount points for each service
      *
      * @throw ExecutionException
      *
@@ -631,14 +1032,47 @@ namespace wrench {
     std::map<std::string, double> CompoundStorageService::getFreeSpace() {
         WRENCH_DEBUG("CompoundStorageService::getFreeSpace Forwarding request to internal services");
 
-        std::map<std::string, double> to_return = {};
-        std::map<std::string, simgrid::s4u::Mailbox *> mailboxes = {};
-
+        // Send all requests before waiting for any answer
+        std::vector<std::pair<std::shared_ptr<StorageService>, simgrid::s4u::Mailbox *>> requests;
+        auto retire_mailboxes = [&requests](size_t first) {
+            for (size_t i = first; i < requests.size(); i++) {
+                S4U_Mailbox::retireTemporaryMailbox(requests[i].second);
+            }
+        };
         for (const auto &service: this->storage_services) {
-            auto free_space = service->getFreeSpace();
+            auto mailbox = S4U_Mailbox::getTemporaryMailbox();
+            requests.emplace_back(service, mailbox);
+            try {
+                assertServiceIsUp(service);
+                S4U_Mailbox::putMessage(service->mailbox,
+                                        new StorageServiceFreeSpaceRequestMessage(
+                                                mailbox,
+                                                service->getMessagePayloadValue(
+                                                        StorageServiceMessagePayload::FREE_SPACE_REQUEST_MESSAGE_PAYLOAD)));
+            } catch (ExecutionException &e) {
+                retire_mailboxes(0);
+                throw;
+            }
+        }
 
-            to_return[service->getName()] = std::accumulate(free_space.begin(), free_space.end(), 0,
-                                                            [](const std::size_t previous, const auto &element) { return previous + element.second; });
+        std::map<std::string, double> to_return = {};
+        for (size_t i = 0; i < requests.size(); i++) {
+            auto service = requests[i].first;
+            std::unique_ptr<SimulationMessage> message;
+            try {
+                message = S4U_Mailbox::getMessage(requests[i].second, service->getNetworkTimeoutValue());
+            } catch (ExecutionException &e) {
+                retire_mailboxes(i);
+                throw;
+            }
+            S4U_Mailbox::retireTemporaryMailbox(requests[i].second);
+            auto msg = dynamic_cast<StorageServiceFreeSpaceAnswerMessage *>(message.get());
+            if (not msg) {
+                retire_mailboxes(i + 1);
+                throw std::runtime_error("CompoundStorageService::getFreeSpace(): Unexpected [" + message->getName() + "] message");
+            }
+            to_return[service->getName()] = std::accumulate(msg->free_space.begin(), msg->free_space.end(), 0.0,
+                                                            [](const double previous, const auto &element) { return previous + element.second; });
         }
 
         return to_return;
@@ -680,6 +1114,16 @@ namespace wrench {
             throw std::invalid_argument("CompoundStorageService::getFileLastWriteDate(): File not known to the CompoundStorageService. Unable to forward to underlying StorageService");
         }
 
+        // A striped file was last written when its last stripe was
+        auto stripe_locations = this->lookupFileStripeLocations(location->getFile());
+        if (not stripe_locations.empty()) {
+            double last_write_date = -1;
+            for (auto const &stripe_location: stripe_locations) {
+                last_write_date = std::max(last_write_date, stripe_location->getStorageService()->getFileLastWriteDate(stripe_location));
+            }
+            return last_write_date;
+        }
+
         auto designated_storage_service = std::dynamic_pointer_cast<SimpleStorageService>(*(this->storage_services.find(location->getStorageService())));
         if (designated_storage_service) {
             return designated_storage_service->getFileLastWriteDate(this->file_location_mapping[location->getFile()]);
@@ -697,7 +1141,8 @@ namespace wrench {
      * @return true if the file is present, false otherwise
      */
     bool CompoundStorageService::hasFile(const std::shared_ptr<DataFile> &file, const std::string &path) {
-        auto file_location = this->lookupFileLocation(file);
+        auto stripe_locations = this->lookupFileStripeLocations(file);
+        auto file_location = (stripe_locations.empty() ? this->lookupFileLocation(file) : stripe_locations.front());
         if (!file_location) {
             WRENCH_DEBUG("hasFile: File %s not found", file->getID().c_str());
             return false;
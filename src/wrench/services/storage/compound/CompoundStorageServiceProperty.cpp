@@ -13,5 +13,8 @@ namespace wrench {
 
 
     SET_PROPERTY_NAME(CompoundStorageServiceProperty, STORAGE_SELECTION_METHOD);
+    SET_PROPERTY_NAME(CompoundStorageServiceProperty, STORAGE_SELECTION_WEIGHTED_BY_CAPACITY);
+    SET_PROPERTY_NAME(CompoundStorageServiceProperty, STRIPE_COUNT);
+    SET_PROPERTY_NAME(CompoundStorageServiceProperty, STRIPE_SIZE);
 
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include <wrench/data_file/DataFile.h>
+#include <wrench/services/storage/StorageService.h>
+#include <wrench/services/storage/compound/ConsistentHashStorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param storage_services: the storage services on which files are placed
+     * @param weighted_by_capacity: whether the weight of a target is its capacity (otherwise all weights are 1)
+     */
+    ConsistentHashStorageSelectionStrategy::ConsistentHashStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services,
+                                                                                   bool weighted_by_capacity)
+        : StorageSelectionStrategy(storage_services, weighted_by_capacity) {
+        double max_weight = 0;
+        for (auto const &target: this->targets) {
+            max_weight = std::max<double>(max_weight, target.weight);
+        }
+        for (unsigned long i = 0; i < this->targets.size(); i++) {
+            auto &target = this->targets.at(i);
+            auto num_virtual_nodes = std::max<unsigned long>(
+                    1, (unsigned long) std::round((double) MAX_NUM_VIRTUAL_NODES * target.weight / max_weight));
+            for (unsigned long v = 0; v < num_virtual_nodes; v++) {
+                auto hash = std::hash<std::string>()(target.storage_service->getName() + ":" + target.mount_point + "#" + std::to_string(v));
+                // On a (very unlikely) collision, the first virtual node keeps its position
+                this->ring.insert(std::make_pair(hash, i));
+            }
+        }
+    }
+
+    /**
+     * @brief Pick a target for a file: the first eligible target clockwise from the hash of the file ID on the ring
+     * @param file: the file
+     * @param resources: the storage services that may be picked
+     * @return a target index, or -1 if no target is eligible
+     */
+    long ConsistentHashStorageSelectionStrategy::pickTarget(const std::shared_ptr<DataFile> &file,
+                                                            const std::set<std::shared_ptr<StorageService>> &resources) {
+        if (this->ring.empty()) {
+            return -1;
+        }
+        auto it = this->ring.lower_bound(std::hash<std::string>()(file->getID()));
+        for (unsigned long i = 0; i < this->ring.size(); i++, it++) {
+            if (it == this->ring.end()) {
+                it = this->ring.begin();
+            }
+            if (this->isEligible(it->second, file, resources)) {
+                return (long) it->second;
+            }
+        }
+        return -1;
+    }
+
+}// namespace wrench
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/storage/compound/FreeSpaceRequestThread.h>
+#include <wrench/services/storage/compound/CompoundStorageService.h>
+#include <wrench/services/storage/StorageServiceMessage.h>
+#include <wrench/simgrid_S4U_util/S4U_Mailbox.h>
+#include <wrench/exceptions/ExecutionException.h>
+#include <wrench/logging/TerminalOutput.h>
+
+#include <utility>
+
+WRENCH_LOG_CATEGORY(wrench_core_free_space_request_thread, "Log category for Free Space Request Thread");
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param hostname: host on which to run
+     * @param parent: the CompoundStorageService that received the request
+     * @param answer_mailbox: the mailbox of the client to which the answer should be sent
+     */
+    FreeSpaceRequestThread::FreeSpaceRequestThread(const std::string &hostname,
+                                                   std::shared_ptr<CompoundStorageService> parent,
+                                                   simgrid::s4u::Mailbox *answer_mailbox) : Service(hostname, "free_space_request_thread"),
+                                                                                            parent(std::move(parent)),
+                                                                                            answer_mailbox(answer_mailbox) {
+    }
+
+    /**
+     * @brief Cleanup method
+     * @param has_returned_from_main: whether main() returned
+     * @param return_value: the value returned by main() (if any)
+     */
+    void FreeSpaceRequestThread::cleanup(bool has_returned_from_main, int return_value) {
+        // Do nothing. It's fine to just die
+    }
+
+    /**
+     * @brief Main method
+     * @return 0 on success
+     */
+    int FreeSpaceRequestThread::main() {
+        TerminalOutput::setThisProcessLoggingColor(TerminalOutput::COLOR_CYAN);
+        WRENCH_INFO("New FreeSpaceRequestThread (parent=%s)", this->parent->getName().c_str());
+
+        std::map<std::string, double> free_space;
+        try {
+            free_space = this->parent->getFreeSpace();
+        } catch (ExecutionException &e) {
+            WRENCH_WARN("FreeSpaceRequestThread::main(): Unable to get the free space of all storage services");
+        }
+        try {
+            S4U_Mailbox::dputMessage(
+                    this->answer_mailbox,
+                    new StorageServiceFreeSpaceAnswerMessage(
+                            free_space,
+                            this->parent->getMessagePayloadValue(
+                                    CompoundStorageServiceMessagePayload::FREE_SPACE_ANSWER_MESSAGE_PAYLOAD)));
+        } catch (ExecutionException &ignore) {
+        }
+
+        return 0;
+    }
+
+}// namespace wrench
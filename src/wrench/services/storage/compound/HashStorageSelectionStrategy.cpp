@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include <wrench/data_file/DataFile.h>
+#include <wrench/services/storage/compound/HashStorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param storage_services: the storage services on which files are placed
+     * @param weighted_by_capacity: whether the weight of a target is its capacity (otherwise all weights are 1)
+     */
+    HashStorageSelectionStrategy::HashStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services,
+                                                               bool weighted_by_capacity)
+        : StorageSelectionStrategy(storage_services, weighted_by_capacity) {
+        double total_weight = 0;
+        for (auto const &target: this->targets) {
+            total_weight += target.weight;
+            this->cumulative_weights.push_back(total_weight);
+        }
+    }
+
+    /**
+     * @brief Pick a target for a file, with a binary search of the file ID's hash in the cumulative target weights
+     * @param file: the file
+     * @param resources: the storage services that may be picked
+     * @return a target index, or -1 if no target is eligible
+     */
+    long HashStorageSelectionStrategy::pickTarget(const std::shared_ptr<DataFile> &file,
+                                                  const std::set<std::shared_ptr<StorageService>> &resources) {
+        if (this->targets.empty()) {
+            return -1;
+        }
+        // Map the hash to [0, total_weight)
+        auto hash = std::hash<std::string>()(file->getID());
+        double point = ((double) (hash % 1000000007UL) / 1000000007.0) * this->cumulative_weights.back();
+        auto first = (unsigned long) (std::upper_bound(this->cumulative_weights.begin(), this->cumulative_weights.end(), point) -
+                                      this->cumulative_weights.begin());
+        first = std::min<unsigned long>(first, this->targets.size() - 1);
+
+        for (unsigned long i = 0; i < this->targets.size(); i++) {
+            auto index = (first + i) % this->targets.size();
+            if (this->isEligible(index, file, resources)) {
+                return (long) index;
+            }
+        }
+        return -1;
+    }
+
+}// namespace wrench
@@ -0,0 +1,35 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/storage/compound/LeastUsedStorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param storage_services: the storage services on which files are placed
+     * @param weighted_by_capacity: whether the weight of a target is its capacity (otherwise all weights are 1)
+     */
+    LeastUsedStorageSelectionStrategy::LeastUsedStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services,
+                                                                         bool weighted_by_capacity)
+        : OrderedStorageSelectionStrategy(storage_services, weighted_by_capacity) {
+        this->initOrder();
+    }
+
+    /**
+     * @brief Compute the sorting key of a target
+     * @param index: the target index
+     * @return the target's used space divided by its weight
+     */
+    double LeastUsedStorageSelectionStrategy::getKey(unsigned long index) {
+        auto &target = this->targets.at(index);
+        return target.used_space / target.weight;
+    }
+
+}// namespace wrench
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <algorithm>
+
+#include <wrench/services/storage/compound/RoundRobinStorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param storage_services: the storage services on which files are placed
+     * @param weighted_by_capacity: whether the weight of a target is its capacity (otherwise all weights are 1)
+     */
+    RoundRobinStorageSelectionStrategy::RoundRobinStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services,
+                                                                           bool weighted_by_capacity)
+        : OrderedStorageSelectionStrategy(storage_services, weighted_by_capacity) {
+        double max_weight = 0;
+        for (auto const &target: this->targets) {
+            max_weight = std::max<double>(max_weight, target.weight);
+        }
+        this->passes.assign(this->targets.size(), 0);
+        for (auto const &target: this->targets) {
+            this->strides.push_back(max_weight / target.weight);
+        }
+        this->initOrder();
+    }
+
+    /**
+     * @brief Compute the sorting key of a target
+     * @param index: the target index
+     * @return the target's pass value
+     */
+    double RoundRobinStorageSelectionStrategy::getKey(unsigned long index) {
+        return this->passes.at(index);
+    }
+
+    /**
+     * @brief Called right after the counters of a target are updated: advance its pass value if a file was placed on it
+     * @param index: the target index
+     * @param file_was_added: true if a file was placed on the target, false if a file was removed
+     */
+    void RoundRobinStorageSelectionStrategy::afterTargetUpdate(unsigned long index, bool file_was_added) {
+        if (file_was_added) {
+            this->passes.at(index) += this->strides.at(index);
+        }
+        OrderedStorageSelectionStrategy::afterTargetUpdate(index, file_was_added);
+    }
+
+}// namespace wrench
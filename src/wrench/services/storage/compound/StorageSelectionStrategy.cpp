@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <wrench/data_file/DataFile.h>
+#include <wrench/services/storage/StorageService.h>
+#include <wrench/services/storage/storage_helpers/FileLocation.h>
+#include <wrench/services/storage/compound/StorageSelectionStrategy.h>
+#include <wrench/services/storage/compound/RoundRobinStorageSelectionStrategy.h>
+#include <wrench/services/storage/compound/LeastUsedStorageSelectionStrategy.h>
+#include <wrench/services/storage/compound/MostFreeStorageSelectionStrategy.h>
+#include <wrench/services/storage/compound/HashStorageSelectionStrategy.h>
+#include <wrench/services/storage/compound/ConsistentHashStorageSelectionStrategy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Method to create a built-in placement strategy
+     * @param name: the strategy name ("round_robin", "least_used", "most_free", "hash", "consistent_hash")
+     * @param storage_services: the storage services on which files are placed
+     * @param weighted_by_capacity: whether the weight of a target is its capacity (otherwise all weights are 1)
+     * @return a strategy
+     *
+     * @throw std::invalid_argument
+     */
+    std::shared_ptr<StorageSelectionStrategy> StorageSelectionStrategy::createStorageSelectionStrategy(const std::string &name,
+                                                                                                      const std::set<std::shared_ptr<StorageService>> &storage_services,
+                                                                                                      bool weighted_by_capacity) {
+        if (name == "round_robin") {
+            return std::shared_ptr<StorageSelectionStrategy>(new RoundRobinStorageSelectionStrategy(storage_services, weighted_by_capacity));
+        } else if (name == "least_used") {
+            return std::shared_ptr<StorageSelectionStrategy>(new LeastUsedStorageSelectionStrategy(storage_services, weighted_by_capacity));
+        } else if (name == "most_free") {
+            return std::shared_ptr<StorageSelectionStrategy>(new MostFreeStorageSelectionStrategy(storage_services, weighted_by_capacity));
+        } else if (name == "hash") {
+            return std::shared_ptr<StorageSelectionStrategy>(new HashStorageSelectionStrategy(storage_services, weighted_by_capacity));
+        } else if (name == "consistent_hash") {
+            return std::shared_ptr<StorageSelectionStrategy>(new ConsistentHashStorageSelectionStrategy(storage_services, weighted_by_capacity));
+        } else {
+            throw std::invalid_argument("StorageSelectionStrategy::createStorageSelectionStrategy(): Unknown storage selection method " + name);
+        }
+    }
+
+    /**
+     * @brief Constructor: creates one target per mount point of each storage service (using their
+     *        capacities, which are known in zero simulated time). Targets are indexed in (service
+     *        name, mount point) order, so that placements do not depend on pointer values.
+     * @param storage_services: the storage services on which files are placed
+     * @param weighted_by_capacity: whether the weight of a target is its capacity (otherwise all weights are 1)
+     *
+     * @throw std::invalid_argument
+     */
+    StorageSelectionStrategy::StorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services,
+                                                       bool weighted_by_capacity) {
+        for (auto const &storage_service: storage_services) {
+            for (auto const &mp: storage_service->getTotalSpace()) {
+                Target target;
+                target.storage_service = storage_service;
+                target.mount_point = mp.first;
+                target.capacity = mp.second;
+                target.weight = (weighted_by_capacity ? mp.second : 1.0);
+                if (target.weight <= 0) {
+                    throw std::invalid_argument("StorageSelectionStrategy::StorageSelectionStrategy(): Cannot use a zero-capacity mount point as a weighted target");
+                }
+                if (std::isinf(target.weight)) {
+                    throw std::invalid_argument("StorageSelectionStrategy::StorageSelectionStrategy(): Cannot use an infinite-capacity mount point as a weighted target");
+                }
+                this->targets.push_back(target);
+            }
+        }
+
+        std::sort(this->targets.begin(), this->targets.end(), [](const Target &a, const Target &b) {
+            auto a_name = a.storage_service->getName();
+            auto b_name = b.storage_service->getName();
+            return (a_name < b_name) or ((a_name == b_name) and (a.mount_point < b.mount_point));
+        });
+        for (unsigned long i = 0; i < this->targets.size(); i++) {
+            this->target_indices[std::make_pair(this->targets.at(i).storage_service.get(), this->targets.at(i).mount_point)] = i;
+        }
+    }
+
+    /**
+     * @brief Determine whether a file can be placed on a target
+     * @param index: the target index
+     * @param file: the file
+     * @param resources: the storage services that may be picked
+     * @return true if the target's storage service is one of the resources and the target has enough (tracked) free space
+     */
+    bool StorageSelectionStrategy::isEligible(unsigned long index, const std::shared_ptr<DataFile> &file,
+                                              const std::set<std::shared_ptr<StorageService>> &resources) {
+        auto &target = this->targets.at(index);
+        return (target.capacity - target.used_space >= file->getSize()) and
+               (resources.find(target.storage_service) != resources.end());
+    }
+
+    /**
+     * @brief Select a location for a new file, and account for it
+     * @param file: the file
+     * @param resources: the storage services that may be picked
+     * @return a location, or nullptr if the file cannot be placed
+     */
+    std::shared_ptr<FileLocation> StorageSelectionStrategy::selectLocation(const std::shared_ptr<DataFile> &file,
+                                                                           const std::set<std::shared_ptr<StorageService>> &resources) {
+        auto index = this->pickTarget(file, resources);
+        if (index < 0) {
+            return nullptr;
+        }
+        this->updateTarget(index, file->getSize(), true);
+        auto &target = this->targets.at(index);
+        return FileLocation::LOCATION(target.storage_service, target.mount_point, file);
+    }
+
+    /**
+     * @brief Account for the removal of a file that was placed by this strategy
+     * @param location: the file's location
+     */
+    void StorageSelectionStrategy::fileRemoved(const std::shared_ptr<FileLocation> &location) {
+        auto it = this->target_indices.find(std::make_pair(location->getStorageService().get(), location->getMountPoint()));
+        if (it == this->target_indices.end()) {
+            return;
+        }
+        this->updateTarget(it->second, -location->getFile()->getSize(), false);
+    }
+
+    /**
+     * @brief Get the space used by the files placed on a target, as tracked by this strategy
+     * @param storage_service: the storage service
+     * @param mount_point: the mount point
+     * @return a number of bytes
+     *
+     * @throw std::invalid_argument
+     */
+    double StorageSelectionStrategy::getTrackedUsedSpace(const std::shared_ptr<StorageService> &storage_service, const std::string &mount_point) {
+        auto it = this->target_indices.find(std::make_pair(storage_service.get(), mount_point));
+        if (it == this->target_indices.end()) {
+            throw std::invalid_argument("StorageSelectionStrategy::getTrackedUsedSpace(): Unknown mount point " + mount_point);
+        }
+        return this->targets.at(it->second).used_space;
+    }
+
+    /**
+     * @brief Update the counters of a target
+     * @param index: the target index
+     * @param delta_used_space: the change in used space
+     * @param file_was_added: true if a file was placed on the target, false if a file was removed
+     */
+    void StorageSelectionStrategy::updateTarget(unsigned long index, double delta_used_space, bool file_was_added) {
+        this->beforeTargetUpdate(index);
+        auto &target = this->targets.at(index);
+        target.used_space = std::max<double>(0, target.used_space + delta_used_space);
+        if (file_was_added) {
+            target.num_files++;
+        } else if (target.num_files > 0) {
+            target.num_files--;
+        }
+        this->afterTargetUpdate(index, file_was_added);
+    }
+
+    /**
+     * @brief Constructor
+     * @param storage_services: the storage services on which files are placed
+     * @param weighted_by_capacity: whether the weight of a target is its capacity (otherwise all weights are 1)
+     */
+    OrderedStorageSelectionStrategy::OrderedStorageSelectionStrategy(const std::set<std::shared_ptr<StorageService>> &storage_services,
+                                                                     bool weighted_by_capacity)
+        : StorageSelectionStrategy(storage_services, weighted_by_capacity) {
+    }
+
+    /**
+     * @brief Sort all targets (to be called by the constructor of derived classes, once keys can be computed)
+     */
+    void OrderedStorageSelectionStrategy::initOrder() {
+        for (unsigned long i = 0; i < this->targets.size(); i++) {
+            this->ordered_targets.insert(std::make_pair(this->getKey(i), i));
+        }
+    }
+
+    /**
+     * @brief Pick the eligible target with the lowest key (ties are broken by target index)
+     * @param file: the file
+     * @param resources: the storage services that may be picked
+     * @return a target index, or -1 if no target is eligible
+     */
+    long OrderedStorageSelectionStrategy::pickTarget(const std::shared_ptr<DataFile> &file,
+                                                     const std::set<std::shared_ptr<StorageService>> &resources) {
+        for (auto const &entry: this->ordered_targets) {
+            if (this->isEligible(entry.second, file, resources)) {
+                return (long) entry.second;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Called right before the counters of a target are updated
+     * @param index: the target index
+     */
+    void OrderedStorageSelectionStrategy::beforeTargetUpdate(unsigned long index) {
+        this->ordered_targets.erase(std::make_pair(this->getKey(index), index));
+    }
+
+    /**
+     * @brief Called right after the counters of a target are updated
+     * @param index: the target index
+     * @param file_was_added: true if a file was placed on the target, false if a file was removed
+     */
+    void OrderedStorageSelectionStrategy::afterTargetUpdate(unsigned long index, bool file_was_added) {
+        this->ordered_targets.insert(std::make_pair(this->getKey(index), index));
+    }
+
+}// namespace wrench
@@ -0,0 +1,459 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/storage/compound/StripedFileOperationThread.h>
+#include <wrench/services/storage/compound/CompoundStorageService.h>
+#include <wrench/services/storage/StorageServiceMessage.h>
+#include <wrench/services/storage/StorageServiceMessagePayload.h>
+#include <wrench/simgrid_S4U_util/S4U_Mailbox.h>
+#include <wrench/exceptions/ExecutionException.h>
+#include <wrench/logging/TerminalOutput.h>
+#include <wrench/simulation/Simulation.h>
+
+#include <utility>
+
+WRENCH_LOG_CATEGORY(wrench_core_striped_file_operation_thread, "Log category for Striped File Operation Thread");
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param hostname: host on which to run
+     * @param parent: the CompoundStorageService that striped the file
+     * @param operation: the operation to perform
+     * @param location: the location of the (logical) file at the CompoundStorageService
+     * @param stripe_locations: the locations of the file's stripes
+     * @param num_bytes_per_stripe: the number of bytes to read from each stripe (only used by READ and COPY_FROM_STRIPES)
+     * @param answer_mailbox: the mailbox of the client to which answers should be sent
+     * @param requesting_host: the host whose network link the data goes through (the client's host for
+     *        READ and WRITE, the host of the other storage service for COPY_TO_STRIPES and COPY_FROM_STRIPES)
+     * @param copy_src: the source location of a copy (nullptr if not a copy)
+     * @param copy_dst: the destination location of a copy (nullptr if not a copy)
+     */
+    StripedFileOperationThread::StripedFileOperationThread(const std::string &hostname,
+                                                           std::shared_ptr<CompoundStorageService> parent,
+                                                           Operation operation,
+                                                           std::shared_ptr<FileLocation> location,
+                                                           std::vector<std::shared_ptr<FileLocation>> stripe_locations,
+                                                           std::vector<double> num_bytes_per_stripe,
+                                                           simgrid::s4u::Mailbox *answer_mailbox,
+                                                           simgrid::s4u::Host *requesting_host,
+                                                           std::shared_ptr<FileLocation> copy_src,
+                                                           std::shared_ptr<FileLocation> copy_dst) : Service(hostname, "striped_file_operation_thread"),
+                                                                                                     parent(std::move(parent)),
+                                                                                                     operation(operation),
+                                                                                                     location(std::move(location)),
+                                                                                                     stripe_locations(std::move(stripe_locations)),
+                                                                                                     num_bytes_per_stripe(std::move(num_bytes_per_stripe)),
+                                                                                                     answer_mailbox(answer_mailbox),
+                                                                                                     requesting_host(requesting_host),
+                                                                                                     copy_src(std::move(copy_src)),
+                                                                                                     copy_dst(std::move(copy_dst)) {
+    }
+
+    /**
+     * @brief Cleanup method
+     * @param has_returned_from_main: whether main() returned
+     * @param return_value: the value returned by main() (if any)
+     */
+    void StripedFileOperationThread::cleanup(bool has_returned_from_main, int return_value) {
+        // Do nothing. It's fine to just die
+    }
+
+    /**
+     * @brief Main method
+     * @return 0 on success
+     */
+    int StripedFileOperationThread::main() {
+        TerminalOutput::setThisProcessLoggingColor(TerminalOutput::COLOR_CYAN);
+
+        auto file = this->location->getFile();
+        WRENCH_INFO("New StripedFileOperationThread (file=%s, num_stripes=%lu)",
+                    file->getID().c_str(), this->stripe_locations.size());
+
+        switch (this->operation) {
+            case READ:
+            case WRITE: {
+                std::vector<Transfer> transfers;
+                for (unsigned long i = 0; i < this->stripe_locations.size(); i++) {
+                    if ((this->operation == READ) and (this->num_bytes_per_stripe.at(i) <= 0)) {
+                        continue;
+                    }
+                    transfers.push_back({this->stripe_locations.at(i),
+                                         this->operation == READ,
+                                         this->num_bytes_per_stripe.at(i),
+                                         this->requesting_host,
+                                         this->operation == WRITE});
+                }
+                auto failure_cause = this->performTransfers(transfers, true);
+                if (failure_cause and (this->operation == WRITE)) {
+                    this->undoWrites(transfers);
+                    this->parent->forgetStripedFile(file);
+                }
+                break;
+            }
+            case COPY_TO_STRIPES:
+            case COPY_FROM_STRIPES: {
+                // The whole file is streamed between the other storage service and the stripes: the
+                // other storage service reads (resp. writes) the file while the stripes are written (resp. read)
+                // through its host's network link
+                std::vector<Transfer> transfers;
+                bool to_stripes = (this->operation == COPY_TO_STRIPES);
+                transfers.push_back({to_stripes ? this->copy_src : this->copy_dst,
+                                     to_stripes,
+                                     file->getSize(),
+                                     this->requesting_host,
+                                     not to_stripes});
+                for (unsigned long i = 0; i < this->stripe_locations.size(); i++) {
+                    transfers.push_back({this->stripe_locations.at(i),
+                                         not to_stripes,
+                                         this->num_bytes_per_stripe.at(i),
+                                         this->requesting_host,
+                                         to_stripes});
+                }
+                auto failure_cause = this->performTransfers(transfers, false);
+                if (failure_cause) {
+                    this->undoWrites(transfers);
+                    if (to_stripes) {
+                        this->parent->forgetStripedFile(file);
+                    }
+                }
+                this->sendClientCopyAnswer(failure_cause);
+                break;
+            }
+            case LOOKUP:
+                this->performLookup();
+                break;
+            case DELETE:
+                this->performDelete();
+                break;
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Perform a set of transfers concurrently, and wait for all of them to complete
+     * @param transfers: the transfers
+     * @param answer_client: whether the client should be sent an answer once all storage services have
+     *        answered, and an ack once all transfers have completed
+     * @return a failure cause, or nullptr on success
+     */
+    std::shared_ptr<FailureCause> StripedFileOperationThread::performTransfers(std::vector<Transfer> &transfers, bool answer_client) {
+        std::shared_ptr<FailureCause> failure_cause = nullptr;
+
+        // Send all requests
+        for (auto &transfer: transfers) {
+            auto storage_service = transfer.location->getStorageService();
+            transfer.mailbox = S4U_Mailbox::getTemporaryMailbox();
+            try {
+                if (transfer.is_read) {
+                    S4U_Mailbox::putMessage(
+                            storage_service->mailbox,
+                            new StorageServiceFileReadRequestMessage(
+                                    transfer.mailbox,
+                                    transfer.requesting_host,
+                                    transfer.location,
+                                    transfer.num_bytes,
+                                    storage_service->getMessagePayloadValue(
+                                            StorageServiceMessagePayload::FILE_READ_REQUEST_MESSAGE_PAYLOAD)));
+                } else {
+                    S4U_Mailbox::putMessage(
+                            storage_service->mailbox,
+                            new StorageServiceFileWriteRequestMessage(
+                                    transfer.mailbox,
+                                    transfer.requesting_host,
+                                    transfer.location,
+                                    0,
+                                    storage_service->getMessagePayloadValue(
+                                            StorageServiceMessagePayload::FILE_WRITE_REQUEST_MESSAGE_PAYLOAD)));
+                }
+            } catch (ExecutionException &e) {
+                if (not failure_cause) {
+                    failure_cause = e.getCause();
+                }
+                S4U_Mailbox::retireTemporaryMailbox(transfer.mailbox);
+                transfer.mailbox = nullptr;
+            }
+        }
+
+        // Wait for all answers
+        for (auto &transfer: transfers) {
+            if (transfer.mailbox == nullptr) {
+                continue;
+            }
+            std::shared_ptr<FailureCause> cause = nullptr;
+            try {
+                auto message = S4U_Mailbox::getMessage(transfer.mailbox,
+                                                       transfer.location->getStorageService()->getNetworkTimeoutValue());
+                if (auto msg = dynamic_cast<StorageServiceFileReadAnswerMessage *>(message.get())) {
+                    transfer.started = msg->success;
+                    cause = msg->failure_cause;
+                } else if (auto msg = dynamic_cast<StorageServiceFileWriteAnswerMessage *>(message.get())) {
+                    transfer.started = msg->success;
+                    cause = msg->failure_cause;
+                } else {
+                    throw std::runtime_error("StripedFileOperationThread::performTransfers(): Unexpected [" +
+                                             message->getName() + "] message");
+                }
+            } catch (ExecutionException &e) {
+                cause = e.getCause();
+            }
+            if ((not transfer.started) and (not failure_cause)) {
+                failure_cause = cause;
+            }
+        }
+
+        bool client_was_answered_successfully = answer_client and (failure_cause == nullptr);
+        if (answer_client) {
+            this->sendClientAnswer(failure_cause);
+        }
+
+        // Wait for all transfers to complete
+        for (auto &transfer: transfers) {
+            if (transfer.started) {
+                try {
+                    auto message = S4U_Mailbox::getMessage(transfer.mailbox);
+                    if (not dynamic_cast<StorageServiceAckMessage *>(message.get())) {
+                        throw std::runtime_error("StripedFileOperationThread::performTransfers(): Received an unexpected [" +
+                                                 message->getName() + "] message instead of final ack!");
+                    }
+                } catch (ExecutionException &e) {
+                    if (not failure_cause) {
+                        failure_cause = e.getCause();
+                    }
+                }
+            }
+            if (transfer.mailbox) {
+                S4U_Mailbox::retireTemporaryMailbox(transfer.mailbox);
+            }
+        }
+
+        if (client_was_answered_successfully) {
+            S4U_Mailbox::dputMessage(this->answer_mailbox, new StorageServiceAckMessage(this->location));
+        }
+
+        return failure_cause;
+    }
+
+    /**
+     * @brief Delete the files written by the transfers that were started and must be undone on failure
+     * @param transfers: the transfers
+     */
+    void StripedFileOperationThread::undoWrites(std::vector<Transfer> &transfers) {
+        for (auto const &transfer: transfers) {
+            if ((not transfer.started) or (not transfer.undo_on_failure)) {
+                continue;
+            }
+            try {
+                StorageService::deleteFile(transfer.location);
+            } catch (ExecutionException &ignore) {
+                // The file may have been evicted or deleted already
+            }
+        }
+    }
+
+    /**
+     * @brief Send the client the answer to its read or write request
+     * @param failure_cause: the failure cause (nullptr on success)
+     */
+    void StripedFileOperationThread::sendClientAnswer(const std::shared_ptr<FailureCause> &failure_cause) {
+        try {
+            if (this->operation == READ) {
+                S4U_Mailbox::dputMessage(
+                        this->answer_mailbox,
+                        new StorageServiceFileReadAnswerMessage(
+                                this->location,
+                                failure_cause == nullptr,
+                                failure_cause,
+                                nullptr,
+                                0,
+                                this->parent->getMessagePayloadValue(
+                                        CompoundStorageServiceMessagePayload::FILE_READ_ANSWER_MESSAGE_PAYLOAD)));
+            } else {
+                S4U_Mailbox::dputMessage(
+                        this->answer_mailbox,
+                        new StorageServiceFileWriteAnswerMessage(
+                                this->location,
+                                failure_cause == nullptr,
+                                failure_cause,
+                                nullptr,
+                                this->parent->getMessagePayloadValue(
+                                        CompoundStorageServiceMessagePayload::FILE_WRITE_ANSWER_MESSAGE_PAYLOAD)));
+            }
+        } catch (ExecutionException &ignore) {
+        }
+    }
+
+    /**
+     * @brief Send the client the answer to its copy request
+     * @param failure_cause: the failure cause (nullptr on success)
+     */
+    void StripedFileOperationThread::sendClientCopyAnswer(const std::shared_ptr<FailureCause> &failure_cause) {
+        try {
+            if (failure_cause) {
+                this->simulation->getOutput().addTimestampFileCopyFailure(
+                        Simulation::getCurrentSimulatedDate(), this->location->getFile(), this->copy_src, this->copy_dst);
+            } else {
+                this->simulation->getOutput().addTimestampFileCopyCompletion(
+                        Simulation::getCurrentSimulatedDate(), this->location->getFile(), this->copy_src, this->copy_dst);
+            }
+        } catch (std::invalid_argument &ignore) {
+        }
+
+        try {
+            S4U_Mailbox::dputMessage(
+                    this->answer_mailbox,
+                    new StorageServiceFileCopyAnswerMessage(
+                            this->copy_src,
+                            this->copy_dst,
+                            nullptr,
+                            false,
+                            failure_cause == nullptr,
+                            failure_cause,
+                            this->parent->getMessagePayloadValue(
+                                    CompoundStorageServiceMessagePayload::FILE_COPY_ANSWER_MESSAGE_PAYLOAD)));
+        } catch (ExecutionException &ignore) {
+        }
+    }
+
+    /**
+     * @brief Look up all stripes concurrently, and answer the client (the file is available if all stripes are)
+     */
+    void StripedFileOperationThread::performLookup() {
+        std::vector<simgrid::s4u::Mailbox *> mailboxes;
+        for (auto const &stripe_location: this->stripe_locations) {
+            auto storage_service = stripe_location->getStorageService();
+            auto mailbox = S4U_Mailbox::getTemporaryMailbox();
+            try {
+                S4U_Mailbox::putMessage(
+                        storage_service->mailbox,
+                        new StorageServiceFileLookupRequestMessage(
+                                mailbox,
+                                stripe_location,
+                                storage_service->getMessagePayloadValue(
+                                        StorageServiceMessagePayload::FILE_LOOKUP_REQUEST_MESSAGE_PAYLOAD)));
+            } catch (ExecutionException &e) {
+                S4U_Mailbox::retireTemporaryMailbox(mailbox);
+                mailbox = nullptr;
+            }
+            mailboxes.push_back(mailbox);
+        }
+
+        bool file_is_available = true;
+        for (unsigned long i = 0; i < mailboxes.size(); i++) {
+            if (mailboxes.at(i) == nullptr) {
+                file_is_available = false;
+                continue;
+            }
+            try {
+                auto message = S4U_Mailbox::getMessage(mailboxes.at(i),
+                                                       this->stripe_locations.at(i)->getStorageService()->getNetworkTimeoutValue());
+                auto msg = dynamic_cast<StorageServiceFileLookupAnswerMessage *>(message.get());
+                if (not msg) {
+                    throw std::runtime_error("StripedFileOperationThread::performLookup(): Unexpected [" +
+                                             message->getName() + "] message");
+                }
+                file_is_available = file_is_available and msg->file_is_available;
+            } catch (ExecutionException &e) {
+                file_is_available = false;
+            }
+            S4U_Mailbox::retireTemporaryMailbox(mailboxes.at(i));
+        }
+
+        try {
+            S4U_Mailbox::dputMessage(
+                    this->answer_mailbox,
+                    new StorageServiceFileLookupAnswerMessage(
+                            this->location->getFile(),
+                            file_is_available,
+                            this->parent->getMessagePayloadValue(
+                                    CompoundStorageServiceMessagePayload::FILE_LOOKUP_ANSWER_MESSAGE_PAYLOAD)));
+        } catch (ExecutionException &ignore) {
+        }
+    }
+
+    /**
+     * @brief Delete all stripes concurrently, and answer the client (the deletion succeeds if all stripe deletions do)
+     */
+    void StripedFileOperationThread::performDelete() {
+        std::shared_ptr<FailureCause> failure_cause = nullptr;
+
+        std::vector<simgrid::s4u::Mailbox *> mailboxes;
+        for (auto const &stripe_location: this->stripe_locations) {
+            auto storage_service = stripe_location->getStorageService();
+            auto mailbox = S4U_Mailbox::getTemporaryMailbox();
+            try {
+                S4U_Mailbox::putMessage(
+                        storage_service->mailbox,
+                        new StorageServiceFileDeleteRequestMessage(
+                                mailbox,
+                                stripe_location,
+                                storage_service->getMessagePayloadValue(
+                                        StorageServiceMessagePayload::FILE_DELETE_REQUEST_MESSAGE_PAYLOAD)));
+            } catch (ExecutionException &e) {
+                if (not failure_cause) {
+                    failure_cause = e.getCause();
+                }
+                S4U_Mailbox::retireTemporaryMailbox(mailbox);
+                mailbox = nullptr;
+            }
+            mailboxes.push_back(mailbox);
+        }
+
+        bool some_stripe_was_deleted = false;
+        for (unsigned long i = 0; i < mailboxes.size(); i++) {
+            if (mailboxes.at(i) == nullptr) {
+                continue;
+            }
+            try {
+                auto message = S4U_Mailbox::getMessage(mailboxes.at(i),
+                                                       this->stripe_locations.at(i)->getStorageService()->getNetworkTimeoutValue());
+                auto msg = dynamic_cast<StorageServiceFileDeleteAnswerMessage *>(message.get());
+                if (not msg) {
+                    throw std::runtime_error("StripedFileOperationThread::performDelete(): Unexpected [" +
+                                             message->getName() + "] message");
+                }
+                if (msg->success) {
+                    some_stripe_was_deleted = true;
+                } else if (not failure_cause) {
+                    failure_cause = msg->failure_cause;
+                }
+            } catch (ExecutionException &e) {
+                if (not failure_cause) {
+                    failure_cause = e.getCause();
+                }
+            }
+            S4U_Mailbox::retireTemporaryMailbox(mailboxes.at(i));
+        }
+
+        // A partially deleted file is lost (a file that is not striped is its own single "stripe")
+        if (some_stripe_was_deleted) {
+            if ((this->stripe_locations.size() == 1) and (this->stripe_locations.at(0)->getFile() == this->location->getFile())) {
+                this->parent->forgetFile(this->location->getFile());
+            } else {
+                this->parent->forgetStripedFile(this->location->getFile());
+            }
+        }
+
+        try {
+            S4U_Mailbox::dputMessage(
+                    this->answer_mailbox,
+                    new StorageServiceFileDeleteAnswerMessage(
+                            this->location->getFile(),
+                            this->parent,
+                            failure_cause == nullptr,
+                            failure_cause,
+                            this->parent->getMessagePayloadValue(
+                                    CompoundStorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+        } catch (ExecutionException &ignore) {
+        }
+    }
+
+}// namespace wrench
@@ -6,6 +6,9 @@
 * the Free Software Foundation, either version 3 of the License, or
 * (at your option) any later version.
 */
+#include <algorithm>
+#include <climits>
+
 #include "wrench/services/storage/proxy/StorageServiceProxy.h"
 #include "wrench/logging/TerminalOutput.h"
 #include "wrench/simgrid_S4U_util/S4U_Simulation.h"
@@ -16,9 +19,12 @@
 #include "wrench/services/storage/StorageServiceMessagePayload.h"
 #include "wrench/failure_causes/FileNotFound.h"
 #include "wrench/failure_causes/HostError.h"
+#include "wrench/failure_causes/NetworkError.h"
+#include "wrench/failure_causes/ServiceIsDown.h"
 #include "wrench/services/storage/StorageServiceProperty.h"
 #include "wrench/services/storage/proxy/StorageServiceProxyProperty.h"
-#include "wrench/services/storage/proxy/StorageServiceProxyProperty.h"
+#include "wrench/services/storage/proxy/StorageServiceProxyMessage.h"
+#include "wrench/workflow/WorkflowTask.h"
 
 WRENCH_LOG_CATEGORY(wrench_core_proxy_file_server,
                     "Log category for ProxyFileServers");
@@ -92,9 +98,21 @@ namespace wrench {
 
 
         S4U_Simulation::compute(this->getPropertyValueAsDouble(StorageServiceProxyProperty::MESSAGE_OVERHEAD));
+
+        // Start the flushes that are due, and wake up when the next one is
+        startPendingFlushes();
+        double timeout = -1;
+        if ((not this->flush_queue.empty()) and (this->num_ongoing_flushes < this->max_num_concurrent_flushes)) {
+            timeout = this->flush_queue.begin()->first.first - S4U_Simulation::getClock();
+        }
+
         try {
-            message = S4U_Mailbox::getMessage(this->mailbox);
+            message = S4U_Mailbox::getMessage(this->mailbox, timeout);
         } catch (ExecutionException &e) {
+            auto cause = std::dynamic_pointer_cast<NetworkError>(e.getCause());
+            if (cause and cause->isTimeout()) {
+                return true;
+            }
             WRENCH_INFO(
                     "Got a network error while getting some message... ignoring");
             return true;// oh well
@@ -103,6 +121,7 @@ namespace wrench {
         WRENCH_DEBUG("Got a [%s] message", message->getName().c_str());
 
         if (auto msg = dynamic_cast<ServiceStopDaemonMessage *>(message.get())) {//handle all the rest of the messages
+            failPendingSyncsAndDeletions();
             try {
                 S4U_Mailbox::dputMessage(msg->ack_mailbox,
                                          new ServiceDaemonStoppedMessage(this->getMessagePayloadValue(
@@ -135,6 +154,90 @@ namespace wrench {
             } else {
                 S4U_Mailbox::putMessage(msg->answer_mailbox, new StorageServiceFileLookupAnswerMessage(msg->location->getFile(), false, StorageServiceMessagePayload::FILE_LOOKUP_ANSWER_MESSAGE_PAYLOAD));
             }
+        } else if (auto msg = dynamic_cast<StorageServiceBulkFileLookupRequestMessage *>(message.get())) {
+            // Cached files are looked up in the cache, others at their targets, with one request per storage service
+            bool messages_needed = false;
+            std::vector<std::vector<std::shared_ptr<FileLocation>>> sub_locations;
+            for (auto const &location: msg->locations) {
+                auto target = remote;
+                if (auto proxy_location = std::dynamic_pointer_cast<ProxyLocation>(location)) {
+                    target = proxy_location->target;
+                }
+                sub_locations.emplace_back();
+                if (cache and cache->hasFile(location->getFile(), location->getFullAbsolutePath())) {
+                    sub_locations.back().push_back(FileLocation::LOCATION(cache, location->getFile()));
+                } else if (target) {
+                    sub_locations.back().push_back(FileLocation::LOCATION(target, location->getMountPoint(), location->getFile()));
+                    messages_needed = true;
+                }
+            }
+            if (messages_needed) {
+                startBulkFileOperation(BulkFileOperationThread::LOOKUP, msg->locations, sub_locations, msg->answer_mailbox);
+            } else {
+                std::vector<bool> files_are_available;
+                for (auto const &sub: sub_locations) {
+                    files_are_available.push_back(not sub.empty());
+                }
+                S4U_Mailbox::putMessage(msg->answer_mailbox,
+                                        new StorageServiceBulkFileLookupAnswerMessage(
+                                                files_are_available,
+                                                (double) msg->locations.size() * getMessagePayloadValue(StorageServiceMessagePayload::FILE_LOOKUP_ANSWER_MESSAGE_PAYLOAD)));
+            }
+        } else if (auto msg = dynamic_cast<StorageServiceBulkFileDeleteRequestMessage *>(message.get())) {
+            // Files are deleted from the cache and from their targets, and a deletion succeeds if either does
+            std::vector<std::shared_ptr<DataFile>> files;
+            for (auto const &location: msg->locations) {
+                files.push_back(location->getFile());
+            }
+            if (deferDeletionDuringFlushes(files, message)) {
+                return true;
+            }
+            std::vector<std::vector<std::shared_ptr<FileLocation>>> sub_locations;
+            for (auto const &location: msg->locations) {
+                auto target = remote;
+                if (auto proxy_location = std::dynamic_pointer_cast<ProxyLocation>(location)) {
+                    target = proxy_location->target;
+                }
+                sub_locations.emplace_back();
+                forgetDirtyFile(location->getFile());
+                if (cache) {
+                    sub_locations.back().push_back(FileLocation::LOCATION(cache, location->getFile()));
+                }
+                if (target) {
+                    sub_locations.back().push_back(FileLocation::LOCATION(target, location->getFile()));
+                }
+            }
+            startBulkFileOperation(BulkFileOperationThread::DELETE, msg->locations, sub_locations, msg->answer_mailbox);
+        } else if (auto msg = dynamic_cast<StorageServiceFreeSpaceRequestMessage *>(message.get())) {
+            if (remote) {// The remote answers the client directly
+                S4U_Mailbox::putMessage(remote->mailbox,
+                                        new StorageServiceFreeSpaceRequestMessage(
+                                                msg->answer_mailbox,
+                                                remote->getMessagePayloadValue(StorageServiceMessagePayload::FREE_SPACE_REQUEST_MESSAGE_PAYLOAD)));
+            } else {
+                S4U_Mailbox::putMessage(msg->answer_mailbox,
+                                        new StorageServiceFreeSpaceAnswerMessage(
+                                                {},
+                                                getMessagePayloadValue(StorageServiceMessagePayload::FREE_SPACE_ANSWER_MESSAGE_PAYLOAD)));
+            }
+        } else if (auto msg = dynamic_cast<StorageServiceProxyPrefetchRequestMessage *>(message.get())) {
+            for (auto const &location: msg->locations) {
+                auto file = location->getFile();
+                if ((this->queued_prefetches.find(file) == this->queued_prefetches.end()) and
+                    (this->ongoing_prefetches.find(file) == this->ongoing_prefetches.end())) {
+                    this->prefetch_queue.push_back(location);
+                    this->queued_prefetches.insert(file);
+                }
+            }
+            startPendingPrefetches();
+        } else if (processPrefetchCopyAnswer(message)) {
+            //no other handling required
+        } else if (auto msg = dynamic_cast<StorageServiceFreeSpaceAnswerMessage *>(message.get())) {
+            processCacheFreeSpaceAnswer(msg);
+        } else if (processFlushCopyAnswer(message)) {
+            //no other handling required
+        } else if (auto msg = dynamic_cast<StorageServiceProxySyncRequestMessage *>(message.get())) {
+            processSyncRequest(msg->answer_mailbox);
         } else if ((this->*readMethod)(message)) {
             //no other handling required
         } else if (auto msg = dynamic_cast<StorageServiceFileDeleteRequestMessage *>(message.get())) {
@@ -142,7 +245,11 @@ namespace wrench {
             if (auto location = std::dynamic_pointer_cast<ProxyLocation>(msg->location)) {
                 target = location->target;
             }
+            if (deferDeletionDuringFlushes({msg->location->getFile()}, message)) {
+                return true;
+            }
             bool deleted = false;
+            forgetDirtyFile(msg->location->getFile());
             if (cache) {
                 try {
                     cache->deleteFile(msg->location->getFile());
@@ -247,9 +354,14 @@ namespace wrench {
                     if (auto location = std::dynamic_pointer_cast<ProxyLocation>(tmpMsg->location)) {
                         target = location->target;
                     }
-                    //WRENCH_INFO("initiating file copy");
-                    // Initiate File Copy but not wanting to receive an answer, hence the NULL_MAILBOX
-                    initiateFileCopy(S4U_Mailbox::NULL_MAILBOX, FileLocation::LOCATION(cache, msg->location->getFile()), FileLocation::LOCATION(target, msg->location->getFile()));
+                    if (this->write_back) {
+                        // The file will be flushed later on
+                        markFileDirty(msg->location->getFile(), target);
+                    } else {
+                        //WRENCH_INFO("initiating file copy");
+                        // Initiate File Copy but not wanting to receive an answer, hence the NULL_MAILBOX
+                        initiateFileCopy(S4U_Mailbox::NULL_MAILBOX, FileLocation::LOCATION(cache, msg->location->getFile()), FileLocation::LOCATION(target, msg->location->getFile()));
+                    }
 
                     std::swap(messages[i], messages.back());
                     messages.pop_back();
@@ -262,6 +374,440 @@ namespace wrench {
         }
         return true;
     }
+    /**
+     * @brief Start a helper that performs a bulk lookup/delete at the cache and/or the targets, and sends
+     *        a single answer back to the client
+     * @param operation: the operation (lookup or delete)
+     * @param locations: the file locations (at the proxy)
+     * @param sub_locations: for each file, the locations at which the operation is performed
+     * @param answer_mailbox: the client's answer mailbox
+     */
+    void StorageServiceProxy::startBulkFileOperation(BulkFileOperationThread::Operation operation,
+                                                     const std::vector<std::shared_ptr<FileLocation>> &locations,
+                                                     const std::vector<std::vector<std::shared_ptr<FileLocation>>> &sub_locations,
+                                                     simgrid::s4u::Mailbox *answer_mailbox) {
+        auto thread = std::make_shared<BulkFileOperationThread>(
+                this->getHostname(),
+                this->getSharedPtr<StorageServiceProxy>(),
+                operation,
+                locations,
+                sub_locations,
+                false,// A file is deleted if it is deleted from the cache or the target
+                answer_mailbox);
+        thread->setSimulation(this->simulation);
+        thread->start(thread, true, false);// Daemonize, non-auto-restart
+    }
+
+    /**
+     * @brief Start as many queued prefetches as allowed, in order, without exceeding the space
+     *        available in the cache (or, for a cache with a caching behavior, its capacity). A
+     *        file that does not fit waits for ongoing prefetches to complete, and is dropped if
+     *        there are none. The cache's free space is not asked for synchronously: if it is not
+     *        known, a request is sent to the cache and prefetches start once the answer arrives.
+     */
+    void StorageServiceProxy::startPendingPrefetches() {
+        if (this->prefetch_queue.empty() or (this->ongoing_prefetches.size() >= this->max_num_concurrent_prefetches)) {
+            return;
+        }
+
+        double available_space = -this->ongoing_prefetch_bytes;
+        if (this->cache_evicts_files) {
+            available_space += this->cache_capacity;
+        } else if (this->cache_free_space >= 0) {
+            available_space += this->cache_free_space;
+            // The cache's free space changes as files are prefetched, read, written, or deleted
+            this->cache_free_space = -1;
+        } else {
+            if (not this->cache_free_space_request_pending) {
+                try {
+                    S4U_Mailbox::dputMessage(this->cache->mailbox,
+                                             new StorageServiceFreeSpaceRequestMessage(
+                                                     this->mailbox,
+                                                     this->cache->getMessagePayloadValue(
+                                                             StorageServiceMessagePayload::FREE_SPACE_REQUEST_MESSAGE_PAYLOAD)));
+                    this->cache_free_space_request_pending = true;
+                } catch (ExecutionException &e) {
+                    WRENCH_INFO("Could not ask the cache for its free space: %s", e.getCause()->toString().c_str());
+                }
+            }
+            return;
+        }
+
+        while ((not this->prefetch_queue.empty()) and (this->ongoing_prefetches.size() < this->max_num_concurrent_prefetches)) {
+            auto src = this->prefetch_queue.front();
+            auto file = src->getFile();
+            this->prefetch_queue.pop_front();
+            this->queued_prefetches.erase(file);
+
+            // Already cached, or already being brought into the cache by a read or a write
+            if (this->cache->hasFile(file)) {
+                continue;
+            }
+            auto it = this->pending.find(file);
+            if ((it != this->pending.end()) and (not it->second.empty())) {
+                continue;
+            }
+
+            if (file->getSize() > available_space) {
+                if (not this->ongoing_prefetches.empty()) {
+                    this->prefetch_queue.push_front(src);
+                    this->queued_prefetches.insert(file);
+                    break;
+                }
+                WRENCH_INFO("Not prefetching file %s (not enough space in the cache)", file->getID().c_str());
+                continue;
+            }
+
+            WRENCH_INFO("Prefetching file %s from %s", file->getID().c_str(), src->getStorageService()->getName().c_str());
+            try {
+                StorageService::initiateFileCopy(this->mailbox, src, FileLocation::LOCATION(this->cache, file));
+            } catch (ExecutionException &e) {
+                WRENCH_INFO("Could not start prefetching file %s: %s", file->getID().c_str(), e.getCause()->toString().c_str());
+                continue;
+            }
+            available_space -= file->getSize();
+            this->ongoing_prefetches.insert(file);
+            this->ongoing_prefetch_bytes += file->getSize();
+        }
+    }
+
+    /**
+     * @brief Process the answer to a free space request sent to the cache, and start queued prefetches
+     * @param msg: the message
+     */
+    void StorageServiceProxy::processCacheFreeSpaceAnswer(StorageServiceFreeSpaceAnswerMessage *msg) {
+        this->cache_free_space_request_pending = false;
+        this->cache_free_space = 0;
+        for (auto const &mp: msg->free_space) {
+            this->cache_free_space += mp.second;
+        }
+        startPendingPrefetches();
+    }
+
+    /**
+     * @brief Process the answer to a prefetch copy, if the message is one: reads that were waiting
+     *        for the prefetch are served from the cache (or fail if the prefetch failed), and
+     *        queued prefetches are started
+     * @param message: the message that is being processed
+     * @return true if the message was processed by this function, false otherwise
+     */
+    bool StorageServiceProxy::processPrefetchCopyAnswer(unique_ptr<SimulationMessage> &message) {
+        auto msg = dynamic_cast<StorageServiceFileCopyAnswerMessage *>(message.get());
+        if ((not msg) or (msg->dst->getStorageService() != this->cache)) {
+            return false;
+        }
+        auto file = msg->dst->getFile();
+        if (this->ongoing_prefetches.find(file) == this->ongoing_prefetches.end()) {
+            return false;
+        }
+        this->ongoing_prefetches.erase(file);
+        this->ongoing_prefetch_bytes -= file->getSize();
+        if (msg->success) {
+            WRENCH_INFO("Prefetched file %s", file->getID().c_str());
+        } else {
+            WRENCH_INFO("Failed to prefetch file %s: %s", file->getID().c_str(), msg->failure_cause->toString().c_str());
+        }
+
+        std::vector<unique_ptr<SimulationMessage>> &messages = pending[file];
+        for (unsigned int i = 0; i < messages.size(); i++) {
+            if (auto tmpMsg = dynamic_cast<StorageServiceFileReadRequestMessage *>(messages[i].get())) {
+                if (msg->success) {
+                    tmpMsg->payload = 0;                     //this message has already been sent, this is a fake resend
+                    S4U_Mailbox::putMessage(mailbox, tmpMsg);//now that the data is cached, resend the message
+                    std::swap(messages[i], messages.back());
+                    messages.back().release();
+                    messages.pop_back();
+                    i--;
+                } else {
+                    S4U_Mailbox::putMessage(tmpMsg->answer_mailbox, new StorageServiceFileReadAnswerMessage(tmpMsg->location, false, msg->failure_cause, nullptr, 0, StorageServiceMessagePayload::FILE_READ_ANSWER_MESSAGE_PAYLOAD));
+                    std::swap(messages[i], messages.back());
+                    messages.pop_back();
+                    i--;
+                }
+            }
+        }
+
+        startPendingPrefetches();
+        return true;
+    }
+
+    /**
+     * @brief Record that a file was written to the cache (in write-back mode): the file is pinned in
+     *        the cache and queued for flushing, unless it was already dirty
+     * @param file: the file
+     * @param target: the remote storage service to which the file should be flushed
+     */
+    void StorageServiceProxy::markFileDirty(const std::shared_ptr<DataFile> &file, const std::shared_ptr<StorageService> &target) {
+        auto it = this->dirty_files.find(file);
+        if (it != this->dirty_files.end()) {
+            // Already dirty: the file is flushed (again) at the date set by its first write
+            it->second.target = target;
+            if (it->second.being_flushed) {
+                it->second.rewritten = true;
+            }
+            return;
+        }
+        WRENCH_INFO("File %s is dirty", file->getID().c_str());
+        this->pinFileInCache(file, true);
+        this->dirty_files[file].target = target;
+        this->queueFlush(file, S4U_Simulation::getClock() + this->write_back_flush_delay);
+    }
+
+    /**
+     * @brief Forget about a dirty file that is being deleted (deletions of files that are being
+     *        flushed are deferred until the flush completes, see deferDeletionDuringFlushes())
+     * @param file: the file
+     */
+    void StorageServiceProxy::forgetDirtyFile(const std::shared_ptr<DataFile> &file) {
+        auto it = this->dirty_files.find(file);
+        if ((it == this->dirty_files.end()) or it->second.being_flushed) {
+            return;
+        }
+        this->flush_queue.erase(it->second.queue_key);
+        this->pinFileInCache(file, false);
+        this->dirty_files.erase(it);
+        this->removeFileFromPendingSyncs(file, nullptr);
+    }
+
+    /**
+     * @brief Defer a deletion request if some of the files it deletes are being flushed, so that an
+     *        ongoing flush cannot recreate a file at its remote storage service after the file was deleted
+     *        there. The request is processed again once all these flushes have completed.
+     * @param files: the files that the request deletes
+     * @param message: the request (moved out if the request is deferred)
+     * @return true if the request was deferred, false otherwise
+     */
+    bool StorageServiceProxy::deferDeletionDuringFlushes(const std::vector<std::shared_ptr<DataFile>> &files,
+                                                          unique_ptr<SimulationMessage> &message) {
+        bool defer = false;
+        for (auto const &file: files) {
+            auto it = this->dirty_files.find(file);
+            if ((it != this->dirty_files.end()) and it->second.being_flushed) {
+                // The file is deleted anyway, so there is no point in flushing it again
+                it->second.rewritten = false;
+                defer = true;
+            }
+        }
+        if (defer) {
+            WRENCH_INFO("Deferring a deletion until ongoing flushes complete");
+            this->deferred_deletions.push_back(DeferredDeletion{files, std::move(message)});
+        }
+        return defer;
+    }
+
+    /**
+     * @brief Process again (in arrival order) the deferred deletion requests whose files are no longer being flushed
+     */
+    void StorageServiceProxy::resumeDeferredDeletions() {
+        for (auto it = this->deferred_deletions.begin(); it != this->deferred_deletions.end();) {
+            bool still_flushing = std::any_of(it->files.begin(), it->files.end(), [this](const std::shared_ptr<DataFile> &file) {
+                auto dirty_file = this->dirty_files.find(file);
+                return (dirty_file != this->dirty_files.end()) and dirty_file->second.being_flushed;
+            });
+            if (still_flushing) {
+                ++it;
+                continue;
+            }
+            it->message->payload = 0;//this message has already been sent, this is a fake resend
+            S4U_Mailbox::dputMessage(this->mailbox, it->message.release());
+            it = this->deferred_deletions.erase(it);
+        }
+    }
+
+    /**
+     * @brief Answer all pending syncs and deferred deletion requests with a failure, because the proxy is stopping
+     */
+    void StorageServiceProxy::failPendingSyncsAndDeletions() {
+        auto failure_cause = std::make_shared<ServiceIsDown>(this->getSharedPtr<Service>());
+        for (auto const &sync: this->pending_syncs) {
+            try {
+                S4U_Mailbox::dputMessage(sync.answer_mailbox,
+                                         new StorageServiceProxySyncAnswerMessage(
+                                                 failure_cause,
+                                                 this->getMessagePayloadValue(StorageServiceProxyMessagePayload::SYNC_ANSWER_MESSAGE_PAYLOAD)));
+            } catch (ExecutionException &ignore) {
+            }
+        }
+        this->pending_syncs.clear();
+
+        for (auto const &deferred_deletion: this->deferred_deletions) {
+            try {
+                if (auto msg = dynamic_cast<StorageServiceFileDeleteRequestMessage *>(deferred_deletion.message.get())) {
+                    S4U_Mailbox::dputMessage(msg->answer_mailbox,
+                                             new StorageServiceFileDeleteAnswerMessage(
+                                                     msg->location->getFile(),
+                                                     this->getSharedPtr<StorageService>(),
+                                                     false,
+                                                     failure_cause,
+                                                     this->getMessagePayloadValue(StorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+                } else if (auto msg = dynamic_cast<StorageServiceBulkFileDeleteRequestMessage *>(deferred_deletion.message.get())) {
+                    S4U_Mailbox::dputMessage(msg->answer_mailbox,
+                                             new StorageServiceBulkFileDeleteAnswerMessage(
+                                                     std::vector<std::shared_ptr<FailureCause>>(msg->locations.size(), failure_cause),
+                                                     (double) msg->locations.size() * this->getMessagePayloadValue(StorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+                }
+            } catch (ExecutionException &ignore) {
+            }
+        }
+        this->deferred_deletions.clear();
+    }
+
+    /**
+     * @brief Add a dirty file to the flush queue
+     * @param file: the file
+     * @param date: the date at which the file should be flushed
+     */
+    void StorageServiceProxy::queueFlush(const std::shared_ptr<DataFile> &file, double date) {
+        auto key = std::make_pair(date, this->flush_sequence_number++);
+        this->dirty_files[file].queue_key = key;
+        this->flush_queue[key] = file;
+    }
+
+    /**
+     * @brief Start flushing the dirty files whose flush date has come, in order, up to the maximum number of concurrent flushes
+     */
+    void StorageServiceProxy::startPendingFlushes() {
+        double now = S4U_Simulation::getClock();
+        while ((not this->flush_queue.empty()) and
+               (this->num_ongoing_flushes < this->max_num_concurrent_flushes) and
+               (this->flush_queue.begin()->first.first <= now)) {
+            auto file = this->flush_queue.begin()->second;
+            this->flush_queue.erase(this->flush_queue.begin());
+            auto &dirty_file = this->dirty_files[file];
+            dirty_file.being_flushed = true;
+            dirty_file.rewritten = false;
+            WRENCH_INFO("Flushing file %s to %s", file->getID().c_str(), dirty_file.target->getName().c_str());
+            try {
+                StorageService::initiateFileCopy(this->mailbox, FileLocation::LOCATION(this->cache, file), FileLocation::LOCATION(dirty_file.target, file));
+                this->num_ongoing_flushes++;
+            } catch (ExecutionException &e) {
+                this->fileFlushed(file, e.getCause());
+            }
+        }
+    }
+
+    /**
+     * @brief Process the end of the flush of a file: the file is clean unless it was written again during
+     *        the flush (in which case it is queued again), and syncs that were waiting for it are updated
+     * @param file: the file
+     * @param failure_cause: the cause of the failure of the flush, or nullptr if it succeeded
+     */
+    void StorageServiceProxy::fileFlushed(const std::shared_ptr<DataFile> &file, const std::shared_ptr<FailureCause> &failure_cause) {
+        auto &dirty_file = this->dirty_files[file];
+        dirty_file.being_flushed = false;
+
+        if ((failure_cause == nullptr) and dirty_file.rewritten) {
+            // The flushed content is stale, flush again (right away if a sync is waiting for the file)
+            dirty_file.rewritten = false;
+            double date = S4U_Simulation::getClock();
+            if (std::none_of(this->pending_syncs.begin(), this->pending_syncs.end(),
+                             [&file](const PendingSync &sync) { return sync.files.find(file) != sync.files.end(); })) {
+                date += this->write_back_flush_delay;
+            }
+            this->queueFlush(file, date);
+            return;
+        }
+
+        if (failure_cause) {
+            WRENCH_INFO("Failed to flush file %s: %s", file->getID().c_str(), failure_cause->toString().c_str());
+        } else {
+            WRENCH_INFO("Flushed file %s", file->getID().c_str());
+        }
+        this->pinFileInCache(file, false);
+        this->dirty_files.erase(file);
+        this->removeFileFromPendingSyncs(file, failure_cause);
+        this->resumeDeferredDeletions();
+    }
+
+    /**
+     * @brief Process the answer to a flush copy, if the message is one
+     * @param message: the message that is being processed
+     * @return true if the message was processed by this function, false otherwise
+     */
+    bool StorageServiceProxy::processFlushCopyAnswer(unique_ptr<SimulationMessage> &message) {
+        auto msg = dynamic_cast<StorageServiceFileCopyAnswerMessage *>(message.get());
+        if ((not msg) or (msg->src->getStorageService() != this->cache)) {
+            return false;
+        }
+        auto it = this->dirty_files.find(msg->src->getFile());
+        if ((it == this->dirty_files.end()) or (not it->second.being_flushed)) {
+            return false;
+        }
+        this->num_ongoing_flushes--;
+        this->fileFlushed(msg->src->getFile(), msg->success ? nullptr : msg->failure_cause);
+        return true;
+    }
+
+    /**
+     * @brief Process a sync request: all dirty files are due for flushing right away, and the
+     *        answer is sent once they have all been flushed
+     * @param answer_mailbox: the mailbox to which the answer should be sent
+     */
+    void StorageServiceProxy::processSyncRequest(simgrid::s4u::Mailbox *answer_mailbox) {
+        PendingSync sync;
+        sync.answer_mailbox = answer_mailbox;
+        for (auto const &dirty_file: this->dirty_files) {
+            sync.files.insert(dirty_file.first);
+        }
+        if (sync.files.empty()) {
+            S4U_Mailbox::dputMessage(answer_mailbox,
+                                     new StorageServiceProxySyncAnswerMessage(
+                                             nullptr,
+                                             this->getMessagePayloadValue(StorageServiceProxyMessagePayload::SYNC_ANSWER_MESSAGE_PAYLOAD)));
+            return;
+        }
+        this->pending_syncs.push_back(sync);
+
+        // Move the queued files to the head of the queue, preserving their order
+        double now = S4U_Simulation::getClock();
+        std::vector<std::pair<std::pair<double, unsigned long>, std::shared_ptr<DataFile>>> delayed;
+        for (auto it = this->flush_queue.upper_bound(std::make_pair(now, ULONG_MAX)); it != this->flush_queue.end(); ++it) {
+            delayed.emplace_back(*it);
+        }
+        for (auto const &entry: delayed) {
+            this->flush_queue.erase(entry.first);
+            auto key = std::make_pair(now, entry.first.second);
+            this->dirty_files[entry.second].queue_key = key;
+            this->flush_queue[key] = entry.second;
+        }
+    }
+
+    /**
+     * @brief Remove a file from the files that pending syncs wait for, and answer the syncs that are complete
+     * @param file: the file
+     * @param failure_cause: the cause of the failure of the file's flush (nullptr if none)
+     */
+    void StorageServiceProxy::removeFileFromPendingSyncs(const std::shared_ptr<DataFile> &file, const std::shared_ptr<FailureCause> &failure_cause) {
+        for (auto it = this->pending_syncs.begin(); it != this->pending_syncs.end();) {
+            if (it->files.erase(file) and failure_cause and (it->failure_cause == nullptr)) {
+                it->failure_cause = failure_cause;
+            }
+            if (it->files.empty()) {
+                S4U_Mailbox::dputMessage(it->answer_mailbox,
+                                         new StorageServiceProxySyncAnswerMessage(
+                                                 it->failure_cause,
+                                                 this->getMessagePayloadValue(StorageServiceProxyMessagePayload::SYNC_ANSWER_MESSAGE_PAYLOAD)));
+                it = this->pending_syncs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    /**
+     * @brief Pin (or unpin) a file in the cache, so that it cannot be evicted
+     * @param file: the file
+     * @param pin: true to pin, false to unpin
+     */
+    void StorageServiceProxy::pinFileInCache(const std::shared_ptr<DataFile> &file, bool pin) {
+        auto location = FileLocation::LOCATION(this->cache, file);
+        if (pin) {
+            this->cache->pinFile(location);
+        } else {
+            this->cache->unpinFile(location);
+        }
+    }
+
     /**
      * @brief Synchronously asks the remote storage service for its capacity at all its
      *        mount points.  invalid if there is no default location
@@ -429,6 +975,25 @@ If you want it to start cached, you should also call StorageServiceProxy.getCach
         } else {
             throw invalid_argument("Unknown value " + readProperty + " for StorageServiceProxyProperty::UNCACHED_READ_METHOD");
         }
+
+        this->max_num_concurrent_prefetches = this->getPropertyValueAsUnsignedLong(StorageServiceProxyProperty::PREFETCH_MAX_NUM_CONCURRENT_COPIES);
+        try {
+            this->cache_evicts_files = (cache->getPropertyValueAsString(StorageServiceProperty::CACHING_BEHAVIOR) != "NONE");
+        } catch (std::invalid_argument &ignore) {
+        }
+        for (auto const &mp: cache->getTotalSpace()) {
+            this->cache_capacity += mp.second;
+        }
+
+        this->write_back = this->getPropertyValueAsBoolean(StorageServiceProxyProperty::WRITE_BACK);
+        this->write_back_flush_delay = this->getPropertyValueAsTimeInSecond(StorageServiceProxyProperty::WRITE_BACK_FLUSH_DELAY);
+        this->max_num_concurrent_flushes = this->getPropertyValueAsUnsignedLong(StorageServiceProxyProperty::WRITE_BACK_MAX_NUM_CONCURRENT_FLUSHES);
+        if (this->write_back_flush_delay < 0) {
+            throw std::invalid_argument("StorageServiceProxy::StorageServiceProxy(): Invalid WRITE_BACK_FLUSH_DELAY property value");
+        }
+        if (this->max_num_concurrent_flushes == 0) {
+            throw std::invalid_argument("StorageServiceProxy::StorageServiceProxy(): Invalid WRITE_BACK_MAX_NUM_CONCURRENT_FLUSHES property value");
+        }
     }
     /**
      * @brief Delete a file
@@ -527,6 +1092,108 @@ If you want it to start cached, you should also call StorageServiceProxy.getCach
         return this->cache;
     }
 
+    /**
+     * @brief Give the proxy hints about files that will be read soon, so that it copies them into
+     *        its cache in the background (this method returns immediately). Files are prefetched in the
+     *        order of the hints, with at most StorageServiceProxyProperty::PREFETCH_MAX_NUM_CONCURRENT_COPIES
+     *        concurrent copies. Hints are ignored if that property is 0.
+     * @param locations: the file locations, which can be ProxyLocations, locations at remote storage
+     *                   services, or locations at the proxy (in which case files are prefetched from the
+     *                   default remote storage service)
+     *
+     * @throw std::invalid_argument
+     */
+    void StorageServiceProxy::prefetchFiles(const std::vector<std::shared_ptr<FileLocation>> &locations) {
+        if ((this->max_num_concurrent_prefetches == 0) or locations.empty()) {
+            return;
+        }
+
+        std::vector<std::shared_ptr<FileLocation>> sources;
+        for (auto const &location: locations) {
+            if (location == nullptr) {
+                throw std::invalid_argument("StorageServiceProxy::prefetchFiles(): Invalid nullptr location");
+            }
+            auto target = this->remote;
+            if (auto proxy_location = std::dynamic_pointer_cast<ProxyLocation>(location)) {
+                target = proxy_location->target;
+            } else if (location->getStorageService().get() != this) {
+                target = location->getStorageService();
+            }
+            if (target == nullptr) {
+                throw std::invalid_argument("StorageServiceProxy::prefetchFiles(): No remote storage service to prefetch file " +
+                                            location->getFile()->getID() + " from");
+            }
+            sources.push_back(FileLocation::LOCATION(target, location->getFile()));
+        }
+
+        this->assertServiceIsUp();
+        S4U_Mailbox::dputMessage(this->mailbox,
+                                 new StorageServiceProxyPrefetchRequestMessage(
+                                         sources,
+                                         this->getMessagePayloadValue(StorageServiceProxyMessagePayload::PREFETCH_REQUEST_MESSAGE_PAYLOAD)));
+    }
+
+    /**
+     * @brief Synchronously wait until all files that are dirty (in write-back mode) at the time of the
+     *        call have been flushed to their remote storage services, which establishes a durability point.
+     *        Files are flushed right away, regardless of StorageServiceProxyProperty::WRITE_BACK_FLUSH_DELAY.
+     *        The call fails if a flush fails or if the proxy is stopped in the meantime. Like a file copy,
+     *        it waits with no timeout, since flushes can take arbitrarily long.
+     *
+     * @throw ExecutionException
+     */
+    void StorageServiceProxy::sync() {
+        this->assertServiceIsUp();
+
+        auto answer_mailbox = S4U_Daemon::getRunningActorRecvMailbox();
+        S4U_Mailbox::putMessage(this->mailbox,
+                                new StorageServiceProxySyncRequestMessage(
+                                        answer_mailbox,
+                                        this->getMessagePayloadValue(StorageServiceProxyMessagePayload::SYNC_REQUEST_MESSAGE_PAYLOAD)));
+
+        auto message = S4U_Mailbox::getMessage(answer_mailbox);
+        if (auto msg = dynamic_cast<StorageServiceProxySyncAnswerMessage *>(message.get())) {
+            if (msg->failure_cause) {
+                throw ExecutionException(msg->failure_cause);
+            }
+        } else {
+            throw std::runtime_error("StorageServiceProxy::sync(): Unexpected [" + message->getName() + "] message");
+        }
+    }
+
+    /**
+     * @brief Determine whether a file is dirty, i.e., written to the cache (in write-back mode) but not
+     *        yet flushed to its remote storage service (in zero simulated time)
+     * @param file: the file
+     * @return true if the file is dirty
+     */
+    bool StorageServiceProxy::isFileDirty(const std::shared_ptr<DataFile> &file) {
+        return this->dirty_files.find(file) != this->dirty_files.end();
+    }
+
+    /**
+     * @brief Give the proxy hints about the input files of tasks that will run soon (e.g., the
+     *        workflow's ready tasks), so that it copies them into its cache in the background
+     * @param tasks: the tasks
+     * @param targetServer: the remote storage service that holds the files (nullptr means the default remote)
+     *
+     * @throw std::invalid_argument
+     */
+    void StorageServiceProxy::prefetchInputFiles(const std::vector<std::shared_ptr<WorkflowTask>> &tasks,
+                                                 const std::shared_ptr<StorageService> &targetServer) {
+        auto target = (targetServer ? targetServer : this->remote);
+        if (target == nullptr) {
+            throw std::invalid_argument("StorageServiceProxy::prefetchInputFiles(): No remote storage service to prefetch files from");
+        }
+        std::vector<std::shared_ptr<FileLocation>> locations;
+        for (auto const &task: tasks) {
+            for (auto const &file: task->getInputFiles()) {
+                locations.push_back(ProxyLocation::LOCATION(target, this->getSharedPtr<StorageService>(), file));
+            }
+        }
+        this->prefetchFiles(locations);
+    }
+
     /**
      * @brief Check the cache and ongoing reads for the requested file.  If it is, this function handles the rest of reading it.
      * @param msg the message that is being processed
@@ -547,6 +1214,11 @@ If you want it to start cached, you should also call StorageServiceProxy.getCach
             return true;
 
         } else {
+            if (this->ongoing_prefetches.find(msg->location->getFile()) != this->ongoing_prefetches.end()) {
+                //the file is being prefetched, the read proceeds once it is cached
+                pending[msg->location->getFile()].push_back(std::move(message));
+                return true;
+            }
             std::vector<unique_ptr<SimulationMessage>> &messages = pending[msg->location->getFile()];
             for (unsigned int i = 0; i < messages.size(); i++) {
                 if (auto tmpMsg = dynamic_cast<StorageServiceFileWriteRequestMessage *>(messages[i].get())) {
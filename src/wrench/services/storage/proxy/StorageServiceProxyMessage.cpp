@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdexcept>
+#include <utility>
+
+#include "wrench/services/storage/proxy/StorageServiceProxyMessage.h"
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param payload: the message size in bytes
+     */
+    StorageServiceProxyMessage::StorageServiceProxyMessage(double payload) : StorageServiceMessage(payload) {
+    }
+
+    /**
+     * @brief Constructor
+     * @param locations: the locations (at the remote storage services) of the files to prefetch
+     * @param payload: the message size in bytes
+     */
+    StorageServiceProxyPrefetchRequestMessage::StorageServiceProxyPrefetchRequestMessage(std::vector<std::shared_ptr<FileLocation>> locations,
+                                                                                         double payload)
+        : StorageServiceProxyMessage(payload), locations(std::move(locations)) {
+    }
+
+    /**
+     * @brief Constructor
+     * @param answer_mailbox: the mailbox to which to send the answer
+     * @param payload: the message size in bytes
+     *
+     * @throw std::invalid_argument
+     */
+    StorageServiceProxySyncRequestMessage::StorageServiceProxySyncRequestMessage(simgrid::s4u::Mailbox *answer_mailbox, double payload)
+        : StorageServiceProxyMessage(payload), answer_mailbox(answer_mailbox) {
+        if (answer_mailbox == nullptr) {
+            throw std::invalid_argument("StorageServiceProxySyncRequestMessage::StorageServiceProxySyncRequestMessage(): Invalid arguments");
+        }
+    }
+
+    /**
+     * @brief Constructor
+     * @param failure_cause: the cause of the failure of a flush (nullptr if all flushes succeeded)
+     * @param payload: the message size in bytes
+     */
+    StorageServiceProxySyncAnswerMessage::StorageServiceProxySyncAnswerMessage(std::shared_ptr<FailureCause> failure_cause, double payload)
+        : StorageServiceProxyMessage(payload), failure_cause(std::move(failure_cause)) {
+    }
+
+}// namespace wrench
@@ -0,0 +1,18 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/storage/proxy/StorageServiceProxyMessagePayload.h>
+
+namespace wrench {
+
+    SET_MESSAGEPAYLOAD_NAME(StorageServiceProxyMessagePayload, PREFETCH_REQUEST_MESSAGE_PAYLOAD);
+    SET_MESSAGEPAYLOAD_NAME(StorageServiceProxyMessagePayload, SYNC_REQUEST_MESSAGE_PAYLOAD);
+    SET_MESSAGEPAYLOAD_NAME(StorageServiceProxyMessagePayload, SYNC_ANSWER_MESSAGE_PAYLOAD);
+
+};
@@ -12,4 +12,8 @@ namespace wrench {
 
     SET_PROPERTY_NAME(StorageServiceProxyProperty, MESSAGE_OVERHEAD);
     SET_PROPERTY_NAME(StorageServiceProxyProperty, UNCACHED_READ_METHOD);
+    SET_PROPERTY_NAME(StorageServiceProxyProperty, PREFETCH_MAX_NUM_CONCURRENT_COPIES);
+    SET_PROPERTY_NAME(StorageServiceProxyProperty, WRITE_BACK);
+    SET_PROPERTY_NAME(StorageServiceProxyProperty, WRITE_BACK_FLUSH_DELAY);
+    SET_PROPERTY_NAME(StorageServiceProxyProperty, WRITE_BACK_MAX_NUM_CONCURRENT_FLUSHES);
 };// namespace wrench
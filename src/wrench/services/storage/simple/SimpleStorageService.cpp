@@ -111,7 +111,8 @@ namespace wrench {
         try {
             for (const auto &mp: mount_points) {
                 this->file_systems[mp] = LogicalFileSystem::createLogicalFileSystem(
-                        this->getHostname(), this, mp, this->getPropertyValueAsString(wrench::StorageServiceProperty::CACHING_BEHAVIOR));
+                        this->getHostname(), this, mp, this->getPropertyValueAsString(wrench::StorageServiceProperty::CACHING_BEHAVIOR),
+                        this->getPropertyValueAsTimeInSecond(wrench::StorageServiceProperty::CACHING_TTL));
             }
         } catch (std::invalid_argument &e) {
             throw;
@@ -131,8 +132,28 @@ namespace wrench {
     bool SimpleStorageService::processFileDeleteRequest(
             const std::shared_ptr<FileLocation> &location,
             simgrid::s4u::Mailbox *answer_mailbox) {
-        std::shared_ptr<FailureCause> failure_cause = nullptr;
+        auto file = location->getFile();
+        auto failure_cause = this->removeFileAtLocation(location);
 
+        S4U_Mailbox::dputMessage(
+                answer_mailbox,
+                new StorageServiceFileDeleteAnswerMessage(
+                        file,
+                        this->getSharedPtr<SimpleStorageService>(),
+                        (failure_cause == nullptr),
+                        failure_cause,
+                        this->getMessagePayloadValue(
+                                SimpleStorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+        return true;
+    }
+
+
+    /**
+     * @brief Remove a file from one of the file systems
+     * @param location: the file location
+     * @return the cause of the failure, or nullptr on success
+     */
+    std::shared_ptr<FailureCause> SimpleStorageService::removeFileAtLocation(const std::shared_ptr<FileLocation> &location) {
         auto fs = this->file_systems[location->getMountPoint()].get();
         auto file = location->getFile();
 
@@ -140,26 +161,38 @@ namespace wrench {
             (not fs->isFileInDirectory(file, location->getAbsolutePathAtMountPoint()))) {
             // If this is scratch, we don't care, perhaps it was taken care of elsewhere...
             if (not this->isScratch()) {
-                failure_cause = std::shared_ptr<FailureCause>(
-                        new FileNotFound(location));
+                return std::shared_ptr<FailureCause>(new FileNotFound(location));
             }
         } else {
             fs->removeFileFromDirectory(file, location->getAbsolutePathAtMountPoint());
         }
+        return nullptr;
+    }
+
+    /**
+     * @brief Process a bulk file deletion request
+     * @param locations: the file locations
+     * @param answer_mailbox: the mailbox to which the notification should be sent
+     * @return false if the daemon should terminate
+     */
+    bool SimpleStorageService::processBulkFileDeleteRequest(
+            const std::vector<std::shared_ptr<FileLocation>> &locations,
+            simgrid::s4u::Mailbox *answer_mailbox) {
+        std::vector<std::shared_ptr<FailureCause>> failure_causes;
+        failure_causes.reserve(locations.size());
+        for (auto const &location: locations) {
+            failure_causes.push_back(this->removeFileAtLocation(location));
+        }
 
         S4U_Mailbox::dputMessage(
                 answer_mailbox,
-                new StorageServiceFileDeleteAnswerMessage(
-                        file,
-                        this->getSharedPtr<SimpleStorageService>(),
-                        (failure_cause == nullptr),
-                        failure_cause,
-                        this->getMessagePayloadValue(
-                                SimpleStorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+                new StorageServiceBulkFileDeleteAnswerMessage(
+                        failure_causes,
+                        (double) locations.size() * this->getMessagePayloadValue(
+                                                            SimpleStorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
         return true;
     }
 
-
     /**
      * @brief Process a file lookup request
      * @param location: the file location
@@ -182,6 +215,31 @@ namespace wrench {
         return true;
     }
 
+    /**
+     * @brief Process a bulk file lookup request
+     * @param locations: the file locations
+     * @param answer_mailbox: the mailbox to which the notification should be sent
+     * @return false if the daemon should terminate
+     */
+    bool SimpleStorageService::processBulkFileLookupRequest(
+            const std::vector<std::shared_ptr<FileLocation>> &locations,
+            simgrid::s4u::Mailbox *answer_mailbox) {
+        std::vector<bool> files_are_available;
+        files_are_available.reserve(locations.size());
+        for (auto const &location: locations) {
+            auto fs = this->file_systems[location->getMountPoint()].get();
+            files_are_available.push_back(fs->isFileInDirectory(location->getFile(), location->getAbsolutePathAtMountPoint()));
+        }
+
+        S4U_Mailbox::dputMessage(
+                answer_mailbox,
+                new StorageServiceBulkFileLookupAnswerMessage(
+                        files_are_available,
+                        (double) locations.size() * this->getMessagePayloadValue(
+                                                            SimpleStorageServiceMessagePayload::FILE_LOOKUP_ANSWER_MESSAGE_PAYLOAD)));
+        return true;
+    }
+
     /**
      * @brief Process a free space request
      * @param answer_mailbox: the mailbox to which the notification should be sent
@@ -225,6 +283,7 @@ namespace wrench {
     void SimpleStorageService::validateProperties() {
         this->getPropertyValueAsUnsignedLong(SimpleStorageServiceProperty::MAX_NUM_CONCURRENT_DATA_CONNECTIONS);
         this->getPropertyValueAsSizeInByte(SimpleStorageServiceProperty::BUFFER_SIZE);
+        this->getPropertyValueAsTimeInSecond(SimpleStorageServiceProperty::CACHING_TTL);
     }
 
 
@@ -148,6 +148,12 @@ namespace wrench {
         } else if (auto msg = dynamic_cast<StorageServiceFileLookupRequestMessage *>(message.get())) {
             return processFileLookupRequest(msg->location, msg->answer_mailbox);
 
+        } else if (auto msg = dynamic_cast<StorageServiceBulkFileDeleteRequestMessage *>(message.get())) {
+            return processBulkFileDeleteRequest(msg->locations, msg->answer_mailbox);
+
+        } else if (auto msg = dynamic_cast<StorageServiceBulkFileLookupRequestMessage *>(message.get())) {
+            return processBulkFileLookupRequest(msg->locations, msg->answer_mailbox);
+
         } else if (auto msg = dynamic_cast<StorageServiceFileWriteRequestMessage *>(message.get())) {
             return processFileWriteRequest(msg->location, msg->answer_mailbox, msg->buffer_size);
 
@@ -295,6 +301,7 @@ namespace wrench {
             if (not fs->isFileInDirectory(file, location->getAbsolutePathAtMountPoint())) {
                 WRENCH_INFO(
                         "Received a read request for a file I don't have (%s)", location->toString().c_str());
+                fs->recordCacheMiss();
                 failure_cause = std::shared_ptr<FailureCause>(new FileNotFound(location));
             }
         }
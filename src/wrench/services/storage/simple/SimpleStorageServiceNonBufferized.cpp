@@ -143,6 +143,7 @@ namespace wrench {
         this->stream_to_transactions.clear();
         this->pending_transactions.clear();
         this->running_transactions.clear();
+        this->pending_activities.clear();
 
         for (auto const &fs: this->file_systems) {
             message = "  - mount point " + fs.first + ": " +
@@ -176,9 +177,12 @@ namespace wrench {
         }
 
         /** Main loop **/
+        // The set of activities to wait on is persistent: slot 0 holds the control comm, and slot i > 0 holds the
+        // stream of running_transactions[i-1]. Both are updated incrementally when transactions start/finish.
         bool comm_ptr_has_been_posted = false;
         simgrid::s4u::CommPtr comm_ptr;
         std::unique_ptr<SimulationMessage> simulation_message;
+        this->pending_activities.emplace_back(nullptr);
         while (true) {
 
             S4U_Simulation::computeZeroFlop();
@@ -194,33 +198,30 @@ namespace wrench {
                     continue;
                 }
                 comm_ptr_has_been_posted = true;
-            }
-
-            // Create all activities to wait on
-            std::vector<simgrid::s4u::ActivityPtr> pending_activities;
-            pending_activities.emplace_back(comm_ptr);
-            for (auto const &transaction: this->running_transactions) {
-                pending_activities.emplace_back(transaction->stream);
+                this->pending_activities[0] = comm_ptr;
             }
 
             // Wait one activity to complete
             int finished_activity_index;
             try {
-                finished_activity_index = (int) simgrid::s4u::Activity::wait_any(pending_activities);
+                finished_activity_index = (int) simgrid::s4u::Activity::wait_any(this->pending_activities);
             } catch (simgrid::NetworkFailureException &e) {
                 // the comm failed
                 comm_ptr_has_been_posted = false;
                 continue;// oh well
             } catch (simgrid::Exception &e) {
                 // This likely doesn't happen, but let's keep it here for now
-                for (int i = 1; i < (int) pending_activities.size(); i++) {
-                    if (pending_activities.at(i)->get_state() == simgrid::s4u::Activity::State::FAILED) {
-                        auto finished_transaction = this->running_transactions[i - 1];
-                        this->stream_to_transactions.erase(finished_transaction->stream);
-                        processTransactionFailure(finished_transaction);
-                        continue;
+                std::vector<std::shared_ptr<Transaction>> failed_transactions;
+                for (int i = 1; i < (int) this->pending_activities.size();) {
+                    if (this->pending_activities.at(i)->get_state() == simgrid::s4u::Activity::State::FAILED) {
+                        failed_transactions.push_back(this->removeRunningTransaction(i - 1));
+                    } else {
+                        i++;
                     }
                 }
+                for (auto const &failed_transaction: failed_transactions) {
+                    processTransactionFailure(failed_transaction);
+                }
                 continue;
             } catch (std::exception &e) {
                 continue;
@@ -231,9 +232,7 @@ namespace wrench {
                 comm_ptr_has_been_posted = false;
                 if (not processNextMessage(simulation_message.get())) break;
             } else if (finished_activity_index > 0) {
-                auto finished_transaction = this->running_transactions.at(finished_activity_index - 1);
-                this->running_transactions.erase(this->running_transactions.begin() + finished_activity_index - 1);
-                this->stream_to_transactions.erase(finished_transaction->stream);
+                auto finished_transaction = this->removeRunningTransaction(finished_activity_index - 1);
                 processTransactionCompletion(finished_transaction);
             } else if (finished_activity_index == -1) {
                 throw std::runtime_error("wait_any() returned -1. Not sure what to do with this. ");
@@ -268,6 +267,12 @@ namespace wrench {
         } else if (auto msg = dynamic_cast<StorageServiceFileLookupRequestMessage *>(message)) {
             return processFileLookupRequest(msg->location, msg->answer_mailbox);
 
+        } else if (auto msg = dynamic_cast<StorageServiceBulkFileDeleteRequestMessage *>(message)) {
+            return processBulkFileDeleteRequest(msg->locations, msg->answer_mailbox);
+
+        } else if (auto msg = dynamic_cast<StorageServiceBulkFileLookupRequestMessage *>(message)) {
+            return processBulkFileLookupRequest(msg->locations, msg->answer_mailbox);
+
         } else if (auto msg = dynamic_cast<StorageServiceFileWriteRequestMessage *>(message)) {
             return processFileWriteRequest(msg->location, msg->answer_mailbox,
                                            msg->requesting_host, msg->buffer_size);
@@ -409,6 +414,7 @@ namespace wrench {
             if (not fs->isFileInDirectory(file, location->getAbsolutePathAtMountPoint())) {
                 WRENCH_INFO(
                         "Received a read request for a file I don't have (%s)", location->toString().c_str());
+                fs->recordCacheMiss();
                 failure_cause = std::shared_ptr<FailureCause>(new FileNotFound(location));
             }
         }
@@ -746,10 +752,25 @@ namespace wrench {
 
             this->stream_to_transactions[sg_iostream] = transaction;
             this->running_transactions.push_back(transaction);
+            this->pending_activities.emplace_back(sg_iostream);
             sg_iostream->vetoable_start();
         }
     }
 
+    /**
+     * @brief Remove a running transaction (the other running transactions keep their relative order, so
+     *        that transactions that complete at the same date are processed in the order in which they started)
+     * @param index: the transaction's index in the running transaction list
+     * @return the removed transaction
+     */
+    std::shared_ptr<SimpleStorageServiceNonBufferized::Transaction> SimpleStorageServiceNonBufferized::removeRunningTransaction(unsigned long index) {
+        auto transaction = this->running_transactions.at(index);
+        this->running_transactions.erase(this->running_transactions.begin() + (long) index);
+        this->pending_activities.erase(this->pending_activities.begin() + (long) index + 1);
+        this->stream_to_transactions.erase(transaction->stream);
+        return transaction;
+    }
+
     /**
 * @brief Get the load (number of concurrent reads) on the storage service
 * @return the load on the service
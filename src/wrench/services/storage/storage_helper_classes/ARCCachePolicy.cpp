@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <algorithm>
+
+#include <wrench/services/storage/storage_helpers/ARCCachePolicy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param capacity: the cache capacity in bytes
+     */
+    ARCCachePolicy::ARCCachePolicy(double capacity) : capacity(capacity) {
+    }
+
+    /**
+     * @brief Put an unpinned file at the most recently used end of T1 or T2
+     * @param file_on_disk: the file's record (which must not be in any list)
+     * @param list: T1 or T2
+     */
+    void ARCCachePolicy::insertInList(LogicalFileSystem::FileOnDisk *file_on_disk, LogicalFileSystem::FileOnDiskList *list) {
+        file_on_disk->lru_sequence_number = this->next_sequence_number++;
+        file_on_disk->cache_policy_data = list;
+        list->pushBack(file_on_disk);
+        if (list == &this->t1) {
+            this->t1_size += file_on_disk->file->getSize();
+        } else {
+            this->t2_size += file_on_disk->file->getSize();
+        }
+    }
+
+    /**
+     * @brief Remove a file from whichever list it is in
+     * @param file_on_disk: the file's record
+     */
+    void ARCCachePolicy::unlinkFile(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        auto list = this->getList(file_on_disk);
+        if (file_on_disk->num_current_transactions > 0) {
+            this->pinned_list.remove(file_on_disk);
+        } else {
+            list->remove(file_on_disk);
+        }
+        if (list == &this->t1) {
+            this->t1_size -= file_on_disk->file->getSize();
+        } else {
+            this->t2_size -= file_on_disk->file->getSize();
+        }
+        file_on_disk->cache_policy_data = nullptr;
+    }
+
+    /**
+     * @brief Forget the oldest ghost entries so that |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c
+     */
+    void ARCCachePolicy::trimGhostLists() {
+        while ((this->t1_size + this->b1.getTotalSize() > this->capacity) and (not this->b1.empty())) {
+            this->b1.popFront();
+        }
+        while ((this->t1_size + this->t2_size + this->b1.getTotalSize() + this->b2.getTotalSize() > 2 * this->capacity) and
+               (not this->b2.empty())) {
+            this->b2.popFront();
+        }
+    }
+
+    /**
+     * @brief Notify the policy that a file was written. A file that was recently evicted (i.e., that
+     *        is in a ghost list) goes to T2 and shifts the target size of T1 in favor of the list it
+     *        was evicted from. Any other file goes to T1.
+     * @param file_on_disk: the file's record
+     */
+    void ARCCachePolicy::fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        LogicalFileSystem::FileKey key{file_on_disk->directory_id, file_on_disk->file.get()};
+        double size = file_on_disk->file->getSize();
+
+        if (this->b1.contains(key)) {
+            double ratio = std::max<double>(1.0, this->b2.getTotalSize() / this->b1.getTotalSize());
+            this->target_t1_size = std::min<double>(this->capacity, this->target_t1_size + ratio * size);
+            this->b1.remove(key);
+            this->insertInList(file_on_disk, &this->t2);
+        } else if (this->b2.contains(key)) {
+            double ratio = std::max<double>(1.0, this->b1.getTotalSize() / this->b2.getTotalSize());
+            this->target_t1_size = std::max<double>(0.0, this->target_t1_size - ratio * size);
+            this->b2.remove(key);
+            this->insertInList(file_on_disk, &this->t2);
+        } else {
+            this->insertInList(file_on_disk, &this->t1);
+        }
+        this->trimGhostLists();
+    }
+
+    /**
+     * @brief Notify the policy that a file was read: it becomes the most recently used file of T2
+     * @param file_on_disk: the file's record
+     */
+    void ARCCachePolicy::fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        if (file_on_disk->num_current_transactions > 0) {
+            // Just change the list it belongs to: it will go at the right place when unpinned
+            if (this->getList(file_on_disk) == &this->t1) {
+                this->t1_size -= file_on_disk->file->getSize();
+                this->t2_size += file_on_disk->file->getSize();
+                file_on_disk->cache_policy_data = &this->t2;
+            }
+            file_on_disk->lru_sequence_number = this->next_sequence_number++;
+        } else {
+            this->unlinkFile(file_on_disk);
+            this->insertInList(file_on_disk, &this->t2);
+        }
+    }
+
+    /**
+     * @brief Notify the policy that a file is being removed
+     * @param file_on_disk: the file's record
+     */
+    void ARCCachePolicy::fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->unlinkFile(file_on_disk);
+    }
+
+    /**
+     * @brief Notify the policy that a file is now involved in a running transaction
+     * @param file_on_disk: the file's record
+     */
+    void ARCCachePolicy::filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->getList(file_on_disk)->remove(file_on_disk);
+        this->pinned_list.pushBack(file_on_disk);
+    }
+
+    /**
+     * @brief Notify the policy that a file is no longer involved in any running transaction
+     * @param file_on_disk: the file's record
+     */
+    void ARCCachePolicy::fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->pinned_list.remove(file_on_disk);
+        this->getList(file_on_disk)->insertBySequenceNumber(file_on_disk);
+    }
+
+    /**
+     * @brief Get the file that should be evicted next: the least recently used file of T1
+     *        if T1 is larger than its target size, otherwise that of T2
+     * @return a record, or nullptr if there is no evictable file
+     */
+    LogicalFileSystem::FileOnDisk *ARCCachePolicy::getVictim() {
+        if (this->t1.empty()) {
+            return this->t2.front();
+        }
+        if (this->t2.empty() or (this->t1_size > this->target_t1_size)) {
+            return this->t1.front();
+        }
+        return this->t2.front();
+    }
+
+    /**
+     * @brief Notify the policy that a file is being evicted: it goes to the corresponding ghost list
+     * @param file_on_disk: the file's record
+     */
+    void ARCCachePolicy::fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        bool from_t1 = (this->getList(file_on_disk) == &this->t1);
+        this->unlinkFile(file_on_disk);
+        LogicalFileSystem::FileKey key{file_on_disk->directory_id, file_on_disk->file.get()};
+        if (from_t1) {
+            this->b1.pushBack(key, file_on_disk->file->getSize());
+        } else {
+            this->b2.pushBack(key, file_on_disk->file->getSize());
+        }
+        this->trimGhostLists();
+    }
+
+    /**
+     * @brief Get the total size of the files that are not pinned
+     * @return a number of bytes
+     */
+    double ARCCachePolicy::getEvictableSize() {
+        return this->t1.getTotalSize() + this->t2.getTotalSize();
+    }
+
+}// namespace wrench
@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/storage/storage_helpers/BulkFileOperationThread.h>
+#include <wrench/services/storage/StorageServiceMessage.h>
+#include <wrench/services/storage/StorageServiceMessagePayload.h>
+#include <wrench/simgrid_S4U_util/S4U_Mailbox.h>
+#include <wrench/exceptions/ExecutionException.h>
+#include <wrench/failure_causes/FileNotFound.h>
+#include <wrench/logging/TerminalOutput.h>
+
+#include <utility>
+
+WRENCH_LOG_CATEGORY(wrench_core_bulk_file_operation_thread, "Log category for Bulk File Operation Thread");
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param hostname: host on which to run
+     * @param parent: the storage service that received the bulk request
+     * @param operation: the operation to perform
+     * @param locations: the locations in the bulk request
+     * @param sub_locations: for each location in the bulk request, the locations at which the operation
+     *        is actually performed (an empty vector means that the file is unknown)
+     * @param all_sub_deletions_must_succeed: whether a deletion is successful only if all its
+     *        sub-deletions are (e.g., stripes), or as soon as one is (e.g., copies)
+     * @param answer_mailbox: the mailbox of the client to which the answer should be sent
+     * @param file_deleted_callback: a callback invoked (in this thread) for each file whose deletion
+     *        has succeeded, before the answer is sent (nullptr if none)
+     */
+    BulkFileOperationThread::BulkFileOperationThread(const std::string &hostname,
+                                                     std::shared_ptr<StorageService> parent,
+                                                     Operation operation,
+                                                     std::vector<std::shared_ptr<FileLocation>> locations,
+                                                     std::vector<std::vector<std::shared_ptr<FileLocation>>> sub_locations,
+                                                     bool all_sub_deletions_must_succeed,
+                                                     simgrid::s4u::Mailbox *answer_mailbox,
+                                                     std::function<void(const std::shared_ptr<DataFile> &)> file_deleted_callback) : Service(hostname, "bulk_file_operation_thread"),
+                                                                                              parent(std::move(parent)),
+                                                                                              operation(operation),
+                                                                                              locations(std::move(locations)),
+                                                                                              sub_locations(std::move(sub_locations)),
+                                                                                              all_sub_deletions_must_succeed(all_sub_deletions_must_succeed),
+                                                                                              answer_mailbox(answer_mailbox),
+                                                                                              file_deleted_callback(std::move(file_deleted_callback)) {
+    }
+
+    /**
+     * @brief Cleanup method
+     * @param has_returned_from_main: whether main() returned
+     * @param return_value: the value returned by main() (if any)
+     */
+    void BulkFileOperationThread::cleanup(bool has_returned_from_main, int return_value) {
+        // Do nothing. It's fine to just die
+    }
+
+    /**
+     * @brief Main method
+     * @return 0 on success
+     */
+    int BulkFileOperationThread::main() {
+        TerminalOutput::setThisProcessLoggingColor(TerminalOutput::COLOR_CYAN);
+        WRENCH_INFO("New BulkFileOperationThread (%s, num_files=%lu)",
+                    (this->operation == LOOKUP ? "lookup" : "delete"), this->locations.size());
+
+        // Flatten all sub-locations, separating those at the parent itself (which cannot be sent a bulk
+        // request without recursing) from the others
+        std::vector<std::shared_ptr<FileLocation>> bulk_locations, single_locations;
+        std::vector<size_t> bulk_owners, single_owners;
+        for (size_t i = 0; i < this->sub_locations.size(); i++) {
+            for (auto const &sub_location: this->sub_locations[i]) {
+                if (sub_location->getStorageService() == this->parent) {
+                    single_locations.push_back(sub_location);
+                    single_owners.push_back(i);
+                } else {
+                    bulk_locations.push_back(sub_location);
+                    bulk_owners.push_back(i);
+                }
+            }
+        }
+
+        std::vector<bool> bulk_available, single_available;
+        std::vector<std::shared_ptr<FailureCause>> bulk_failure_causes, single_failure_causes;
+        this->performSingleFileOperations(single_locations, single_available, single_failure_causes);
+        StorageService::lookupOrDeleteFiles(this->operation == LOOKUP, bulk_locations, bulk_available, bulk_failure_causes);
+
+        // Combine the outcomes of the sub-operations of each file
+        std::vector<bool> files_are_available(this->locations.size(), true);
+        std::vector<unsigned long> num_successes(this->locations.size(), 0);
+        std::vector<std::shared_ptr<FailureCause>> failure_causes(this->locations.size(), nullptr);
+        auto combine = [&](size_t owner, bool available, const std::shared_ptr<FailureCause> &failure_cause) {
+            files_are_available[owner] = files_are_available[owner] and available and (failure_cause == nullptr);
+            if (failure_cause == nullptr) {
+                num_successes[owner]++;
+            } else if (failure_causes[owner] == nullptr) {
+                failure_causes[owner] = failure_cause;
+            }
+        };
+        for (size_t j = 0; j < bulk_locations.size(); j++) {
+            combine(bulk_owners[j], bulk_available[j], bulk_failure_causes[j]);
+        }
+        for (size_t j = 0; j < single_locations.size(); j++) {
+            combine(single_owners[j], single_available[j], single_failure_causes[j]);
+        }
+
+        try {
+            if (this->operation == LOOKUP) {
+                for (size_t i = 0; i < this->locations.size(); i++) {
+                    files_are_available[i] = files_are_available[i] and (not this->sub_locations[i].empty());
+                }
+                S4U_Mailbox::dputMessage(
+                        this->answer_mailbox,
+                        new StorageServiceBulkFileLookupAnswerMessage(
+                                files_are_available,
+                                (double) this->locations.size() * this->parent->getMessagePayloadValue(
+                                                                          StorageServiceMessagePayload::FILE_LOOKUP_ANSWER_MESSAGE_PAYLOAD)));
+            } else {
+                for (size_t i = 0; i < this->locations.size(); i++) {
+                    if (this->sub_locations[i].empty()) {
+                        failure_causes[i] = std::shared_ptr<FailureCause>(new FileNotFound(this->locations[i]));
+                    } else if ((not this->all_sub_deletions_must_succeed) and (num_successes[i] > 0)) {
+                        failure_causes[i] = nullptr;
+                    }
+                    if ((failure_causes[i] == nullptr) and this->file_deleted_callback) {
+                        this->file_deleted_callback(this->locations[i]->getFile());
+                    }
+                }
+                S4U_Mailbox::dputMessage(
+                        this->answer_mailbox,
+                        new StorageServiceBulkFileDeleteAnswerMessage(
+                                failure_causes,
+                                (double) this->locations.size() * this->parent->getMessagePayloadValue(
+                                                                          StorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+            }
+        } catch (ExecutionException &ignore) {
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Perform operations at the parent storage service, with one single-file request per
+     *        location (all requests are sent before any answer is waited for)
+     * @param single_locations: the locations (at the parent)
+     * @param files_are_available: set to whether each file is available (lookup only)
+     * @param failure_causes: set to the cause of the failure for each file (nullptr if none)
+     */
+    void BulkFileOperationThread::performSingleFileOperations(const std::vector<std::shared_ptr<FileLocation>> &single_locations,
+                                                              std::vector<bool> &files_are_available,
+                                                              std::vector<std::shared_ptr<FailureCause>> &failure_causes) {
+        files_are_available.assign(single_locations.size(), false);
+        failure_causes.assign(single_locations.size(), nullptr);
+
+        std::vector<simgrid::s4u::Mailbox *> mailboxes;
+        for (size_t j = 0; j < single_locations.size(); j++) {
+            auto mailbox = S4U_Mailbox::getTemporaryMailbox();
+            try {
+                if (this->operation == LOOKUP) {
+                    S4U_Mailbox::putMessage(
+                            this->parent->mailbox,
+                            new StorageServiceFileLookupRequestMessage(
+                                    mailbox,
+                                    single_locations[j],
+                                    this->parent->getMessagePayloadValue(
+                                            StorageServiceMessagePayload::FILE_LOOKUP_REQUEST_MESSAGE_PAYLOAD)));
+                } else {
+                    S4U_Mailbox::putMessage(
+                            this->parent->mailbox,
+                            new StorageServiceFileDeleteRequestMessage(
+                                    mailbox,
+                                    single_locations[j],
+                                    this->parent->getMessagePayloadValue(
+                                            StorageServiceMessagePayload::FILE_DELETE_REQUEST_MESSAGE_PAYLOAD)));
+                }
+            } catch (ExecutionException &e) {
+                failure_causes[j] = e.getCause();
+                S4U_Mailbox::retireTemporaryMailbox(mailbox);
+                mailbox = nullptr;
+            }
+            mailboxes.push_back(mailbox);
+        }
+
+        for (size_t j = 0; j < mailboxes.size(); j++) {
+            if (mailboxes[j] == nullptr) {
+                continue;
+            }
+            try {
+                auto message = S4U_Mailbox::getMessage(mailboxes[j], this->parent->getNetworkTimeoutValue());
+                if (auto msg = dynamic_cast<StorageServiceFileLookupAnswerMessage *>(message.get())) {
+                    files_are_available[j] = msg->file_is_available;
+                } else if (auto msg = dynamic_cast<StorageServiceFileDeleteAnswerMessage *>(message.get())) {
+                    failure_causes[j] = msg->failure_cause;
+                } else {
+                    throw std::runtime_error("BulkFileOperationThread::performSingleFileOperations(): Unexpected [" +
+                                             message->getName() + "] message");
+                }
+            } catch (ExecutionException &e) {
+                failure_causes[j] = e.getCause();
+            }
+            S4U_Mailbox::retireTemporaryMailbox(mailboxes[j]);
+        }
+    }
+
+}// namespace wrench
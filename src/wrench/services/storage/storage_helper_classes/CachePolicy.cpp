@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <stdexcept>
+
+#include <wrench/services/storage/storage_helpers/CachePolicy.h>
+#include <wrench/services/storage/storage_helpers/LFUCachePolicy.h>
+#include <wrench/services/storage/storage_helpers/ARCCachePolicy.h>
+#include <wrench/services/storage/storage_helpers/TwoQueueCachePolicy.h>
+#include <wrench/services/storage/storage_helpers/TTLCachePolicy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Method to create a cache replacement policy
+     * @param name: the policy name ("LFU", "ARC", "2Q", "TTL")
+     * @param capacity: the cache capacity in bytes
+     * @param ttl: the time-to-live of a file in seconds (only used by the "TTL" policy)
+     * @return a cache policy
+     *
+     * @throw std::invalid_argument
+     */
+    std::unique_ptr<CachePolicy> CachePolicy::createCachePolicy(const std::string &name, double capacity, double ttl) {
+        if (name == "LFU") {
+            return std::unique_ptr<CachePolicy>(new LFUCachePolicy());
+        } else if (name == "ARC") {
+            return std::unique_ptr<CachePolicy>(new ARCCachePolicy(capacity));
+        } else if (name == "2Q") {
+            return std::unique_ptr<CachePolicy>(new TwoQueueCachePolicy(capacity));
+        } else if (name == "TTL") {
+            if (ttl <= 0) {
+                throw std::invalid_argument("CachePolicy::createCachePolicy(): TTL must be > 0");
+            }
+            return std::unique_ptr<CachePolicy>(new TTLCachePolicy(ttl));
+        } else {
+            throw std::invalid_argument("CachePolicy::createCachePolicy(): Unknown cache policy " + name);
+        }
+    }
+
+}// namespace wrench
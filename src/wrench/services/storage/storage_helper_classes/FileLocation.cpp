@@ -22,16 +22,83 @@
 
 WRENCH_LOG_CATEGORY(wrench_core_file_location, "Log category for FileLocation");
 
-#define RECLAIM_TRIGGER 10000
-
 namespace wrench {
 
-    std::unordered_map<std::string, std::shared_ptr<FileLocation>> FileLocation::file_location_map;
-    size_t FileLocation::file_location_map_previous_size = 0;
+    namespace {
+        // Set to false once the registry below is being torn down at exit, so that
+        // file locations that outlive it do not try to unregister themselves
+        bool file_location_registry_alive = true;
+        struct FileLocationRegistryLifetime {
+            ~FileLocationRegistryLifetime() { file_location_registry_alive = false; }
+        };
+    }// namespace
+
+    std::unordered_map<std::string, FileLocation::InternedString> FileLocation::interned_strings;
+    std::vector<uint32_t> FileLocation::free_interned_string_ids;
+    std::unordered_map<FileLocation::Key, std::weak_ptr<FileLocation>, FileLocation::KeyHash> FileLocation::file_location_map;
+    static FileLocationRegistryLifetime file_location_registry_lifetime;
 
     FileLocation::~FileLocation() {
     }
 
+    /**
+     * @brief Intern a (mount point or path) string, adding a reference to it
+     * @param str: a string
+     * @return a unique numerical ID for the string
+     */
+    uint32_t FileLocation::internString(const std::string &str) {
+        auto it = FileLocation::interned_strings.find(str);
+        if (it != FileLocation::interned_strings.end()) {
+            it->second.num_references++;
+            return it->second.id;
+        }
+        uint32_t id;
+        if (not FileLocation::free_interned_string_ids.empty()) {
+            id = FileLocation::free_interned_string_ids.back();
+            FileLocation::free_interned_string_ids.pop_back();
+        } else {
+            id = static_cast<uint32_t>(FileLocation::interned_strings.size());
+        }
+        FileLocation::interned_strings.emplace(str, InternedString{id, 1});
+        return id;
+    }
+
+    /**
+     * @brief Remove a reference to an interned string, which is forgotten (and its ID
+     *        recycled) once no registered location uses it
+     * @param str: a string
+     */
+    void FileLocation::releaseString(const std::string &str) {
+        auto it = FileLocation::interned_strings.find(str);
+        if (it == FileLocation::interned_strings.end()) {
+            return;
+        }
+        if (--(it->second.num_references) == 0) {
+            FileLocation::free_interned_string_ids.push_back(it->second.id);
+            FileLocation::interned_strings.erase(it);
+        }
+    }
+
+    /**
+     * @brief Remove a file location from the registry, which is called when the last
+     *        reference to that location goes away (so no scan of the registry is ever needed)
+     * @param key: the location's key
+     * @param mp: the location's mount point
+     * @param apamp: the location's path at the mount point
+     */
+    void FileLocation::forgetFileLocation(const Key &key, const std::string &mp, const std::string &apamp) {
+        if (not file_location_registry_alive) {
+            return;
+        }
+        auto it = FileLocation::file_location_map.find(key);
+        // The entry may have been replaced by a newer location, which should be kept
+        if ((it != FileLocation::file_location_map.end()) and (it->second.expired())) {
+            FileLocation::file_location_map.erase(it);
+        }
+        FileLocation::releaseString(mp);
+        FileLocation::releaseString(apamp);
+    }
+
     /**
      * @brief Factory to create a new file location
      * @param ss: a storage service
@@ -46,35 +113,36 @@ namespace wrench {
                                                                    const std::string &apamp,
                                                                    const std::shared_ptr<DataFile> &file,
                                                                    bool is_scratch) {
-        // TODO: Find a more efficiency key?
-        std::string key = (ss ? ss->getName() : "") + "|" + mp + "|" + apamp + "|" + file->getID() + "|" + (is_scratch ? "1" : "0");
-        if (FileLocation::file_location_map.find(key) != FileLocation::file_location_map.end()) {
-            return FileLocation::file_location_map[key];
+        // The new key's references to the interned strings are kept only if a new location is registered
+        Key key{ss.get(), FileLocation::internString(mp), FileLocation::internString(apamp), file.get(), is_scratch};
+
+        auto it = FileLocation::file_location_map.find(key);
+        if (it != FileLocation::file_location_map.end()) {
+            if (auto existing_location = it->second.lock()) {
+                FileLocation::releaseString(mp);
+                FileLocation::releaseString(apamp);
+                return existing_location;
+            }
         }
-        auto new_location = std::shared_ptr<FileLocation>(new FileLocation(ss, mp, apamp, file, is_scratch));
 
-        if (FileLocation::file_location_map.size() - FileLocation::file_location_map_previous_size > RECLAIM_TRIGGER) {
-            FileLocation::reclaimFileLocations();
-            FileLocation::file_location_map_previous_size = FileLocation::file_location_map.size();
+        // The deleter unregisters the location and releases its interned strings (as they were when
+        // the key was built, since the mount point can be changed later), which is always safe since
+        // the key's raw pointers are kept alive by the location itself for as long as it is registered
+        auto new_location = std::shared_ptr<FileLocation>(
+                new FileLocation(ss, mp, apamp, file, is_scratch),
+                [key, mp, apamp](FileLocation *location) {
+                    FileLocation::forgetFileLocation(key, mp, apamp);
+                    delete location;
+                });
+
+        if (it != FileLocation::file_location_map.end()) {
+            it->second = new_location;
+        } else {
+            FileLocation::file_location_map.emplace(key, new_location);
         }
-        FileLocation::file_location_map[key] = new_location;
         return new_location;
     }
 
-
-    /**
-     * @brief Reclaim file locations that are no longer used
-     */
-    void FileLocation::reclaimFileLocations() {
-        for (auto it = FileLocation::file_location_map.cbegin(); it != FileLocation::file_location_map.cend();) {
-            if ((*it).second.use_count() == 1) {
-                it = FileLocation::file_location_map.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-
     /**
      * @brief File location specifier for a scratch storage
      *
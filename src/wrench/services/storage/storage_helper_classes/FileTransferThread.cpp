@@ -373,7 +373,7 @@ namespace wrench {
                     double chunk_size = std::min<double>(this->buffer_size, remaining);
 
                     if (Simulation::isPageCachingEnabled()) {
-                        simulation->readWithMemoryCache(f, chunk_size, location);
+                        simulation->readWithMemoryCache(f, chunk_size, location, std::max<double>(1, num_bytes) - remaining);
                     } else {
                         WRENCH_INFO("Reading %s bytes from disk", std::to_string(chunk_size).c_str());
                         simulation->readFromDisk(chunk_size, location->getStorageService()->hostname,
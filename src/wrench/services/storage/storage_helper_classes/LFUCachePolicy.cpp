@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/storage/storage_helpers/LFUCachePolicy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Destructor
+     */
+    LFUCachePolicy::~LFUCachePolicy() {
+        while (this->first_bucket) {
+            auto next = this->first_bucket->next;
+            delete this->first_bucket;
+            this->first_bucket = next;
+        }
+    }
+
+    /**
+     * @brief Get the bucket for a frequency, which must come right after a given bucket,
+     *        creating it if need be
+     * @param bucket: the bucket before (nullptr means the beginning of the bucket list)
+     * @param frequency: the frequency
+     * @return a bucket
+     */
+    LFUCachePolicy::Bucket *LFUCachePolicy::getOrCreateBucketAfter(Bucket *bucket, unsigned long frequency) {
+        auto next = (bucket ? bucket->next : this->first_bucket);
+        if (next and (next->frequency == frequency)) {
+            return next;
+        }
+        auto new_bucket = new Bucket();
+        new_bucket->frequency = frequency;
+        new_bucket->previous = bucket;
+        new_bucket->next = next;
+        if (next) {
+            next->previous = new_bucket;
+        }
+        if (bucket) {
+            bucket->next = new_bucket;
+        } else {
+            this->first_bucket = new_bucket;
+        }
+        return new_bucket;
+    }
+
+    /**
+     * @brief Remove a bucket from the bucket list if no file refers to it any more
+     * @param bucket: the bucket
+     */
+    void LFUCachePolicy::releaseBucketIfUnused(Bucket *bucket) {
+        if ((not bucket->files.empty()) or (bucket->num_pinned_files > 0)) {
+            return;
+        }
+        if (bucket->previous) {
+            bucket->previous->next = bucket->next;
+        } else {
+            this->first_bucket = bucket->next;
+        }
+        if (bucket->next) {
+            bucket->next->previous = bucket->previous;
+        }
+        delete bucket;
+    }
+
+    /**
+     * @brief Notify the policy that a file was written
+     * @param file_on_disk: the file's record
+     */
+    void LFUCachePolicy::fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        auto bucket = this->getOrCreateBucketAfter(nullptr, 1);
+        file_on_disk->lru_sequence_number = this->next_sequence_number++;
+        file_on_disk->cache_policy_data = bucket;
+        bucket->files.pushBack(file_on_disk);
+        this->evictable_size += file_on_disk->file->getSize();
+    }
+
+    /**
+     * @brief Notify the policy that a file was read
+     * @param file_on_disk: the file's record
+     */
+    void LFUCachePolicy::fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        auto bucket = getBucket(file_on_disk);
+        auto next_bucket = this->getOrCreateBucketAfter(bucket, bucket->frequency + 1);
+        file_on_disk->lru_sequence_number = this->next_sequence_number++;
+        file_on_disk->cache_policy_data = next_bucket;
+        if (file_on_disk->num_current_transactions > 0) {
+            bucket->num_pinned_files--;
+            next_bucket->num_pinned_files++;
+        } else {
+            bucket->files.remove(file_on_disk);
+            next_bucket->files.pushBack(file_on_disk);
+        }
+        this->releaseBucketIfUnused(bucket);
+    }
+
+    /**
+     * @brief Notify the policy that a file is being removed
+     * @param file_on_disk: the file's record
+     */
+    void LFUCachePolicy::fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        auto bucket = getBucket(file_on_disk);
+        if (file_on_disk->num_current_transactions > 0) {
+            this->pinned_list.remove(file_on_disk);
+            bucket->num_pinned_files--;
+        } else {
+            bucket->files.remove(file_on_disk);
+            this->evictable_size -= file_on_disk->file->getSize();
+        }
+        file_on_disk->cache_policy_data = nullptr;
+        this->releaseBucketIfUnused(bucket);
+    }
+
+    /**
+     * @brief Notify the policy that a file is now involved in a running transaction
+     * @param file_on_disk: the file's record
+     */
+    void LFUCachePolicy::filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        auto bucket = getBucket(file_on_disk);
+        bucket->files.remove(file_on_disk);
+        bucket->num_pinned_files++;
+        this->pinned_list.pushBack(file_on_disk);
+        this->evictable_size -= file_on_disk->file->getSize();
+    }
+
+    /**
+     * @brief Notify the policy that a file is no longer involved in any running transaction
+     * @param file_on_disk: the file's record
+     */
+    void LFUCachePolicy::fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        auto bucket = getBucket(file_on_disk);
+        this->pinned_list.remove(file_on_disk);
+        bucket->num_pinned_files--;
+        bucket->files.insertBySequenceNumber(file_on_disk);
+        this->evictable_size += file_on_disk->file->getSize();
+    }
+
+    /**
+     * @brief Get the file that should be evicted next, i.e., the least recently used
+     *        file among those with the lowest frequency
+     * @return a record, or nullptr if there is no evictable file
+     */
+    LogicalFileSystem::FileOnDisk *LFUCachePolicy::getVictim() {
+        // Buckets that only hold pinned files are skipped
+        for (auto bucket = this->first_bucket; bucket != nullptr; bucket = bucket->next) {
+            if (not bucket->files.empty()) {
+                return bucket->files.front();
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Notify the policy that a file is being evicted
+     * @param file_on_disk: the file's record
+     */
+    void LFUCachePolicy::fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->fileRemoved(file_on_disk);
+    }
+
+    /**
+     * @brief Get the total size of the files that are not pinned
+     * @return a number of bytes
+     */
+    double LFUCachePolicy::getEvictableSize() {
+        return this->evictable_size;
+    }
+
+}// namespace wrench
@@ -11,6 +11,7 @@
 #include <wrench/services/storage/storage_helpers/LogicalFileSystem.h>
 #include <wrench/services/storage/storage_helpers/LogicalFileSystemNoCaching.h>
 #include <wrench/services/storage/storage_helpers/LogicalFileSystemLRUCaching.h>
+#include <wrench/services/storage/storage_helpers/LogicalFileSystemPolicyCaching.h>
 
 #include <limits>
 #include <utility>
@@ -28,13 +29,15 @@ namespace wrench {
      * @param hostname hostname on which the disk is mounted
      * @param storage_service storage service for which this file system is created
      * @param mount_point the mountpoint
-     * @param eviction_policy the cache eviction policy ("NONE", "LRU")
+     * @param eviction_policy the cache eviction policy ("NONE", "LRU", "LFU", "ARC", "2Q", "TTL")
+     * @param caching_ttl the time-to-live of a file, in seconds (only used by the "TTL" policy)
      * @return a shared pointer to a LogicalFileSystem instance
      */
     std::unique_ptr<LogicalFileSystem> LogicalFileSystem::createLogicalFileSystem(const std::string &hostname,
                                                                                   StorageService *storage_service,
                                                                                   const std::string &mount_point,
-                                                                                  const std::string &eviction_policy) {
+                                                                                  const std::string &eviction_policy,
+                                                                                  double caching_ttl) {
 
         if (storage_service == nullptr) {
             throw std::invalid_argument("LogicalFileSystem::createLogicalFileSystem(): nullptr storage_service argument");
@@ -46,6 +49,10 @@ namespace wrench {
             to_return = std::unique_ptr<LogicalFileSystem>(new LogicalFileSystemNoCaching(hostname, storage_service, mount_point));
         } else if (eviction_policy == "LRU") {
             to_return = std::unique_ptr<LogicalFileSystem>(new LogicalFileSystemLRUCaching(hostname, storage_service, mount_point));
+        } else if ((eviction_policy == "LFU") or (eviction_policy == "ARC") or
+                   (eviction_policy == "2Q") or (eviction_policy == "TTL")) {
+            to_return = std::unique_ptr<LogicalFileSystem>(new LogicalFileSystemPolicyCaching(hostname, storage_service, mount_point,
+                                                                                              eviction_policy, caching_ttl));
         } else {
             throw std::invalid_argument("LogicalFileSystem::createLogicalFileSystem(): Unknown cache eviction policy " + eviction_policy);
         }
@@ -65,7 +72,7 @@ namespace wrench {
 
         this->hostname = hostname;
         this->storage_service = storage_service;
-        this->content["/"] = {};
+        this->ensureDirectoryExists(this->internDirectory("/"));
 
         this->initialized = false;
         if (mount_point == DEV_NULL) {
@@ -117,6 +124,123 @@ namespace wrench {
         return this->initialized;
     }
 
+    /**
+     * @brief Get the interned ID of a directory that is being created (or written
+     *        into), interning its path if needed
+     *
+     * @param absolute_path: the directory's absolute path (sanitized or not)
+     * @return a directory ID
+     */
+    uint32_t LogicalFileSystem::internDirectory(const std::string &absolute_path) {
+        // Fast path: this exact string has been seen before, no need to sanitize it again
+        auto it = this->directory_ids.find(absolute_path);
+        if (it != this->directory_ids.end()) {
+            return it->second;
+        }
+        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
+        uint32_t directory_id;
+        auto fixed_it = this->directory_ids.find(fixed_path);
+        if (fixed_it != this->directory_ids.end()) {
+            directory_id = fixed_it->second;
+        } else {
+            directory_id = static_cast<uint32_t>(this->directories.size());
+            this->directories.emplace_back();
+            this->directories.back().path = fixed_path;
+            this->directory_ids[fixed_path] = directory_id;
+        }
+        this->directory_ids[absolute_path] = directory_id;
+        return directory_id;
+    }
+
+    /**
+     * @brief Look up the interned ID of a directory, without interning anything
+     *
+     * @param absolute_path: the directory's absolute path (sanitized or not)
+     * @return a directory ID, or NO_DIRECTORY if the directory was never created
+     */
+    uint32_t LogicalFileSystem::findDirectoryID(const std::string &absolute_path) {
+        auto it = this->directory_ids.find(absolute_path);
+        if (it != this->directory_ids.end()) {
+            return it->second;
+        }
+        auto fixed_it = this->directory_ids.find(FileLocation::sanitizePath(absolute_path + "/"));
+        if (fixed_it != this->directory_ids.end()) {
+            return fixed_it->second;
+        }
+        return NO_DIRECTORY;
+    }
+
+    /**
+     * @brief Find a file's record in a directory
+     * @param file: the file
+     * @param directory_id: the directory ID (possibly NO_DIRECTORY)
+     * @return the record, or nullptr if the file is not in the directory
+     */
+    LogicalFileSystem::FileOnDisk *LogicalFileSystem::lookupFileOnDisk(const std::shared_ptr<DataFile> &file, uint32_t directory_id) {
+        if (directory_id == NO_DIRECTORY) {
+            return nullptr;
+        }
+        auto it = this->content.find(FileKey{directory_id, file.get()});
+        if (it == this->content.end()) {
+            return nullptr;
+        }
+        return &(it->second);
+    }
+
+    /**
+     * @brief Add a file's record to a directory, or refresh it if the file is already there
+     * @param file: the file
+     * @param directory_id: the directory ID (the directory is created if needed)
+     * @param last_write_date: the file's last write date
+     * @return the record
+     */
+    LogicalFileSystem::FileOnDisk *LogicalFileSystem::addFileOnDisk(const std::shared_ptr<DataFile> &file, uint32_t directory_id, double last_write_date) {
+        auto &dir = this->ensureDirectoryExists(directory_id);
+        auto inserted = this->content.emplace(std::piecewise_construct,
+                                              std::forward_as_tuple(FileKey{directory_id, file.get()}),
+                                              std::forward_as_tuple(file, directory_id, last_write_date));
+        auto file_on_disk = &(inserted.first->second);
+        if (not inserted.second) {
+            file_on_disk->last_write_date = last_write_date;
+            return file_on_disk;
+        }
+        file_on_disk->next_in_directory = dir.first_file;
+        if (dir.first_file) {
+            dir.first_file->previous_in_directory = file_on_disk;
+        }
+        dir.first_file = file_on_disk;
+        dir.num_files++;
+        return file_on_disk;
+    }
+
+    /**
+     * @brief Remove a file's record (the record can no longer be used after this call)
+     * @param file_on_disk: the record
+     */
+    void LogicalFileSystem::removeFileOnDisk(FileOnDisk *file_on_disk) {
+        auto &dir = this->directories[file_on_disk->directory_id];
+        if (file_on_disk->previous_in_directory) {
+            file_on_disk->previous_in_directory->next_in_directory = file_on_disk->next_in_directory;
+        } else {
+            dir.first_file = file_on_disk->next_in_directory;
+        }
+        if (file_on_disk->next_in_directory) {
+            file_on_disk->next_in_directory->previous_in_directory = file_on_disk->previous_in_directory;
+        }
+        dir.num_files--;
+        this->content.erase(FileKey{file_on_disk->directory_id, file_on_disk->file.get()});
+    }
+
+    /**
+     * @brief Remove the space reservation for a file that is now stored, if any
+     * @param file: the file
+     * @param directory_id: the directory ID
+     * @return true if there was a reservation
+     */
+    bool LogicalFileSystem::consumeReservation(const std::shared_ptr<DataFile> &file, uint32_t directory_id) {
+        return (this->reserved_space.erase(FileKey{directory_id, file.get()}) > 0);
+    }
+
     /**
      * @brief Create a new directory
      *
@@ -128,9 +252,11 @@ namespace wrench {
             return;
         }
         //        assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-        assertDirectoryDoesNotExist(fixed_path);
-        this->content[fixed_path] = {};
+        auto &dir = this->directories[this->internDirectory(absolute_path)];
+        if (dir.exists) {
+            throw std::invalid_argument("LogicalFileSystem::assertDirectoryExists(): directory " + dir.path + " already exists");
+        }
+        dir.exists = true;
     }
 
     /**
@@ -143,8 +269,8 @@ namespace wrench {
             return false;
         }
         //        assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-        return (this->content.find(fixed_path) != this->content.end());
+        auto directory_id = this->findDirectoryID(absolute_path);
+        return ((directory_id != NO_DIRECTORY) and this->directories[directory_id].exists);
     }
 
     /**
@@ -159,9 +285,7 @@ namespace wrench {
             return true;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-        assertDirectoryExist(fixed_path);
-        return (this->content[fixed_path].empty());
+        return (assertDirectoryExist(absolute_path).num_files == 0);
     }
 
     /**
@@ -174,11 +298,12 @@ namespace wrench {
         if (devnull) {
             return;
         }
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
         assertInitHasBeenCalled();
-        assertDirectoryExist(fixed_path);
-        assertDirectoryIsEmpty(fixed_path);
-        this->content.erase(fixed_path);
+        auto &dir = assertDirectoryExist(absolute_path);
+        if (dir.num_files != 0) {
+            throw std::invalid_argument("LogicalFileSystem::assertDirectoryIsEmpty(): directory " + dir.path + "is not empty");
+        }
+        dir.exists = false;
     }
 
 
@@ -196,14 +321,9 @@ namespace wrench {
             return false;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        // If directory does not exist, say "no"
-        if (not doesDirectoryExist(fixed_path)) {
-            return false;
-        }
-
-        return (this->content[fixed_path].find(file) != this->content[fixed_path].end());
+        this->evictExpiredFiles();
+        // If directory does not exist, the lookup simply fails
+        return (this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path)) != nullptr);
     }
 
     /**
@@ -220,11 +340,10 @@ namespace wrench {
             return {};
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        assertDirectoryExist(fixed_path);
-        for (auto const &f: this->content[fixed_path]) {
-            to_return.insert(f.first);
+        this->evictExpiredFiles();
+        auto &dir = assertDirectoryExist(absolute_path);
+        for (auto f = dir.first_file; f != nullptr; f = f->next_in_directory) {
+            to_return.insert(f->file);
         }
         return to_return;
     }
@@ -254,6 +373,7 @@ namespace wrench {
      */
     double LogicalFileSystem::getFreeSpace() {
         assertInitHasBeenCalled();
+        this->evictExpiredFiles();
         return this->free_space;
     }
 
@@ -271,14 +391,14 @@ namespace wrench {
         }
 
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
+        this->evictExpiredFiles();
+        auto directory_id = this->internDirectory(absolute_path);
 
-
-        std::string key = FileLocation::sanitizePath(fixed_path) + file->getID();
+        FileKey key{directory_id, file.get()};
         if (this->reserved_space.find(key) != this->reserved_space.end()) {
             WRENCH_WARN("LogicalFileSystem::reserveSpace(): Space was already being reserved for storing file %s at path %s:%s. "
                         "This is likely a redundant copy, and nothing needs to be done",
-                        file->getID().c_str(), this->hostname.c_str(), fixed_path.c_str());
+                        file->getID().c_str(), this->hostname.c_str(), this->directories[directory_id].path.c_str());
         }
 
         if (this->free_space < file->getSize()) {
@@ -303,15 +423,12 @@ namespace wrench {
             return;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
 
-        std::string key = FileLocation::sanitizePath(std::move(fixed_path)) + file->getID();
-
-        if (this->reserved_space.find(key) == this->reserved_space.end()) {
+        auto directory_id = this->findDirectoryID(absolute_path);
+        if ((directory_id == NO_DIRECTORY) or (not this->consumeReservation(file, directory_id))) {
             return;// oh well, the transfer was cancelled/terminated/whatever
         }
 
-        this->reserved_space.erase(key);
         this->free_space += file->getSize();
     }
 
@@ -328,21 +445,41 @@ namespace wrench {
             return -1;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        // If directory does not exist, say "no"
-        if (not doesDirectoryExist(fixed_path)) {
-            return -1;
-        }
+        this->evictExpiredFiles();
 
-        if (this->content[fixed_path].find(file) != this->content[fixed_path].end()) {
-            return (this->content[fixed_path][file]->last_write_date);
+        // If directory does not exist, the lookup simply fails
+        auto file_on_disk = this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path));
+        if (file_on_disk) {
+            return file_on_disk->last_write_date;
         } else {
             return -1;
         }
     }
 
 
+    /**
+     * @brief Get the caching behavior of this file system
+     * @return a caching behavior name (e.g., "NONE", "LRU")
+     */
+    std::string LogicalFileSystem::getCachingBehavior() {
+        return this->caching_behavior;
+    }
+
+    /**
+     * @brief Get the cache statistics (hits, misses, evictions) of this file system
+     * @return the cache statistics
+     */
+    LogicalFileSystem::CacheStatistics LogicalFileSystem::getCacheStatistics() {
+        return this->cache_statistics;
+    }
+
+    /**
+     * @brief Record a cache miss, i.e., an attempt to read a file that is not present
+     */
+    void LogicalFileSystem::recordCacheMiss() {
+        this->cache_statistics.num_misses++;
+    }
+
     /**
      * @brief Get the disk on which this file system runs
      * @return The SimGrid disk on which this file system is mounted
@@ -372,9 +509,7 @@ namespace wrench {
                                         file->getID() + " at " + this->hostname + ":" + absolute_path);
         }
 
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        this->storeFileInDirectory(file, fixed_path, false);
+        this->storeFileInDirectory(file, absolute_path, false);
     }
 
 }// namespace wrench
@@ -26,9 +26,22 @@ namespace wrench {
      */
     LogicalFileSystemLRUCaching::LogicalFileSystemLRUCaching(const std::string &hostname, StorageService *storage_service, const std::string &mount_point)
         : LogicalFileSystem(hostname, storage_service, mount_point) {
+        this->caching_behavior = "LRU";
     }
 
 
+    /**
+     * @brief Remove a file from whichever LRU list it is in
+     * @param file_on_disk: the file's record
+     */
+    void LogicalFileSystemLRUCaching::unlinkFile(FileOnDisk *file_on_disk) {
+        if (file_on_disk->num_current_transactions > 0) {
+            this->pinned_list.remove(file_on_disk);
+        } else {
+            this->lru_list.remove(file_on_disk);
+        }
+    }
+
     /**
      * @brief Store file in directory
      *
@@ -45,30 +58,26 @@ namespace wrench {
         if (must_be_initialized) {
             assertInitHasBeenCalled();
         }
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        // If directory does not exit, create it
-        if (not doesDirectoryExist(fixed_path)) {
-            createDirectory(fixed_path);
-        }
+        auto directory_id = this->internDirectory(absolute_path);
 
-        bool file_already_there = this->content[fixed_path].find(file) != this->content[fixed_path].end();
+        auto file_on_disk = this->lookupFileOnDisk(file, directory_id);
+        bool file_already_there = (file_on_disk != nullptr);
 
         // If the file was already there, remove its LRU entry
         if (file_already_there) {
-            unsigned old_seq = std::static_pointer_cast<FileOnDiskLRUCaching>(this->content[fixed_path][file])->lru_sequence_number;
-            this->lru_list.erase(old_seq);
+            this->unlinkFile(file_on_disk);
         }
 
-        this->content[fixed_path][file] = std::make_shared<FileOnDiskLRUCaching>(S4U_Simulation::getClock(), this->next_lru_sequence_number++, 0);
-        this->lru_list[this->next_lru_sequence_number - 1] = std::make_tuple(fixed_path, file);
+        // If directory does not exit, it is created
+        file_on_disk = this->addFileOnDisk(file, directory_id, S4U_Simulation::getClock());
+        file_on_disk->lru_sequence_number = this->next_lru_sequence_number++;
+        file_on_disk->num_current_transactions = 0;
+        this->lru_list.pushBack(file_on_disk);
 
         //        print_lru_list();
 
-        std::string key = FileLocation::sanitizePath(fixed_path) + file->getID();
-        if (this->reserved_space.find(key) != this->reserved_space.end()) {
-            this->reserved_space.erase(key);
-        } else if (not file_already_there) {
+        bool space_was_reserved = this->consumeReservation(file, directory_id);
+        if ((not space_was_reserved) and (not file_already_there)) {
             this->free_space -= file->getSize();
         }
     }
@@ -85,13 +94,9 @@ namespace wrench {
             return;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        assertDirectoryExist(fixed_path);
-        assertFileIsInDirectory(file, fixed_path);
-        auto seq = std::static_pointer_cast<FileOnDiskLRUCaching>(this->content[fixed_path][file])->lru_sequence_number;
-        this->content[fixed_path].erase(file);
-        this->lru_list.erase(seq);
+        auto file_on_disk = assertFileIsInDirectory(file, absolute_path);
+        this->unlinkFile(file_on_disk);
+        this->removeFileOnDisk(file_on_disk);
         //        print_lru_list();
         this->free_space += file->getSize();
     }
@@ -107,18 +112,13 @@ namespace wrench {
             return;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        assertDirectoryExist(fixed_path);
+        auto &dir = assertDirectoryExist(absolute_path);
         double freed_space = 0;
-        for (auto const &s: this->content[fixed_path]) {
-            freed_space += s.first->getSize();
+        while (dir.first_file) {
+            freed_space += dir.first_file->file->getSize();
+            this->unlinkFile(dir.first_file);
+            this->removeFileOnDisk(dir.first_file);
         }
-        for (auto const &c: this->content[fixed_path]) {
-            this->lru_list.erase(std::static_pointer_cast<FileOnDiskLRUCaching>(c.second)->lru_sequence_number);
-        }
-
-        this->content[fixed_path].clear();
         this->free_space += freed_space;
     }
 
@@ -133,19 +133,17 @@ namespace wrench {
             return;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
 
-        // If directory does not exist, do nothing
-        if (not doesDirectoryExist(fixed_path)) {
-            return;
-        }
-
-        if (this->content[fixed_path].find(file) != this->content[fixed_path].end()) {
-            unsigned new_seq = this->next_lru_sequence_number++;
-            unsigned old_seq = std::static_pointer_cast<FileOnDiskLRUCaching>(this->content[fixed_path][file])->lru_sequence_number;
-            this->lru_list.erase(old_seq);
-            std::static_pointer_cast<FileOnDiskLRUCaching>(this->content[fixed_path][file])->lru_sequence_number = new_seq;
-            this->lru_list[new_seq] = std::make_tuple(fixed_path, file);
+        // If directory does not exist, or the file isn't there, do nothing
+        auto file_on_disk = this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path));
+        if (file_on_disk) {
+            this->cache_statistics.num_hits++;
+            file_on_disk->lru_sequence_number = this->next_lru_sequence_number++;
+            // A pinned file will be put back at the right place when unpinned
+            if (file_on_disk->num_current_transactions == 0) {
+                this->lru_list.remove(file_on_disk);
+                this->lru_list.pushBack(file_on_disk);
+            }
             //            print_lru_list();
         }
     }
@@ -162,40 +160,21 @@ namespace wrench {
             return true;
         }
 
-        // Otherwise, we have to try to evict evictable files
-        // The worst-case complexity is O(n) here, but we expect
-        // very few files to not be evictable. Besides, non-evictable
-        // files are likely recently used anyway.
-        std::vector<unsigned int> to_evict;
-        double freeable_space = 0;
-        for (auto const &lru: this->lru_list) {
-            auto path = std::get<0>(lru.second);
-            auto file = std::get<1>(lru.second);
-            if (std::static_pointer_cast<FileOnDiskLRUCaching>(this->content[path][file])->num_current_transactions > 0) {
-                //                std::cerr << "PASSING OVER " << path << ":" << file->getID() << "\n";
-                continue;
-            }
-            to_evict.push_back(lru.first);
-            freeable_space += file->getSize();
-            if (this->free_space + freeable_space >= needed_free_space) {
-                break;
-            }
-        }
-
-        // Perhaps that wasn't enough
-        if (this->free_space + freeable_space < needed_free_space) {
+        // Since non-evictable files are not in the LRU list, we know right away
+        // whether evicting would be enough
+        if (this->free_space + this->lru_list.getTotalSize() < needed_free_space) {
             return false;
         }
 
-        // If it was enough, simply remove files
-        for (const unsigned int &key: to_evict) {
-            auto path = std::get<0>(this->lru_list[key]);
-            auto file = std::get<1>(this->lru_list[key]);
-            //            std::cerr << "Evicting file " <<  path.c_str() << ":" <<  file->getID().c_str() << "\n";
-            WRENCH_INFO("Evicting file %s:%s", path.c_str(), file->getID().c_str());
-            this->lru_list.erase(key);
-            this->content[path].erase(file);
+        // If it is enough, simply remove the least recently used files
+        while ((this->free_space < needed_free_space) and (not this->lru_list.empty())) {
+            auto file_on_disk = this->lru_list.front();
+            auto file = file_on_disk->file;
+            WRENCH_INFO("Evicting file %s:%s", this->directories[file_on_disk->directory_id].path.c_str(), file->getID().c_str());
+            this->lru_list.remove(file_on_disk);
+            this->removeFileOnDisk(file_on_disk);
             this->free_space += file->getSize();
+            this->cache_statistics.num_evictions++;
         }
         //        print_lru_list();
 
@@ -209,11 +188,13 @@ namespace wrench {
      */
     void LogicalFileSystemLRUCaching::incrementNumRunningTransactionsForFileInDirectory(const shared_ptr<DataFile> &file, const string &absolute_path) {
 
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        if ((this->content.find(fixed_path) != this->content.end()) and
-            (this->content[fixed_path].find(file) != this->content[fixed_path].end())) {
-            std::static_pointer_cast<FileOnDiskLRUCaching>(this->content[fixed_path][file])->num_current_transactions++;
+        auto file_on_disk = this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path));
+        if (file_on_disk) {
+            if (file_on_disk->num_current_transactions == 0) {
+                this->lru_list.remove(file_on_disk);
+                this->pinned_list.pushBack(file_on_disk);
+            }
+            file_on_disk->num_current_transactions++;
         }
     }
 
@@ -224,11 +205,14 @@ namespace wrench {
      */
     void LogicalFileSystemLRUCaching::decrementNumRunningTransactionsForFileInDirectory(const shared_ptr<DataFile> &file, const string &absolute_path) {
 
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        if ((this->content.find(fixed_path) != this->content.end()) and
-            (this->content[fixed_path].find(file) != this->content[fixed_path].end())) {
-            std::static_pointer_cast<FileOnDiskLRUCaching>(this->content[fixed_path][file])->num_current_transactions--;
+        auto file_on_disk = this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path));
+        if (file_on_disk and (file_on_disk->num_current_transactions > 0)) {
+            file_on_disk->num_current_transactions--;
+            if (file_on_disk->num_current_transactions == 0) {
+                this->pinned_list.remove(file_on_disk);
+                // Put the file back in the LRU list at the position given by its sequence number
+                this->lru_list.insertBySequenceNumber(file_on_disk);
+            }
         }
     }
 
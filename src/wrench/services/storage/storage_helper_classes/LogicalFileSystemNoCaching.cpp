@@ -45,22 +45,15 @@ namespace wrench {
         if (must_be_initialized) {
             assertInitHasBeenCalled();
         }
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
+        auto directory_id = this->internDirectory(absolute_path);
 
-        // If directory does not exit, create it
-        if (not doesDirectoryExist(fixed_path)) {
-            createDirectory(fixed_path);
-        }
-
-
-        bool file_already_there = this->content[fixed_path].find(file) != this->content[fixed_path].end();
+        bool file_already_there = (this->lookupFileOnDisk(file, directory_id) != nullptr);
 
-        this->content[fixed_path][file] = std::make_shared<LogicalFileSystemNoCaching::FileOnDiskNoCaching>(S4U_Simulation::getClock());
+        // If directory does not exit, it is created
+        this->addFileOnDisk(file, directory_id, S4U_Simulation::getClock());
 
-        std::string key = FileLocation::sanitizePath(fixed_path) + file->getID();
-        if (this->reserved_space.find(key) != this->reserved_space.end()) {
-            this->reserved_space.erase(key);
-        } else if (not file_already_there) {
+        bool space_was_reserved = this->consumeReservation(file, directory_id);
+        if ((not space_was_reserved) and (not file_already_there)) {
             this->free_space -= file->getSize();
         }
     }
@@ -77,11 +70,8 @@ namespace wrench {
             return;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        assertDirectoryExist(fixed_path);
-        assertFileIsInDirectory(file, fixed_path);
-        this->content[fixed_path].erase(file);
+        auto file_on_disk = assertFileIsInDirectory(file, absolute_path);
+        this->removeFileOnDisk(file_on_disk);
         this->free_space += file->getSize();
     }
 
@@ -96,14 +86,12 @@ namespace wrench {
             return;
         }
         assertInitHasBeenCalled();
-        auto fixed_path = FileLocation::sanitizePath(absolute_path + "/");
-
-        assertDirectoryExist(fixed_path);
+        auto &dir = assertDirectoryExist(absolute_path);
         double freed_space = 0;
-        for (auto const &s: this->content[fixed_path]) {
-            freed_space += s.first->getSize();
+        while (dir.first_file) {
+            freed_space += dir.first_file->file->getSize();
+            this->removeFileOnDisk(dir.first_file);
         }
-        this->content[fixed_path].clear();
         this->free_space += freed_space;
     }
 
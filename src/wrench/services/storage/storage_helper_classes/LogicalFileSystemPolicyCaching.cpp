@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench-dev.h>
+#include <wrench/services/storage/storage_helpers/LogicalFileSystemPolicyCaching.h>
+
+#include <utility>
+
+WRENCH_LOG_CATEGORY(wrench_core_logical_file_system_policy_caching, "Log category for Logical File System Policy Caching");
+
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param hostname: the host on which the file system is located
+     * @param storage_service: the storage service this file system is for
+     * @param mount_point: the mount point, defaults to /dev/null
+     * @param caching_behavior: the cache replacement policy ("LFU", "ARC", "2Q", "TTL")
+     * @param caching_ttl: the time-to-live of a file in seconds (only used by the "TTL" policy)
+     */
+    LogicalFileSystemPolicyCaching::LogicalFileSystemPolicyCaching(const std::string &hostname, StorageService *storage_service,
+                                                                   const std::string &mount_point,
+                                                                   const std::string &caching_behavior,
+                                                                   double caching_ttl)
+        : LogicalFileSystem(hostname, storage_service, mount_point) {
+        this->caching_behavior = caching_behavior;
+        this->policy = CachePolicy::createCachePolicy(caching_behavior, this->total_capacity, caching_ttl);
+    }
+
+    /**
+     * @brief Evict a file
+     * @param file_on_disk: the file's record (which must not be pinned)
+     */
+    void LogicalFileSystemPolicyCaching::evictFile(FileOnDisk *file_on_disk) {
+        auto file = file_on_disk->file;
+        WRENCH_INFO("Evicting file %s:%s", this->directories[file_on_disk->directory_id].path.c_str(), file->getID().c_str());
+        this->policy->fileEvicted(file_on_disk);
+        this->removeFileOnDisk(file_on_disk);
+        this->free_space += file->getSize();
+        this->cache_statistics.num_evictions++;
+    }
+
+    /**
+     * @brief Store file in directory
+     *
+     * @param file: the file to store
+     * @param absolute_path: the directory's absolute path (at the mount point)
+     * @param must_be_initialized: whether the file system is initialized
+     *
+     * @throw std::invalid_argument
+     */
+    void LogicalFileSystemPolicyCaching::storeFileInDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path, bool must_be_initialized) {
+        if (devnull) {
+            return;
+        }
+        if (must_be_initialized) {
+            assertInitHasBeenCalled();
+            this->evictExpiredFiles();
+        }
+        auto directory_id = this->internDirectory(absolute_path);
+
+        auto file_on_disk = this->lookupFileOnDisk(file, directory_id);
+        bool file_already_there = (file_on_disk != nullptr);
+
+        // If the file was already there, it is treated as a new file by the policy
+        if (file_already_there) {
+            this->policy->fileRemoved(file_on_disk);
+        }
+
+        // If directory does not exit, it is created
+        file_on_disk = this->addFileOnDisk(file, directory_id, S4U_Simulation::getClock());
+        file_on_disk->num_current_transactions = 0;
+        this->policy->fileAdded(file_on_disk);
+
+        bool space_was_reserved = this->consumeReservation(file, directory_id);
+        if ((not space_was_reserved) and (not file_already_there)) {
+            this->free_space -= file->getSize();
+        }
+    }
+
+    /**
+     * @brief Remove a file in a directory
+     * @param file: the file to remove
+     * @param absolute_path: the directory's absolute path
+     *
+     * @throw std::invalid_argument
+     */
+    void LogicalFileSystemPolicyCaching::removeFileFromDirectory(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) {
+        if (devnull) {
+            return;
+        }
+        assertInitHasBeenCalled();
+        auto file_on_disk = assertFileIsInDirectory(file, absolute_path);
+        this->policy->fileRemoved(file_on_disk);
+        this->removeFileOnDisk(file_on_disk);
+        this->free_space += file->getSize();
+    }
+
+    /**
+     * @brief Remove all files in a directory
+     * @param absolute_path: the directory's absolute path
+     *
+     * @throw std::invalid_argument
+     */
+    void LogicalFileSystemPolicyCaching::removeAllFilesInDirectory(const std::string &absolute_path) {
+        if (devnull) {
+            return;
+        }
+        assertInitHasBeenCalled();
+        auto &dir = assertDirectoryExist(absolute_path);
+        double freed_space = 0;
+        while (dir.first_file) {
+            freed_space += dir.first_file->file->getSize();
+            this->policy->fileRemoved(dir.first_file);
+            this->removeFileOnDisk(dir.first_file);
+        }
+        this->free_space += freed_space;
+    }
+
+    /**
+     * @brief Update a file's read date
+     * @param file: the file
+     * @param absolute_path: the path
+     */
+    void LogicalFileSystemPolicyCaching::updateReadDate(const std::shared_ptr<DataFile> &file, const std::string &absolute_path) {
+        if (devnull) {
+            return;
+        }
+        assertInitHasBeenCalled();
+
+        // If directory does not exist, or the file isn't there, do nothing
+        auto file_on_disk = this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path));
+        if (file_on_disk) {
+            this->cache_statistics.num_hits++;
+            this->policy->fileAccessed(file_on_disk);
+        }
+    }
+
+    /**
+     * @brief Evict files, in the order given by the cache policy, to create some free space
+     * @param needed_free_space: the needed free space
+     * @return true on success, false on failure
+     */
+    bool LogicalFileSystemPolicyCaching::evictFiles(double needed_free_space) {
+
+        // Easy case: there is already enough space without evicting anything
+        if (this->free_space >= needed_free_space) {
+            return true;
+        }
+
+        // Check upfront whether evicting would be enough
+        if (this->free_space + this->policy->getEvictableSize() < needed_free_space) {
+            return false;
+        }
+
+        while (this->free_space < needed_free_space) {
+            auto victim = this->policy->getVictim();
+            if (victim == nullptr) {
+                break;
+            }
+            this->evictFile(victim);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Evict the files that have expired, if the cache policy has such a notion
+     */
+    void LogicalFileSystemPolicyCaching::evictExpiredFiles() {
+        if (devnull) {
+            return;
+        }
+        double now = S4U_Simulation::getClock();
+        while (auto expired = this->policy->getExpiredFile(now)) {
+            this->evictFile(expired);
+        }
+    }
+
+    /**
+     * @brief Increment the number of running transactions that have to do with a file
+     * @param file: the file
+     * @param absolute_path: the file path
+     */
+    void LogicalFileSystemPolicyCaching::incrementNumRunningTransactionsForFileInDirectory(const shared_ptr<DataFile> &file, const string &absolute_path) {
+
+        auto file_on_disk = this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path));
+        if (file_on_disk) {
+            if (file_on_disk->num_current_transactions == 0) {
+                this->policy->filePinned(file_on_disk);
+            }
+            file_on_disk->num_current_transactions++;
+        }
+    }
+
+    /**
+     * @brief Decrement the number of running transactions that have to do with a file
+     * @param file: the file
+     * @param absolute_path: the file path
+     */
+    void LogicalFileSystemPolicyCaching::decrementNumRunningTransactionsForFileInDirectory(const shared_ptr<DataFile> &file, const string &absolute_path) {
+
+        auto file_on_disk = this->lookupFileOnDisk(file, this->findDirectoryID(absolute_path));
+        if (file_on_disk and (file_on_disk->num_current_transactions > 0)) {
+            file_on_disk->num_current_transactions--;
+            if (file_on_disk->num_current_transactions == 0) {
+                this->policy->fileUnpinned(file_on_disk);
+            }
+        }
+    }
+
+}// namespace wrench
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/storage/storage_helpers/TTLCachePolicy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param ttl: the time-to-live of a file, in seconds
+     */
+    TTLCachePolicy::TTLCachePolicy(double ttl) : ttl(ttl) {
+    }
+
+    /**
+     * @brief Notify the policy that a file was written
+     * @param file_on_disk: the file's record
+     */
+    void TTLCachePolicy::fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        file_on_disk->lru_sequence_number = this->next_sequence_number++;
+        this->fifo_list.pushBack(file_on_disk);
+    }
+
+    /**
+     * @brief Notify the policy that a file was read (which does not extend its lifetime)
+     * @param file_on_disk: the file's record
+     */
+    void TTLCachePolicy::fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) {
+    }
+
+    /**
+     * @brief Notify the policy that a file is being removed
+     * @param file_on_disk: the file's record
+     */
+    void TTLCachePolicy::fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        if (file_on_disk->num_current_transactions > 0) {
+            this->pinned_list.remove(file_on_disk);
+        } else {
+            this->fifo_list.remove(file_on_disk);
+        }
+    }
+
+    /**
+     * @brief Notify the policy that a file is now involved in a running transaction
+     * @param file_on_disk: the file's record
+     */
+    void TTLCachePolicy::filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->fifo_list.remove(file_on_disk);
+        this->pinned_list.pushBack(file_on_disk);
+    }
+
+    /**
+     * @brief Notify the policy that a file is no longer involved in any running transaction
+     *        (if it has expired in the meantime, it will be the next expired file)
+     * @param file_on_disk: the file's record
+     */
+    void TTLCachePolicy::fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->pinned_list.remove(file_on_disk);
+        this->fifo_list.insertBySequenceNumber(file_on_disk);
+    }
+
+    /**
+     * @brief Get the file that should be evicted next, i.e., the oldest file
+     * @return a record, or nullptr if there is no evictable file
+     */
+    LogicalFileSystem::FileOnDisk *TTLCachePolicy::getVictim() {
+        return this->fifo_list.front();
+    }
+
+    /**
+     * @brief Notify the policy that a file is being evicted
+     * @param file_on_disk: the file's record
+     */
+    void TTLCachePolicy::fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->fifo_list.remove(file_on_disk);
+    }
+
+    /**
+     * @brief Get the total size of the files that are not pinned
+     * @return a number of bytes
+     */
+    double TTLCachePolicy::getEvictableSize() {
+        return this->fifo_list.getTotalSize();
+    }
+
+    /**
+     * @brief Get a file that has expired, if any. Since files are in write date order,
+     *        only the oldest file needs to be checked.
+     * @param date: the current date
+     * @return a record, or nullptr if no (evictable) file has expired
+     */
+    LogicalFileSystem::FileOnDisk *TTLCachePolicy::getExpiredFile(double date) {
+        auto oldest = this->fifo_list.front();
+        if (oldest and (oldest->last_write_date + this->ttl <= date)) {
+            return oldest;
+        }
+        return nullptr;
+    }
+
+}// namespace wrench
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench/services/storage/storage_helpers/TwoQueueCachePolicy.h>
+
+namespace wrench {
+
+    /**
+     * @brief Constructor
+     * @param capacity: the cache capacity in bytes
+     */
+    TwoQueueCachePolicy::TwoQueueCachePolicy(double capacity) : a1in_target_size(0.25 * capacity),
+                                                                 a1out_max_size(0.5 * capacity) {
+    }
+
+    /**
+     * @brief Put an unpinned file at the end of A1in or Am
+     * @param file_on_disk: the file's record (which must not be in any list)
+     * @param list: A1in or Am
+     */
+    void TwoQueueCachePolicy::insertInList(LogicalFileSystem::FileOnDisk *file_on_disk, LogicalFileSystem::FileOnDiskList *list) {
+        file_on_disk->lru_sequence_number = this->next_sequence_number++;
+        file_on_disk->cache_policy_data = list;
+        list->pushBack(file_on_disk);
+        if (list == &this->a1in) {
+            this->a1in_size += file_on_disk->file->getSize();
+        }
+    }
+
+    /**
+     * @brief Remove a file from whichever list it is in
+     * @param file_on_disk: the file's record
+     */
+    void TwoQueueCachePolicy::unlinkFile(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        auto list = this->getList(file_on_disk);
+        if (file_on_disk->num_current_transactions > 0) {
+            this->pinned_list.remove(file_on_disk);
+        } else {
+            list->remove(file_on_disk);
+        }
+        if (list == &this->a1in) {
+            this->a1in_size -= file_on_disk->file->getSize();
+        }
+        file_on_disk->cache_policy_data = nullptr;
+    }
+
+    /**
+     * @brief Notify the policy that a file was written: it goes to Am if it was recently
+     *        evicted from A1in, and to A1in otherwise
+     * @param file_on_disk: the file's record
+     */
+    void TwoQueueCachePolicy::fileAdded(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        if (this->a1out.remove({file_on_disk->directory_id, file_on_disk->file.get()})) {
+            this->insertInList(file_on_disk, &this->am);
+        } else {
+            this->insertInList(file_on_disk, &this->a1in);
+        }
+    }
+
+    /**
+     * @brief Notify the policy that a file was read: a file in Am becomes the most recently used,
+     *        while a file in A1in stays where it is (its accesses are deemed correlated)
+     * @param file_on_disk: the file's record
+     */
+    void TwoQueueCachePolicy::fileAccessed(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        if (this->getList(file_on_disk) != &this->am) {
+            return;
+        }
+        if (file_on_disk->num_current_transactions > 0) {
+            // It will go at the right place when unpinned
+            file_on_disk->lru_sequence_number = this->next_sequence_number++;
+        } else {
+            this->am.remove(file_on_disk);
+            this->insertInList(file_on_disk, &this->am);
+        }
+    }
+
+    /**
+     * @brief Notify the policy that a file is being removed
+     * @param file_on_disk: the file's record
+     */
+    void TwoQueueCachePolicy::fileRemoved(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->unlinkFile(file_on_disk);
+    }
+
+    /**
+     * @brief Notify the policy that a file is now involved in a running transaction
+     * @param file_on_disk: the file's record
+     */
+    void TwoQueueCachePolicy::filePinned(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->getList(file_on_disk)->remove(file_on_disk);
+        this->pinned_list.pushBack(file_on_disk);
+    }
+
+    /**
+     * @brief Notify the policy that a file is no longer involved in any running transaction
+     * @param file_on_disk: the file's record
+     */
+    void TwoQueueCachePolicy::fileUnpinned(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        this->pinned_list.remove(file_on_disk);
+        this->getList(file_on_disk)->insertBySequenceNumber(file_on_disk);
+    }
+
+    /**
+     * @brief Get the file that should be evicted next: the oldest file of A1in if A1in is
+     *        larger than its target size, otherwise the least recently used file of Am
+     * @return a record, or nullptr if there is no evictable file
+     */
+    LogicalFileSystem::FileOnDisk *TwoQueueCachePolicy::getVictim() {
+        if (this->am.empty() or ((this->a1in_size > this->a1in_target_size) and (not this->a1in.empty()))) {
+            return this->a1in.front();
+        }
+        return this->am.front();
+    }
+
+    /**
+     * @brief Notify the policy that a file is being evicted: if it was in A1in, it is remembered in A1out
+     * @param file_on_disk: the file's record
+     */
+    void TwoQueueCachePolicy::fileEvicted(LogicalFileSystem::FileOnDisk *file_on_disk) {
+        bool from_a1in = (this->getList(file_on_disk) == &this->a1in);
+        this->unlinkFile(file_on_disk);
+        if (from_a1in) {
+            this->a1out.pushBack({file_on_disk->directory_id, file_on_disk->file.get()}, file_on_disk->file->getSize());
+            while ((this->a1out.getTotalSize() > this->a1out_max_size) and (not this->a1out.empty())) {
+                this->a1out.popFront();
+            }
+        }
+    }
+
+    /**
+     * @brief Get the total size of the files that are not pinned
+     * @return a number of bytes
+     */
+    double TwoQueueCachePolicy::getEvictableSize() {
+        return this->a1in.getTotalSize() + this->am.getTotalSize();
+    }
+
+}// namespace wrench
@@ -11,32 +11,56 @@
 namespace wrench {
     namespace XRootD {
         /**
-         * @brief Check the cache for a file
-         * @param file: The file to check the cache for
-         * @return true if the file is cached and if timestamp (not implemented) is valid, false otherwise
+         * @brief Remove the entries that have expired
          */
-        bool Cache::isCached(std::shared_ptr<DataFile> file) {
+        void Cache::removeExpiredEntries() {
             double earliestAllowedTime = wrench::S4U_Simulation::getClock() - maxCacheTime;
-            auto entries = cache[file];
-            //after getting all possible cache entries, loop through them "all" and check the timestamps, removing any that fail.  If you find even 1 success, return true and stop cleaning.
-            for (auto ittr = entries.begin(); ittr != entries.end(); /*intentionaly blank*/) {
-                auto entry = *ittr;
-                if (entry.second < earliestAllowedTime) {
-                    ittr = entries.erase(ittr);
-                } else {
-                    return true;
+            while ((not expiry_queue.empty()) and (std::get<0>(expiry_queue.front()) < earliestAllowedTime)) {
+                auto const &entry = expiry_queue.front();
+                auto file_it = cache.find(std::get<1>(entry));
+                if (file_it != cache.end()) {
+                    auto location_it = file_it->second.find(std::get<2>(entry));
+                    // (the entry may have been updated since, in which case it has not expired)
+                    if ((location_it != file_it->second.end()) and (location_it->second == std::get<0>(entry))) {
+                        file_it->second.erase(location_it);
+                        statistics.num_expirations++;
+                        if (file_it->second.empty()) {
+                            cache.erase(file_it);
+                        }
+                    }
                 }
+                expiry_queue.pop_front();
             }
-            return false;
         }
+
+        /**
+         * @brief Check the cache for a file
+         * @param file: The file to check the cache for
+         * @return true if the file is cached and has not expired, false otherwise
+         */
+        bool Cache::isCached(const std::shared_ptr<DataFile> &file) {
+            removeExpiredEntries();
+            if (cache.find(file) != cache.end()) {
+                statistics.num_hits++;
+                return true;
+            } else {
+                statistics.num_misses++;
+                return false;
+            }
+        }
+
         /**
          * @brief Add a file to the cache
          * @param file: The file to add to the cache
          * @param location: The location to add to the cache
          */
         void Cache::add(const std::shared_ptr<DataFile> &file, const std::shared_ptr<FileLocation> &location) {
+            removeExpiredEntries();
             double currentSimTime = wrench::S4U_Simulation::getClock();
             cache[file][location] = currentSimTime;
+            if (maxCacheTime != std::numeric_limits<double>::infinity()) {
+                expiry_queue.emplace_back(currentSimTime, file, location);
+            }
         }
 
         /**
@@ -45,37 +69,33 @@ namespace wrench {
         * @param locations: The locations to add to the cache
         */
         void Cache::add(const std::shared_ptr<DataFile> &file, const std::set<std::shared_ptr<FileLocation>> &locations) {
-            double currentSimTime = wrench::S4U_Simulation::getClock();
             for (auto const &location: locations) {
-                cache[file][location] = currentSimTime;
+                add(file, location);
             }
         }
+
         /**
          * @brief get all valid cached copies.
          * @param file: The file to check the cache for
          * @return the set of valid cached copies.  (empty set if not found)
          */
         std::set<std::shared_ptr<FileLocation>> Cache::get(const std::shared_ptr<DataFile> &file) {
-            double earliestAllowedTime = wrench::S4U_Simulation::getClock() - maxCacheTime;
-            auto entries = cache[file];
+            removeExpiredEntries();
             std::set<std::shared_ptr<FileLocation>> ret;
-            for (auto ittr = entries.begin(); ittr != entries.end();) {// intentionally blank 3rd term
-                auto entry = *ittr;
-                if (entry.second < earliestAllowedTime) {
-                    ittr = entries.erase(ittr);
-                } else {
+            auto it = cache.find(file);
+            if (it != cache.end()) {
+                for (auto const &entry: it->second) {
                     ret.insert(entry.first);
-                    ittr++;
                 }
             }
             return ret;
+        }
 
-        } /**
+        /**
          * @brief get all valid cached copies.
          * @param file: The file to check the cache for
          * @return the set of valid cached copies.  (empty set if not found)
          */
-
         std::set<std::shared_ptr<FileLocation>> Cache::operator[](const std::shared_ptr<DataFile> &file) {
             return get(file);
         }
@@ -84,41 +104,18 @@ namespace wrench {
          * @brief remove all copies of a file from the cache
          * @param file: The file to check the cache for
          */
-
         void Cache::remove(const std::shared_ptr<DataFile> &file) {
+            // (the file's entries in the expiry queue are ignored when they reach its head)
             cache.erase(file);
         }
 
-#if 0
         /**
-         * @brief Deap Clean the cache of outdated entries.  Possibly slow, but if the cache size is getting out of hand, this can help.
-         * @param file: The file to check the cache for
+         * @brief Get the statistics of cache lookups
+         * @return the statistics
          */
-
-        void Cache::clean() {
-            double earliestAllowedTime = wrench::S4U_Simulation::getClock() - maxCacheTime;
-            //itterate all files
-            for (auto ettr = cache.begin(); ettr != cache.end();) {//intentionaly blank 3rd term
-                auto entries = ettr->second;
-                //iterate all locations
-                for (auto ittr = entries.begin(); ittr != entries.end();) {//intentionaly blank 3rd term
-                    auto entry = *ittr;
-                    //check all timestamps
-                    if (entry.second < earliestAllowedTime) {
-                        ittr = entries.erase(ittr);
-                    } else {
-                        ittr++;
-                    }
-                }
-                //remove empty files
-                if (cache[ettr->first].empty()) {
-                    ettr = cache.erase(ettr);
-                } else {
-                    ettr++;
-                }
-            }
+        Cache::Statistics Cache::getStatistics() const {
+            return statistics;
         }
-#endif
 
     }// namespace XRootD
 }// namespace wrench
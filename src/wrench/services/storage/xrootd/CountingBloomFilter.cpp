@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "wrench/services/storage/xrootd/CountingBloomFilter.h"
+
+namespace wrench {
+    namespace XRootD {
+
+        /**
+         * @brief Constructor
+         * @param num_counters: the number of counters
+         * @param num_hash_functions: the number of hash functions (i.e., of counters per element)
+         *
+         * @throw std::invalid_argument
+         */
+        CountingBloomFilter::CountingBloomFilter(unsigned long num_counters, unsigned long num_hash_functions) {
+            if ((num_counters == 0) or (num_hash_functions == 0)) {
+                throw std::invalid_argument("CountingBloomFilter::CountingBloomFilter(): The numbers of counters and of hash functions must be positive");
+            }
+            this->counters.resize(num_counters, 0);
+            this->num_hash_functions = num_hash_functions;
+        }
+
+        /**
+         * @brief Add an element (an element added n times must be removed n times)
+         * @param key: the element
+         */
+        void CountingBloomFilter::add(const std::string &key) {
+            uint64_t h1, h2;
+            hash(key, h1, h2);
+            for (unsigned long i = 0; i < this->num_hash_functions; i++) {
+                auto &counter = this->counters[this->getCounterIndex(h1, h2, i)];
+                if (counter < std::numeric_limits<uint8_t>::max()) {
+                    counter++;
+                }
+            }
+        }
+
+        /**
+         * @brief Remove an element, which must have been added
+         * @param key: the element
+         */
+        void CountingBloomFilter::remove(const std::string &key) {
+            uint64_t h1, h2;
+            hash(key, h1, h2);
+            for (unsigned long i = 0; i < this->num_hash_functions; i++) {
+                auto &counter = this->counters[this->getCounterIndex(h1, h2, i)];
+                // A saturated counter may stand for more elements than it can count, so it is left as is
+                if ((counter > 0) and (counter < std::numeric_limits<uint8_t>::max())) {
+                    counter--;
+                }
+            }
+        }
+
+        /**
+         * @brief Check whether an element may have been added
+         * @param key: the element
+         * @return false if the element is for sure not in the filter, true otherwise
+         */
+        bool CountingBloomFilter::mayContain(const std::string &key) const {
+            uint64_t h1, h2;
+            hash(key, h1, h2);
+            for (unsigned long i = 0; i < this->num_hash_functions; i++) {
+                if (this->counters[this->getCounterIndex(h1, h2, i)] == 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Get the index of the counter of an element for one of the hash functions (double hashing)
+         * @param h1: the first hash of the element
+         * @param h2: the second hash of the element
+         * @param i: the hash function index
+         * @return a counter index
+         */
+        unsigned long CountingBloomFilter::getCounterIndex(uint64_t h1, uint64_t h2, unsigned long i) const {
+            return (unsigned long) ((h1 + i * h2) % this->counters.size());
+        }
+
+        /**
+         * @brief Compute the two hashes of an element from which those of all hash functions are derived
+         * @param key: the element
+         * @param h1: the first hash
+         * @param h2: the second hash (which is odd)
+         */
+        void CountingBloomFilter::hash(const std::string &key, uint64_t &h1, uint64_t &h2) {
+            h1 = (uint64_t) std::hash<std::string>{}(key);
+            // splitmix64 finalizer, so that the second hash is not correlated to the first one
+            uint64_t z = h1 + 0x9e3779b97f4a7c15ULL;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            h2 = (z ^ (z >> 31)) | 1;
+        }
+
+    }// namespace XRootD
+}// namespace wrench
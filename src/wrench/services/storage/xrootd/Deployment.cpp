@@ -10,6 +10,10 @@
 
 #include <wrench/services/storage/xrootd/Node.h>
 #include <wrench/services/storage/xrootd/Deployment.h>
+
+#include <algorithm>
+
+#include <wrench/simgrid_S4U_util/S4U_Simulation.h>
 namespace wrench {
     namespace XRootD {
 
@@ -115,6 +119,67 @@ namespace wrench {
         std::vector<std::shared_ptr<Node>> Deployment::getFileNodes(std::shared_ptr<DataFile> file) {
             return files[file];
         }
+        /**
+        * @brief add a file location to the registry, and to the Bloom filters of the location and of its ancestors
+        * @param file: A shared pointer to the file
+        * @param location: The Node at which the file is stored
+        */
+        void Deployment::addFileLocation(const std::shared_ptr<DataFile> &file, const std::shared_ptr<Node> &location) {
+            files[file].push_back(location);
+            for (Node *node = location.get(); node != nullptr; node = node->supervisor) {
+                node->addToSubtreeFilter(file);
+                if (node->reduced) {
+                    auto &ranked = ranked_file_nodes[file][node];
+                    auto entry = std::make_pair(getRouteLatency(node, location.get()), location);
+                    ranked.insert(std::upper_bound(ranked.begin(), ranked.end(), entry,
+                                                   [](const std::pair<double, std::shared_ptr<Node>> &lhs, const std::pair<double, std::shared_ptr<Node>> &rhs) {
+                                                       return lhs.first < rhs.first;
+                                                   }),
+                                  entry);
+                }
+            }
+        }
+
+        /**
+        * @brief Meta operation to get the file server with the lowest route latency from a node among those in its subtree that have a file (in O(1) time)
+        * @param file: A shared pointer to the file to search for
+        * @param subtree_root: The node, which must run a reduced simulation
+        *
+        * @return a file server, or nullptr if no file server in the subtree has the file
+        */
+        std::shared_ptr<Node> Deployment::getBestFileNode(const std::shared_ptr<DataFile> &file, Node *subtree_root) {
+            auto it = ranked_file_nodes.find(file);
+            if (it == ranked_file_nodes.end()) {
+                return nullptr;
+            }
+            auto ranked_it = it->second.find(subtree_root);
+            if (ranked_it == it->second.end()) {
+                return nullptr;
+            }
+            return ranked_it->second.front().second;
+        }
+
+        /**
+        * @brief Get the latency of the route between the hosts of two nodes (which is computed once)
+        * @param src: The source node
+        * @param dst: The destination node
+        *
+        * @return a latency in seconds
+        */
+        double Deployment::getRouteLatency(Node *src, Node *dst) {
+            if (src == dst) {
+                return 0;
+            }
+            auto key = std::make_pair(src, dst);
+            auto it = route_latencies.find(key);
+            if (it != route_latencies.end()) {
+                return it->second;
+            }
+            double latency = S4U_Simulation::getRouteLatency(src->getHostname(), dst->getHostname());
+            route_latencies[key] = latency;
+            return latency;
+        }
+
         /**
         * @brief get the size of the XRootD federation
         *
@@ -150,7 +215,17 @@ namespace wrench {
         * @throw std::invalid_argument
         */
         void Deployment::deleteFile(const std::shared_ptr<DataFile> &file) {
-            files.erase(file);
+            auto it = files.find(file);
+            if (it == files.end()) {
+                return;
+            }
+            for (auto const &location: it->second) {
+                for (Node *node = location.get(); node != nullptr; node = node->supervisor) {
+                    node->removeFromSubtreeFilter(file);
+                }
+            }
+            files.erase(it);
+            ranked_file_nodes.erase(file);
         }
         /**
         * @brief remove a specific file location from the registry.  DOES NOT REMOVE FILE FROM SERVER
@@ -163,7 +238,41 @@ namespace wrench {
             if (file == nullptr) {
                 throw std::invalid_argument("XRootD::createFile(): The file can not be null");
             }
-            std::remove(files[file].begin(), files[file].end(), location);
+            auto it = files.find(file);
+            if (it == files.end()) {
+                return;
+            }
+            auto &locations = it->second;
+            for (auto const &l: locations) {
+                if (l == location) {
+                    for (Node *node = location.get(); node != nullptr; node = node->supervisor) {
+                        node->removeFromSubtreeFilter(file);
+                    }
+                }
+            }
+            locations.erase(std::remove(locations.begin(), locations.end(), location), locations.end());
+
+            auto ranked_it = ranked_file_nodes.find(file);
+            if (ranked_it != ranked_file_nodes.end()) {
+                for (Node *node = location.get(); node != nullptr; node = node->supervisor) {
+                    auto node_it = ranked_it->second.find(node);
+                    if (node_it == ranked_it->second.end()) {
+                        continue;
+                    }
+                    auto &ranked = node_it->second;
+                    ranked.erase(std::remove_if(ranked.begin(), ranked.end(),
+                                                [&location](const std::pair<double, std::shared_ptr<Node>> &entry) {
+                                                    return entry.second == location;
+                                                }),
+                                 ranked.end());
+                    if (ranked.empty()) {
+                        ranked_it->second.erase(node_it);
+                    }
+                }
+                if (ranked_it->second.empty()) {
+                    ranked_file_nodes.erase(ranked_it);
+                }
+            }
         }
 
     }// namespace XRootD
@@ -17,6 +17,7 @@
 #include "wrench/services/ServiceMessage.h"
 #include "wrench/services/storage/xrootd/XRootDMessage.h"
 #include "wrench/services/storage/StorageServiceMessage.h"
+#include "wrench/services/storage/storage_helpers/BulkFileOperationThread.h"
 #include "wrench/services/storage/xrootd/SearchStack.h"
 #include <wrench/services/storage/xrootd/XRootDProperty.h>
 #include <wrench/exceptions/ExecutionException.h>
@@ -44,7 +45,6 @@ namespace wrench {
                     "XRootD Node " + this->getName() + "  starting on host " + this->getHostname();
             WRENCH_INFO("%s",
                         message.c_str());
-            reduced = getPropertyValueAsBoolean(Property::REDUCED_SIMULATION);
             /** Main loop **/
             while (this->processNextMessage()) {
             }
@@ -307,8 +307,7 @@ namespace wrench {
                             if (reduced) {
                                 WRENCH_DEBUG("Starting advanced lookup for %s", file->getID().c_str());
 
-                                auto targets = metavisor->getFileNodes(file);
-                                auto search_stack = constructFileSearchTree(targets);
+                                auto search_stack = constructBestFileSearchTree(file);
                                 map<Node *, vector<stack<Node *>>> splitStacks = splitStack(search_stack);
                                 WRENCH_DEBUG("Searching %zu subtrees for %s", search_stack.size(), file->getID().c_str());
                                 S4U_Simulation::compute(this->getPropertyValueAsDouble(Property::SEARCH_BROADCAST_OVERHEAD));
@@ -335,6 +334,9 @@ namespace wrench {
 
 
                                 for (auto child: children) {
+                                    if (not child->mayHaveFileInSubtree(file)) {
+                                        continue;
+                                    }
                                     S4U_Mailbox::dputMessage(child->mailbox,
                                                              new ContinueSearchMessage(
                                                                      msg->answer_mailbox,
@@ -407,8 +409,7 @@ namespace wrench {
                             if (reduced) {
                                 WRENCH_DEBUG("Starting advanced search for %s", file->getID().c_str());
 
-                                auto targets = metavisor->getFileNodes(file);
-                                auto search_stack = constructFileSearchTree(targets);
+                                auto search_stack = constructBestFileSearchTree(file);
                                 map<Node *, vector<stack<Node *>>> splitStacks = splitStack(search_stack);
                                 WRENCH_DEBUG("Searching %zu subtrees for %s", search_stack.size(), file->getID().c_str());
                                 S4U_Simulation::compute(this->getPropertyValueAsDouble(Property::SEARCH_BROADCAST_OVERHEAD));
@@ -433,6 +434,9 @@ namespace wrench {
                             } else {//shotgun continued search message to all children
                                 WRENCH_DEBUG("Starting basic search for %s", file->getID().c_str());
                                 for (auto child: children) {
+                                    if (not child->mayHaveFileInSubtree(file)) {
+                                        continue;
+                                    }
                                     S4U_Mailbox::dputMessage(child->mailbox,
                                                              new ContinueSearchMessage(
                                                                      msg->answer_mailbox,
@@ -504,6 +508,9 @@ namespace wrench {
                             S4U_Simulation::compute(
                                     this->getPropertyValueAsDouble(Property::SEARCH_BROADCAST_OVERHEAD));
                             for (auto child: children) {
+                                if (not child->mayHaveFileInSubtree(msg->file)) {
+                                    continue;
+                                }
                                 S4U_Mailbox::dputMessage(child->mailbox,
                                                          new ContinueSearchMessage(msg));
                             }
@@ -552,50 +559,112 @@ namespace wrench {
 
                 return true;
 
-            } else if (auto msg = dynamic_cast<StorageServiceFileDeleteRequestMessage *>(message.get())) {
-                if (reduced) {//TODO use optimised search
-
-                    shared_ptr<bool> answered = make_shared<bool>(false);
-                    auto targets = metavisor->getFileNodes(msg->location->getFile());
-                    auto search_stack = constructFileSearchTree(targets);
-                    map<Node *, vector<stack<Node *>>> splitStacks = splitStack(search_stack);
-                    S4U_Simulation::compute(this->getPropertyValueAsDouble(Property::SEARCH_BROADCAST_OVERHEAD));
-                    for (auto entry: splitStacks) {
-                        if (entry.first == this) {//this node was the target
-                            //we shouldn't have to worry about this, it should have been handled earlier.
-                            // But just in case, I don't want a rogue search going who knows where
-                        } else {
-                            S4U_Mailbox::dputMessage(entry.first->mailbox,
-                                                     new AdvancedRippleDelete(
-                                                             msg,
-                                                             metavisor->defaultTimeToLive,
-                                                             entry.second));
+            } else if (auto msg = dynamic_cast<ContinueBulkSearchMessage *>(message.get())) {
+                WRENCH_DEBUG("Continuing Bulk Search for %zu files", msg->files.size());
+                S4U_Simulation::compute((double) msg->files.size() * this->getPropertyValueAsDouble(Property::CACHE_LOOKUP_OVERHEAD));
+                std::map<std::shared_ptr<DataFile>, std::set<std::shared_ptr<FileLocation>>> found;
+                unsigned long num_locations = 0;
+                std::vector<std::shared_ptr<DataFile>> files_to_search;
+                for (auto const &file: msg->files) {
+                    if (cached(file)) {//File Cached
+                        auto cached = getCached(file);
+                        num_locations += cached.size();
+                        found[file] = cached;
+                    } else if (internalStorage && internalStorage->hasFile(file)) {//File in internal storage
+                        auto location = FileLocation::LOCATION(internalStorage, file);
+                        cache.add(file, location);
+                        num_locations++;
+                        found[file] = {location};
+                    } else {
+                        files_to_search.push_back(file);
+                    }
+                }
+                // All the files found in this node are reported in a single cache update
+                if (not found.empty()) {
+                    S4U_Mailbox::dputMessage(supervisor->mailbox,
+                                             new UpdateBulkCacheMessage(
+                                                     msg->search,
+                                                     msg->node,
+                                                     found,
+                                                     getMessagePayloadValue(MessagePayload::UPDATE_CACHE) +
+                                                             getMessagePayloadValue(MessagePayload::CACHE_ENTRY) * (double) num_locations));
+                }
+                if ((not files_to_search.empty()) and (not children.empty()) and (msg->timeToLive > 0)) {
+                    this->broadcastBulkSearch(msg->search, files_to_search, msg->node, msg->timeToLive - 1);
+                } else {
+                    //this is a leaf that just didn't have the files.  XRootD protocol is to silently fail in this case.  Do not respond
+                }
+                return true;
+            } else if (auto msg = dynamic_cast<UpdateBulkCacheMessage *>(message.get())) {
+                WRENCH_DEBUG("Updating Cache after finding %zu files", msg->locations.size());
+                S4U_Simulation::compute((double) msg->locations.size() * this->getPropertyValueAsDouble(Property::UPDATE_CACHE_OVERHEAD));
+                for (auto const &entry: msg->locations) {
+                    cache.add(entry.first, entry.second);
+                }
+                if (this != msg->node && supervisor) {
+                    WRENCH_DEBUG("Forward update to super");
+                    S4U_Mailbox::dputMessage(supervisor->mailbox, new UpdateBulkCacheMessage(msg));
+                } else if (not msg->search->answered) {
+                    WRENCH_DEBUG("Update has reached top of subtree");
+                    auto &pending_files = msg->search->pending_files;
+                    for (auto const &entry: msg->locations) {
+                        auto it = pending_files.find(entry.first);
+                        if (it != pending_files.end()) {
+                            for (auto i: it->second) {
+                                msg->search->files_are_available[i] = true;
+                            }
+                            pending_files.erase(it);
                         }
                     }
-                    S4U_Mailbox::dputMessage(msg->answer_mailbox,
-                                             new StorageServiceFileDeleteAnswerMessage(
-                                                     msg->location->getFile(),
-                                                     getSharedPtr<Node>(),
-                                                     true,
-                                                     nullptr,
-                                                     getMessagePayloadValue(StorageServiceMessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD))
-
-                    );
+                    if (pending_files.empty()) {
+                        this->answerBulkSearch(msg->search);
+                    }
+                }
+                return true;
+            } else if (auto msg = dynamic_cast<BulkFileNotFoundAlarm *>(message.get())) {
+                if (not msg->search->answered) {
+                    this->answerBulkSearch(msg->search);
+                }
+                return true;
+            } else if (auto msg = dynamic_cast<StorageServiceFileDeleteRequestMessage *>(message.get())) {
+                this->startFileDeletion(msg->location->getFile(), msg->payload);
+                S4U_Mailbox::dputMessage(msg->answer_mailbox,
+                                         new StorageServiceFileDeleteAnswerMessage(
+                                                 msg->location->getFile(),
+                                                 this->getSharedPtr<Node>(),
+                                                 true,
+                                                 nullptr,
+                                                 getMessagePayloadValue(
+                                                         MessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+                return true;
+            } else if (auto msg = dynamic_cast<StorageServiceBulkFileDeleteRequestMessage *>(message.get())) {
+                // Deletions are started for all files, and (as for single deletions) the answer does not wait for them
+                double payload_per_file = msg->locations.empty() ? 0 : msg->payload / (double) msg->locations.size();
+                for (auto const &location: msg->locations) {
+                    this->startFileDeletion(location->getFile(), payload_per_file);
+                }
+                S4U_Mailbox::dputMessage(msg->answer_mailbox,
+                                         new StorageServiceBulkFileDeleteAnswerMessage(
+                                                 std::vector<std::shared_ptr<FailureCause>>(msg->locations.size(), nullptr),
+                                                 (double) msg->locations.size() *
+                                                         getMessagePayloadValue(MessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+                return true;
+            } else if (auto msg = dynamic_cast<StorageServiceBulkFileLookupRequestMessage *>(message.get())) {
+                return this->processBulkFileLookupRequest(msg);
+            } else if (auto msg = dynamic_cast<StorageServiceFreeSpaceRequestMessage *>(message.get())) {
+                if (internalStorage) {// The internal storage answers the client directly
+                    S4U_Mailbox::dputMessage(internalStorage->mailbox,
+                                             new StorageServiceFreeSpaceRequestMessage(
+                                                     msg->answer_mailbox,
+                                                     internalStorage->getMessagePayloadValue(
+                                                             StorageServiceMessagePayload::FREE_SPACE_REQUEST_MESSAGE_PAYLOAD)));
                 } else {
-                    S4U_Mailbox::dputMessage(this->mailbox, new RippleDelete(msg, metavisor->defaultTimeToLive));
-
-
                     S4U_Mailbox::dputMessage(msg->answer_mailbox,
-                                             new StorageServiceFileDeleteAnswerMessage(
-                                                     msg->location->getFile(),
-                                                     this->getSharedPtr<Node>(),
-                                                     true,
-                                                     nullptr,
+                                             new StorageServiceFreeSpaceAnswerMessage(
+                                                     {},
                                                      getMessagePayloadValue(
-                                                             MessagePayload::FILE_DELETE_ANSWER_MESSAGE_PAYLOAD)));
+                                                             MessagePayload::FREE_SPACE_ANSWER_MESSAGE_PAYLOAD)));
                 }
-
-                metavisor->deleteFile(msg->location->getFile());
                 return true;
             } else if (auto msg = dynamic_cast<RippleDelete *>(message.get())) {
                 S4U_Simulation::compute(this->getPropertyValueAsDouble(Property::UPDATE_CACHE_OVERHEAD));
@@ -678,6 +747,146 @@ namespace wrench {
             }
             return true;
         }
+        /**
+         * @brief Start the deletion of a file from the subtree (the deletion then proceeds asynchronously)
+         * @param file: the file
+         * @param payload: the message size in bytes of the messages that propagate the deletion
+         */
+        void Node::startFileDeletion(const std::shared_ptr<DataFile> &file, double payload) {
+            if (reduced) {//TODO use optimised search
+                auto targets = metavisor->getFileNodes(file);
+                auto search_stack = constructFileSearchTree(targets);
+                map<Node *, vector<stack<Node *>>> splitStacks = splitStack(search_stack);
+                S4U_Simulation::compute(this->getPropertyValueAsDouble(Property::SEARCH_BROADCAST_OVERHEAD));
+                for (auto entry: splitStacks) {
+                    if (entry.first == this) {//this node was the target
+                        //we shouldn't have to worry about this, it should have been handled earlier.
+                        // But just in case, I don't want a rogue search going who knows where
+                    } else {
+                        S4U_Mailbox::dputMessage(entry.first->mailbox,
+                                                 new AdvancedRippleDelete(
+                                                         file,
+                                                         payload,
+                                                         metavisor->defaultTimeToLive,
+                                                         entry.second));
+                    }
+                }
+            } else {
+                S4U_Mailbox::dputMessage(this->mailbox, new RippleDelete(file, payload, metavisor->defaultTimeToLive));
+            }
+
+            metavisor->deleteFile(file);
+        }
+
+        /**
+         * @brief Process a bulk file lookup request. Files that are cached or in the internal storage are
+         *        answered right away. If some files require a search, a single aggregated search for all of them
+         *        is sent down the tree (in a reduced simulation, single-file lookups (to this node) are
+         *        instead issued for all files by a helper), and a single answer is sent back to the client.
+         * @param msg: the request
+         * @return true if this process should keep running
+         */
+        bool Node::processBulkFileLookupRequest(StorageServiceBulkFileLookupRequestMessage *msg) {
+            S4U_Simulation::compute((double) msg->locations.size() * this->getPropertyValueAsDouble(Property::CACHE_LOOKUP_OVERHEAD));
+
+            auto self = this->getSharedPtr<Node>();
+            bool search_needed = false;
+            std::vector<bool> files_are_available;
+            std::vector<std::vector<std::shared_ptr<FileLocation>>> sub_locations;
+            for (auto const &location: msg->locations) {
+                auto file = location->getFile();
+                bool available = cached(file) or (internalStorage and internalStorage->hasFile(file));
+                files_are_available.push_back(available);
+                sub_locations.emplace_back();
+                if (available or (not children.empty())) {
+                    sub_locations.back().push_back(FileLocation::LOCATION(self, file));
+                    search_needed = search_needed or (not available);
+                }
+            }
+
+            if (not search_needed) {
+                S4U_Mailbox::dputMessage(msg->answer_mailbox,
+                                         new StorageServiceBulkFileLookupAnswerMessage(
+                                                 files_are_available,
+                                                 (double) msg->locations.size() *
+                                                         getMessagePayloadValue(MessagePayload::FILE_LOOKUP_ANSWER_MESSAGE_PAYLOAD)));
+                return true;
+            }
+
+            if (reduced) {
+                auto thread = std::make_shared<BulkFileOperationThread>(
+                        this->getHostname(),
+                        self,
+                        BulkFileOperationThread::LOOKUP,
+                        msg->locations,
+                        sub_locations,
+                        true,
+                        msg->answer_mailbox);
+                thread->setSimulation(this->simulation);
+                thread->start(thread, true, false);// Daemonize, non-auto-restart
+                return true;
+            }
+
+            WRENCH_DEBUG("Starting bulk lookup for %zu files", msg->locations.size());
+            auto search = std::make_shared<BulkSearch>();
+            search->answer_mailbox = msg->answer_mailbox;
+            search->files_are_available = files_are_available;
+            std::vector<std::shared_ptr<DataFile>> files_to_search;
+            for (size_t i = 0; i < msg->locations.size(); i++) {
+                if (not files_are_available[i]) {
+                    auto file = msg->locations[i]->getFile();
+                    auto &indices = search->pending_files[file];
+                    if (indices.empty()) {
+                        files_to_search.push_back(file);
+                    }
+                    indices.push_back(i);
+                }
+            }
+            Alarm::createAndStartAlarm(this->simulation, wrench::S4U_Simulation::getClock() + this->getPropertyValueAsTimeInSecond(Property::FILE_NOT_FOUND_TIMEOUT), this->hostname, this->mailbox,
+                                       new BulkFileNotFoundAlarm(search), "XROOTD_BulkFileNotFoundAlarm");
+            this->broadcastBulkSearch(search, files_to_search, this, metavisor->defaultTimeToLive);
+            return true;
+        }
+
+        /**
+         * @brief Send an aggregated search to the children, each child being sent the files that may be in its subtree
+         * @param search: the state of the search
+         * @param files: the files to search for
+         * @param node: the node where the search was initiated
+         * @param timeToLive: the max number of hops the messages can take
+         */
+        void Node::broadcastBulkSearch(const std::shared_ptr<BulkSearch> &search, const std::vector<std::shared_ptr<DataFile>> &files,
+                                       Node *node, int timeToLive) {
+            S4U_Simulation::compute(this->getPropertyValueAsDouble(Property::SEARCH_BROADCAST_OVERHEAD));
+            for (auto const &child: children) {
+                std::vector<std::shared_ptr<DataFile>> child_files;
+                for (auto const &file: files) {
+                    if (child->mayHaveFileInSubtree(file)) {
+                        child_files.push_back(file);
+                    }
+                }
+                if (child_files.empty()) {
+                    continue;
+                }
+                double payload = getMessagePayloadValue(MessagePayload::CONTINUE_SEARCH) * (double) child_files.size();
+                S4U_Mailbox::dputMessage(child->mailbox,
+                                         new ContinueBulkSearchMessage(search, std::move(child_files), node, payload, timeToLive));
+            }
+        }
+
+        /**
+         * @brief Send the answer of an aggregated search to the client (the files that have not been found are not available)
+         * @param search: the state of the search
+         */
+        void Node::answerBulkSearch(const std::shared_ptr<BulkSearch> &search) {
+            search->answered = true;
+            S4U_Mailbox::dputMessage(search->answer_mailbox,
+                                     new StorageServiceBulkFileLookupAnswerMessage(
+                                             search->files_are_available,
+                                             (double) search->files_are_available.size() *
+                                                     getMessagePayloadValue(MessagePayload::FILE_LOOKUP_ANSWER_MESSAGE_PAYLOAD)));
+        }
+
         /**
         * @brief Select the best file server to read from based on current load
         * @param locations: All locations to consider for file read
@@ -746,6 +955,52 @@ namespace wrench {
             return cache[file];
         }
 
+        /**
+        * @brief Get the statistics of the lookups in this node's cache
+        * @return the numbers of hits, misses, and expired cache entries
+        */
+        Cache::Statistics Node::getCacheLookupStatistics() {
+            return cache.getStatistics();
+        }
+
+
+        /**
+        * @brief Add a file to the Bloom filter of the files in this node's subtree, if it has one (in zero simulated time)
+        * @param file: The file
+        */
+        void Node::addToSubtreeFilter(const std::shared_ptr<DataFile> &file) {
+            if (not this->use_bloom_filter) {
+                return;
+            }
+            if (not this->subtree_filter) {// The filter is only allocated once something is in the subtree
+                this->subtree_filter = std::unique_ptr<CountingBloomFilter>(
+                        new CountingBloomFilter(getPropertyValueAsUnsignedLong(Property::BLOOM_FILTER_NUM_COUNTERS),
+                                                getPropertyValueAsUnsignedLong(Property::BLOOM_FILTER_NUM_HASH_FUNCTIONS)));
+            }
+            this->subtree_filter->add(file->getID());
+        }
+
+        /**
+        * @brief Remove a file from the Bloom filter of the files in this node's subtree, if it has one (in zero simulated time)
+        * @param file: The file, which must have been added to the filter
+        */
+        void Node::removeFromSubtreeFilter(const std::shared_ptr<DataFile> &file) {
+            if (this->subtree_filter) {
+                this->subtree_filter->remove(file->getID());
+            }
+        }
+
+        /**
+        * @brief Check whether a file may be in this node's subtree, according to its Bloom filter (in zero simulated time)
+        * @param file: The file
+        * @return false if the node uses a Bloom filter and the file is for sure not in its subtree, true otherwise
+        */
+        bool Node::mayHaveFileInSubtree(const std::shared_ptr<DataFile> &file) {
+            if (not this->use_bloom_filter) {
+                return true;
+            }
+            return this->subtree_filter and this->subtree_filter->mayContain(file->getID());
+        }
 
         /**
         * @brief Makes this node a supervisor.  Since there is nothing special about a supervisor, this cant fail and does nothing
@@ -774,6 +1029,14 @@ namespace wrench {
             this->setProperties(this->default_property_values, property_list);
             setMessagePayloads(default_messagepayload_values, messagepayload_list);
             cache.maxCacheTime = getPropertyValueAsTimeInSecond(Property::CACHE_MAX_LIFETIME);
+            this->reduced = getPropertyValueAsBoolean(Property::REDUCED_SIMULATION);
+            this->use_bloom_filter = getPropertyValueAsBoolean(Property::SEARCH_WITH_BLOOM_FILTERS);
+            if (this->use_bloom_filter) {
+                if ((getPropertyValueAsUnsignedLong(Property::BLOOM_FILTER_NUM_COUNTERS) == 0) or
+                    (getPropertyValueAsUnsignedLong(Property::BLOOM_FILTER_NUM_HASH_FUNCTIONS) == 0)) {
+                    throw std::invalid_argument("Node::Node(): Invalid Bloom filter property values (numbers of counters and of hash functions must be positive)");
+                }
+            }
             this->deployment = deployment;
             this->buffer_size = DBL_MAX;// Not used, but letting it be zero will raise unwanted exception since
             // clients "think" that they're talking to a real storage service
@@ -876,6 +1139,21 @@ namespace wrench {
             return ret;
         }
         /**
+        * @brief construct the path to the file server with the lowest route latency among those in the subtree that have a file
+        *        (in O(depth) time, using the deployment's index of file locations)
+        * @param file: The file to search for
+        *
+        * @returns the path to that file server if there is one, and no path otherwise.
+        */
+        vector<stack<Node *>> Node::constructBestFileSearchTree(const std::shared_ptr<DataFile> &file) {
+            vector<stack<Node *>> ret;
+            auto best = metavisor->getBestFileNode(file, this);
+            if (best) {
+                ret.push_back(constructSearchStack(best.get()));
+            }
+            return ret;
+        }
+        /**
         * @brief construct the path to a targets IF it is in the subtree
         * @param target: The node to search for
         *
@@ -906,7 +1184,7 @@ namespace wrench {
                 throw std::runtime_error("Node::createFile() called on non storage Node " + hostname);
             }
 
-            metavisor->files[file].push_back(this->getSharedPtr<Node>());
+            metavisor->addFileLocation(file, this->getSharedPtr<Node>());
             internalStorage->createFile(file);
         }
         /**
@@ -922,7 +1200,7 @@ namespace wrench {
 
             internalStorage->createFile(location);
 
-            metavisor->files[location->getFile()].push_back(this->getSharedPtr<Node>());
+            metavisor->addFileLocation(location->getFile(), this->getSharedPtr<Node>());
         }
         /**
         * @brief create a new file in the federation on this node.  Use instead of wrench::Simulation::createFile when adding files to XRootD
@@ -936,7 +1214,7 @@ namespace wrench {
                 throw std::runtime_error("Node::createFile() called on non storage Node " + hostname);
             }
             internalStorage->createFile(file, path);
-            metavisor->files[file].push_back(this->getSharedPtr<Node>());
+            metavisor->addFileLocation(file, this->getSharedPtr<Node>());
         }
 
         /**
@@ -953,7 +1231,7 @@ namespace wrench {
                                 new NotAllowed(getSharedPtr<Node>(), error_message)));
             }
             internalStorage->writeFile(file);
-            metavisor->files[file].push_back(this->getSharedPtr<Node>());
+            metavisor->addFileLocation(file, this->getSharedPtr<Node>());
         }
 
 
@@ -1003,6 +1281,9 @@ namespace wrench {
                 return internalStorage->hasFile(file, path);
             //return false;//no internal storage here, so I dont have any files.  But I am pretending to have some, so its reasonable to ask.
             //alternativly
+            if (reduced) {
+                return metavisor->getBestFileNode(file, this) != nullptr;
+            }
             return !constructFileSearchTree(metavisor->getFileNodes(file)).empty();//meta search the subtree for the file.  If its in the subtree we can find a route to it, so we have it
         }
 
@@ -158,5 +158,43 @@ namespace wrench {
          * @param search_stack:  The available paths to the file
          */
         AdvancedRippleDelete::AdvancedRippleDelete(StorageServiceFileDeleteRequestMessage *other, int timeToLive, std::vector<std::stack<Node *>> search_stack) : RippleDelete(other, timeToLive), search_stack(search_stack){};
+
+        /**
+         * @brief Constructor
+         * @param search: The state of the search, shared by all messages of the search
+         * @param files: The files to search for in the subtree of the receiving node
+         * @param node: The node where the search was initiated
+         * @param payload: The message size in bytes
+         * @param timeToLive: The max number of hops this message can take
+         */
+        ContinueBulkSearchMessage::ContinueBulkSearchMessage(std::shared_ptr<BulkSearch> search,
+                                                             std::vector<std::shared_ptr<DataFile>> files,
+                                                             Node *node,
+                                                             double payload,
+                                                             int timeToLive) : Message(payload), search(std::move(search)), files(std::move(files)), node(node), timeToLive(timeToLive) {}
+
+        /**
+         * @brief Constructor
+         * @param search: The state of the search, shared by all messages of the search
+         * @param node: The node where the search was initiated
+         * @param locations: The locations found in this subtree, for each file found
+         * @param payload: The message size in bytes
+         */
+        UpdateBulkCacheMessage::UpdateBulkCacheMessage(std::shared_ptr<BulkSearch> search,
+                                                       Node *node,
+                                                       std::map<std::shared_ptr<DataFile>, std::set<std::shared_ptr<FileLocation>>> locations,
+                                                       double payload) : Message(payload), search(std::move(search)), node(node), locations(std::move(locations)) {}
+
+        /**
+        * @brief Pointer Copy Constructor
+        * @param other: The message to copy.
+        */
+        UpdateBulkCacheMessage::UpdateBulkCacheMessage(UpdateBulkCacheMessage *other) : Message(other->payload), search(other->search), node(other->node), locations(other->locations) {}
+
+        /**
+         * @brief Constructor
+         * @param search: The state of the search
+         */
+        BulkFileNotFoundAlarm::BulkFileNotFoundAlarm(std::shared_ptr<BulkSearch> search) : Message(0), search(std::move(search)) {}
     }// namespace XRootD
 };   // namespace wrench
@@ -9,6 +9,9 @@ namespace wrench {
         SET_PROPERTY_NAME(Property, CACHE_MAX_LIFETIME);
         SET_PROPERTY_NAME(Property, REDUCED_SIMULATION);
         SET_PROPERTY_NAME(Property, FILE_NOT_FOUND_TIMEOUT);
+        SET_PROPERTY_NAME(Property, SEARCH_WITH_BLOOM_FILTERS);
+        SET_PROPERTY_NAME(Property, BLOOM_FILTER_NUM_COUNTERS);
+        SET_PROPERTY_NAME(Property, BLOOM_FILTER_NUM_HASH_FUNCTIONS);
 
     }// namespace XRootD
 }// namespace wrench
\ No newline at end of file
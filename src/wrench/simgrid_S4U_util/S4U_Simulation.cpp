@@ -1035,6 +1035,32 @@ namespace wrench {
         return to_return;
     }
 
+    /**
+     * @brief Get the latency of the route between two hosts
+     * @param src_host: src hostname
+     * @param dst_host: dst hostname
+     * @return a latency in seconds
+     *
+     * @throw std::invalid_argument
+     */
+    double S4U_Simulation::getRouteLatency(const std::string &src_host, const std::string &dst_host) {
+        simgrid::s4u::Host *src, *dst;
+        try {
+            src = S4U_Simulation::get_host_or_vm_by_name(src_host);
+        } catch (std::exception &e) {
+            throw std::invalid_argument("S4U_Simulation::getRouteLatency(): Unknown host " + src_host);
+        }
+        try {
+            dst = S4U_Simulation::get_host_or_vm_by_name(dst_host);
+        } catch (std::exception &e) {
+            throw std::invalid_argument("S4U_Simulation::getRouteLatency(): Unknown host " + dst_host);
+        }
+        std::vector<simgrid::s4u::Link *> links;
+        double latency = 0;
+        src->route_to(dst, links, &latency);
+        return latency;
+    }
+
 
     /**
 * @brief Gets the capacity of a disk attached to some host for a given mount point
@@ -39,6 +39,10 @@ namespace wrench {
     bool Simulation::host_shutdown_enabled = false;
     bool Simulation::link_shutdown_enabled = false;
     bool Simulation::pagecache_enabled = false;
+    unsigned long Simulation::pagecache_max_extents_per_file = 0;
+    double Simulation::pagecache_readahead_initial_window = 128 * 1024;
+    double Simulation::pagecache_readahead_max_window = 0;
+    unsigned long Simulation::pagecache_log_max_num_samples = 10000;
     bool Simulation::surf_precision_set_by_user = false;
 
     bool Simulation::initialized = false;
@@ -84,6 +88,7 @@ namespace wrench {
     Simulation::~Simulation() {
         this->s4u_simulation->shutdown();
         this->compute_services.clear();
+        this->compute_services_by_host.clear();
     }
 
     /**
@@ -115,6 +120,23 @@ namespace wrench {
         bool version_requested = false;
         bool mailbox_pool_size_set = false;
 
+        // Parser for arguments of the form --xxx=<integer>
+        auto parse_integer_argument = [](const char *arg, const std::string &name) {
+            const char *equal_sign = strchr(arg, '=');
+            if (!equal_sign) {
+                throw std::invalid_argument("Invalid " + name + " argument value");
+            }
+            // Check that the value is all digits
+            const char *ptr = equal_sign + 1;
+            while (*ptr) {
+                if (*ptr < '0' or *ptr > '9') {
+                    throw std::invalid_argument("Invalid " + name + " argument value");
+                }
+                ptr++;
+            }
+            return strtoul(equal_sign + 1, nullptr, 10);
+        };
+
         // By  default, logs are disabled
         xbt_log_control_set("root.thresh:critical");
 
@@ -170,6 +192,17 @@ namespace wrench {
                 version_requested = true;
             } else if (not strcmp(argv[i], "--wrench-pagecache-simulation")) {
                 Simulation::pagecache_enabled = true;
+            } else if (not strncmp(argv[i], "--wrench-pagecache-max-extents-per-file", strlen("--wrench-pagecache-max-extents-per-file"))) {
+                Simulation::pagecache_max_extents_per_file = parse_integer_argument(argv[i], "--wrench-pagecache-max-extents-per-file");
+            } else if (not strncmp(argv[i], "--wrench-pagecache-readahead-initial-window", strlen("--wrench-pagecache-readahead-initial-window"))) {
+                Simulation::pagecache_readahead_initial_window = (double) parse_integer_argument(argv[i], "--wrench-pagecache-readahead-initial-window");
+            } else if (not strncmp(argv[i], "--wrench-pagecache-readahead-max-window", strlen("--wrench-pagecache-readahead-max-window"))) {
+                Simulation::pagecache_readahead_max_window = (double) parse_integer_argument(argv[i], "--wrench-pagecache-readahead-max-window");
+            } else if (not strncmp(argv[i], "--wrench-pagecache-log-size", strlen("--wrench-pagecache-log-size"))) {
+                Simulation::pagecache_log_max_num_samples = parse_integer_argument(argv[i], "--wrench-pagecache-log-size");
+                if (Simulation::pagecache_log_max_num_samples < 2) {
+                    throw std::invalid_argument("Invalid --wrench-pagecache-log-size argument value (must be >= 2)");
+                }
             } else {
                 cleanedup_args.emplace_back(argv[i]);
             }
@@ -218,6 +251,15 @@ namespace wrench {
             std::cout
                     << "                requires that all hosts in the platform have a disk mounted at '/memory' that )\n";
             std::cout << "                acts as additional RAM that can only be used for caching file pages)\n";
+            std::cout << "   --wrench-pagecache-max-extents-per-file=<integer>: set the maximum number of cached extents per file\n";
+            std::cout << "                in the page cache simulation, beyond which new data is merged into existing extents\n";
+            std::cout << "                (default: 0, i.e., no maximum)\n";
+            std::cout << "   --wrench-pagecache-readahead-max-window=<integer>: enable sequential readahead in the page cache simulation,\n";
+            std::cout << "                with a readahead window of at most that many bytes (default: 0, i.e., no readahead)\n";
+            std::cout << "   --wrench-pagecache-readahead-initial-window=<integer>: set the initial readahead window in bytes, which\n";
+            std::cout << "                doubles on each sequential read up to the maximum (default: 131072)\n";
+            std::cout << "   --wrench-pagecache-log-size=<integer>: set the maximum number of samples in the page cache log of\n";
+            std::cout << "                each host, beyond which samples are merged (keeping peak usage) (default: 10000)\n";
             std::cout << "   --wrench-no-color: disables colored terminal output\n";
             std::cout << "   --wrench-full-log: enables full logging\n";
             std::cout << "     (use --log=xxx.threshold=info to enable log category xxxx)\n";
@@ -423,6 +465,38 @@ namespace wrench {
         return Simulation::pagecache_enabled;
     }
 
+    /**
+     * @brief Method to get the maximum number of cached extents per file in the page cache simulation
+     * @return a number of extents (0 means no maximum)
+     */
+    unsigned long Simulation::getPageCacheMaxExtentsPerFile() {
+        return Simulation::pagecache_max_extents_per_file;
+    }
+
+    /**
+     * @brief Method to get the initial readahead window in the page cache simulation
+     * @return a number of bytes (never more than the maximum readahead window)
+     */
+    double Simulation::getPageCacheReadaheadInitialWindow() {
+        return std::min<double>(Simulation::pagecache_readahead_initial_window, Simulation::pagecache_readahead_max_window);
+    }
+
+    /**
+     * @brief Method to get the maximum readahead window in the page cache simulation
+     * @return a number of bytes (0 means that there is no readahead)
+     */
+    double Simulation::getPageCacheReadaheadMaxWindow() {
+        return Simulation::pagecache_readahead_max_window;
+    }
+
+    /**
+     * @brief Method to get the maximum number of samples in the page cache log of a host
+     * @return a number of samples
+     */
+    unsigned long Simulation::getPageCacheLogMaxNumSamples() {
+        return Simulation::pagecache_log_max_num_samples;
+    }
+
     /**
      * @brief Method to check if host shutdown simulation is activated
      * @return true or false
@@ -616,7 +690,9 @@ namespace wrench {
             throw std::invalid_argument("Simulation::addService(): invalid argument (nullptr service)");
         }
         service->simulation = this;
-        this->compute_services.insert(service);
+        if (this->compute_services.insert(service).second) {
+            this->compute_services_by_host[service->getHostname()].push_back(service);
+        }
     }
 
     /**
@@ -646,7 +722,9 @@ namespace wrench {
             throw std::invalid_argument("Simulation::addService(): invalid argument (nullptr service)");
         }
         service->simulation = this;
-        this->storage_services.insert(service);
+        if (this->storage_services.insert(service).second) {
+            this->storage_services_by_host[service->getHostname()].push_back(service);
+        }
     }
 
     /**
@@ -721,7 +799,9 @@ namespace wrench {
             throw std::invalid_argument("Simulation::addService(): invalid argument (nullptr memory_manager)");
         }
         memory_manager->simulation = this;
-        this->memory_managers.insert(memory_manager);
+        if (this->memory_managers.insert(memory_manager).second) {
+            this->memory_managers_by_host.insert(std::make_pair(memory_manager->getHostname(), memory_manager.get()));
+        }
     }
 
     /**
@@ -901,8 +981,9 @@ namespace wrench {
      * @param file: workflow file
      * @param n_bytes: number of read bytes
      * @param location: file location
+     * @param offset: the offset of the read in the file, if known (used to detect sequential reads for readahead), or -1
      */
-    void Simulation::readWithMemoryCache(const std::shared_ptr<DataFile> &file, double n_bytes, const std::shared_ptr<FileLocation> &location) {
+    void Simulation::readWithMemoryCache(const std::shared_ptr<DataFile> &file, double n_bytes, const std::shared_ptr<FileLocation> &location, double offset) {
         std::string hostname = getHostName();
 
         unique_disk_sequence_number += 1;
@@ -911,13 +992,11 @@ namespace wrench {
                                                     temp_unique_sequence_number);
 
         auto mem_mng = getMemoryManagerByHost(hostname);
-        std::vector<Block *> file_blocks = mem_mng->getCachedBlocks(file->getID());
-        long cached_amt = 0;
-        for (auto &file_block: file_blocks) {
-            cached_amt += (long) (file_block->getSize());
-        }
+        // Data that was read ahead is read from cache (once its read is complete)
+        double from_readahead = mem_mng->readFromReadahead(file->getID(), offset, n_bytes);
+        double cached_amt = mem_mng->getCachedAmount(file->getID());
 
-        double from_disk = std::min(n_bytes, file->getSize() - (double) cached_amt);
+        double from_disk = std::min(n_bytes - from_readahead, file->getSize() - cached_amt);
         double from_cache = n_bytes - from_disk;
 
         mem_mng->flush(n_bytes + from_disk - mem_mng->getFreeMemory() - mem_mng->getEvictableMemory(),
@@ -934,6 +1013,8 @@ namespace wrench {
         //        Anonymous used by application
         mem_mng->useAnonymousMemory(n_bytes);
 
+        mem_mng->readAhead(file->getID(), location, file->getSize());
+
         this->getOutput().addTimestampDiskReadCompletion(Simulation::getCurrentSimulatedDate(), hostname, location->getMountPoint(), n_bytes,
                                                          temp_unique_sequence_number);
     }
@@ -1025,12 +1106,42 @@ namespace wrench {
      * @return pointer to the memory manager running on the host (or nullptr)
      */
     MemoryManager *Simulation::getMemoryManagerByHost(const std::string &hostname) {
-        for (const auto &ptr: this->memory_managers) {
-            if (strcmp(ptr->getHostname().c_str(), hostname.c_str()) == 0) {
-                return ptr.get();
-            }
-        }
-        return nullptr;
+        auto it = this->memory_managers_by_host.find(hostname);
+        return (it == this->memory_managers_by_host.end() ? nullptr : it->second);
+    }
+
+    /**
+     * @brief Find MemoryManager running on a host
+     *
+     * @param host: the host
+     * @return pointer to the memory manager running on the host (or nullptr)
+     */
+    MemoryManager *Simulation::getMemoryManagerByHost(simgrid::s4u::Host *host) {
+        return this->getMemoryManagerByHost(host->get_name());
+    }
+
+    /**
+     * @brief Get the compute services that run on a host
+     *
+     * @param hostname: name of the host
+     * @return the compute services, in the order in which they were added to the simulation
+     */
+    const std::vector<std::shared_ptr<ComputeService>> &Simulation::getComputeServicesByHost(const std::string &hostname) {
+        static const std::vector<std::shared_ptr<ComputeService>> none;
+        auto it = this->compute_services_by_host.find(hostname);
+        return (it == this->compute_services_by_host.end() ? none : it->second);
+    }
+
+    /**
+     * @brief Get the storage services that run on a host
+     *
+     * @param hostname: name of the host
+     * @return the storage services, in the order in which they were added to the simulation
+     */
+    const std::vector<std::shared_ptr<StorageService>> &Simulation::getStorageServicesByHost(const std::string &hostname) {
+        static const std::vector<std::shared_ptr<StorageService>> none;
+        auto it = this->storage_services_by_host.find(hostname);
+        return (it == this->storage_services_by_host.end() ? none : it->second);
     }
 
     /**
@@ -1334,6 +1445,7 @@ namespace wrench {
         service->simulation = this;
         std::shared_ptr<ComputeService> shared_ptr = std::shared_ptr<ComputeService>(service);
         this->compute_services.insert(shared_ptr);
+        this->compute_services_by_host[shared_ptr->getHostname()].push_back(shared_ptr);
         shared_ptr->start(shared_ptr, true, false);// Daemonized, no auto-restart
         if (service->hasScratch()) {
             service->getScratch()->simulation = this;
@@ -1364,6 +1476,7 @@ namespace wrench {
         service->simulation = this;
         std::shared_ptr<StorageService> shared_ptr = std::shared_ptr<StorageService>(service);
         this->storage_services.insert(shared_ptr);
+        this->storage_services_by_host[shared_ptr->getHostname()].push_back(shared_ptr);
         shared_ptr->start(shared_ptr, true, false);// Daemonized, no auto-restart
 
         return shared_ptr;
@@ -1442,6 +1555,7 @@ namespace wrench {
         service->simulation = this;
         std::shared_ptr<MemoryManager> shared_ptr = std::shared_ptr<MemoryManager>(service);
         this->memory_managers.insert(shared_ptr);
+        this->memory_managers_by_host.insert(std::make_pair(shared_ptr->getHostname(), shared_ptr.get()));
         shared_ptr->start(shared_ptr, true, false);// Daemonized, no auto-restart
 
         return shared_ptr;
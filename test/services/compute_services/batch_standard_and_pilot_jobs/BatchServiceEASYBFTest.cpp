@@ -0,0 +1,347 @@
+/**
+ * Copyright (c) 2017. The WRENCH Team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <wrench-dev.h>
+#include <gtest/gtest.h>
+#include <wrench/services/compute/batch/BatchComputeService.h>
+
+#include "../../../include/TestWithFork.h"
+#include "../../../include/UniqueTmpPathPrefix.h"
+
+#define EPSILON 0.05
+
+WRENCH_LOG_CATEGORY(batch_service_easy_bf_test, "Log category for BatchServiceEASYBFTest");
+
+class BatchServiceEASY_BFTest : public ::testing::Test {
+
+public:
+    std::shared_ptr<wrench::Workflow> workflow;
+
+    std::shared_ptr<wrench::BatchComputeService> compute_service = nullptr;
+
+    void do_SimpleEASY_BF_test();
+    void do_LargeEASY_BF_test(int seed);
+    int seed;
+
+protected:
+    ~BatchServiceEASY_BFTest() {
+        workflow->clear();
+    }
+
+    BatchServiceEASY_BFTest() {
+
+        // Create the simplest workflow
+        workflow = wrench::Workflow::createWorkflow();
+
+        // Create a four-host 10-core platform file
+        std::string xml = "<?xml version='1.0'?>"
+                          "<!DOCTYPE platform SYSTEM \"https://simgrid.org/simgrid.dtd\">"
+                          "<platform version=\"4.1\"> "
+                          "   <zone id=\"AS0\" routing=\"Full\"> "
+                          "       <host id=\"Host1\" speed=\"1f\" core=\"10\"/> "
+                          "       <host id=\"Host2\" speed=\"1f\" core=\"10\"/> "
+                          "       <host id=\"Host3\" speed=\"1f\" core=\"10\"/> "
+                          "       <host id=\"Host4\" speed=\"1f\" core=\"10\"/> "
+                          "       <link id=\"1\" bandwidth=\"50000GBps\" latency=\"0us\"/>"
+                          "       <route src=\"Host3\" dst=\"Host1\"> <link_ctn id=\"1\"/> </route>"
+                          "       <route src=\"Host3\" dst=\"Host4\"> <link_ctn id=\"1\"/> </route>"
+                          "       <route src=\"Host4\" dst=\"Host1\"> <link_ctn id=\"1\"/> </route>"
+                          "       <route src=\"Host1\" dst=\"Host2\"> <link_ctn id=\"1\"/> </route>"
+                          "   </zone> "
+                          "</platform>";
+        FILE *platform_file = fopen(platform_file_path.c_str(), "w");
+        fprintf(platform_file, "%s", xml.c_str());
+        fclose(platform_file);
+    }
+
+    std::string platform_file_path = UNIQUE_TMP_PATH_PREFIX + "platform.xml";
+};
+
+/**********************************************************************/
+/**  SIMPLE EASY_BF TEST                                             **/
+/**********************************************************************/
+
+class SimpleEASY_BFTestWMS : public wrench::ExecutionController {
+
+public:
+    SimpleEASY_BFTestWMS(BatchServiceEASY_BFTest *test,
+                         std::string hostname) : wrench::ExecutionController(hostname, "test") {
+        this->test = test;
+    }
+
+private:
+    BatchServiceEASY_BFTest *test;
+
+    int main() {
+        // Create a job manager
+        auto job_manager = this->createJobManager();
+
+        // Job #0 runs on 3 nodes, job #1 (3 nodes) is reserved the 4 nodes when job #0 is expected
+        // to end, job #2 needs all 4 nodes, and job #3 (1 node) is backfilled right away on the
+        // extra node of job #1's reservation, even though it delays job #2 (which conservative
+        // backfilling would not allow)
+        double flops[4] = {60, 60, 60, 290};
+        std::string num_nodes[4] = {"3", "3", "4", "1"};
+        std::string requested_times[4] = {"2", "2", "2", "5"};
+
+        std::shared_ptr<wrench::WorkflowTask> tasks[4];
+        std::shared_ptr<wrench::StandardJob> jobs[4];
+        for (int i = 0; i < 4; i++) {
+            tasks[i] = this->test->workflow->addTask("task" + std::to_string(i), flops[i], 1, 1, 0);
+            jobs[i] = job_manager->createStandardJob(tasks[i]);
+        }
+
+        // Submit jobs
+        try {
+            for (int i = 0; i < 4; i++) {
+                std::map<std::string, std::string> job_args;
+                job_args["-N"] = num_nodes[i];
+                job_args["-t"] = requested_times[i];
+                job_args["-c"] = "10";
+                job_manager->submitJob(jobs[i], this->test->compute_service, job_args);
+            }
+        } catch (wrench::ExecutionException &e) {
+            throw std::runtime_error(
+                    "Unexpected exception while submitting job");
+        }
+
+        // Check start time estimates (which do not account for future backfilling)
+        std::set<std::tuple<std::string, unsigned long, unsigned long, double>> set_of_jobs = {
+                (std::tuple<std::string, unsigned long, unsigned long, double>){"one_node", 1, 10, 60},
+                (std::tuple<std::string, unsigned long, unsigned long, double>){"four_nodes", 4, 10, 60},
+                (std::tuple<std::string, unsigned long, unsigned long, double>){"five_nodes", 5, 10, 60},
+        };
+        auto estimates = this->test->compute_service->getStartTimeEstimates(set_of_jobs);
+        std::map<std::string, double> expected_estimates = {
+                {"one_node", 240},
+                {"four_nodes", 420},
+                {"five_nodes", -1},
+        };
+        for (auto const &expected: expected_estimates) {
+            if (std::abs(estimates[expected.first] - expected.second) > EPSILON) {
+                throw std::runtime_error("Unexpected start time estimate for " + expected.first + ": " +
+                                         std::to_string(estimates[expected.first]) +
+                                         " (expected: " + std::to_string(expected.second) + ")");
+            }
+        }
+
+        int expected_completion_order[4] = {0, 1, 3, 2};
+        double expected_completion_times[4] = {60, 120, 290, 350};
+
+        for (int i = 0; i < 4; i++) {
+            // Wait for a workflow execution event
+            std::shared_ptr<wrench::ExecutionEvent> event;
+            try {
+                event = this->waitForNextEvent();
+            } catch (wrench::ExecutionException &e) {
+                throw std::runtime_error("Error while getting and execution event: " + e.getCause()->toString());
+            }
+            auto real_event = std::dynamic_pointer_cast<wrench::StandardJobCompletedEvent>(event);
+            if (not real_event) {
+                throw std::runtime_error("Unexpected workflow execution event: " + event->toString());
+            }
+            if (real_event->standard_job != jobs[expected_completion_order[i]]) {
+                throw std::runtime_error("Unexpected job completion order: job containing task " +
+                                         real_event->standard_job->getTasks().at(0)->getID() +
+                                         " completed in position " + std::to_string(i));
+            }
+            double delta = std::abs(wrench::Simulation::getCurrentSimulatedDate() - expected_completion_times[i]);
+            if (delta > EPSILON) {
+                throw std::runtime_error("Unexpected job completion time for the job containing task " +
+                                         real_event->standard_job->getTasks().at(0)->getID() +
+                                         ": " +
+                                         std::to_string(wrench::Simulation::getCurrentSimulatedDate()) +
+                                         " (expected: " +
+                                         std::to_string(expected_completion_times[i]) +
+                                         ")");
+            }
+        }
+
+        return 0;
+    }
+};
+
+#ifdef ENABLE_BATSCHED
+TEST_F(BatchServiceEASY_BFTest, DISABLED_SimpleEASY_BFTest)
+#else
+TEST_F(BatchServiceEASY_BFTest, SimpleEASY_BFTest)
+#endif
+{
+    DO_TEST_WITH_FORK(do_SimpleEASY_BF_test);
+}
+
+void BatchServiceEASY_BFTest::do_SimpleEASY_BF_test() {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 1;
+    auto argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Get a hostname
+    std::string hostname = "Host1";
+
+    // Create a Batch Service with an easy_bf scheduling algorithm
+    ASSERT_NO_THROW(compute_service = simulation->add(
+                            new wrench::BatchComputeService(hostname, {"Host1", "Host2", "Host3", "Host4"}, "",
+                                                            {{wrench::BatchComputeServiceProperty::BATCH_SCHEDULING_ALGORITHM, "easy_bf"}})));
+
+    simulation->add(new wrench::FileRegistryService(hostname));
+
+    // Create a WMS
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new SimpleEASY_BFTestWMS(
+                                    this, hostname)));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
+
+/**********************************************************************/
+/**  LARGE EASY_BF TEST                                              **/
+/**********************************************************************/
+
+#define NUM_JOBS 300
+
+class LargeEASY_BFTestWMS : public wrench::ExecutionController {
+
+public:
+    LargeEASY_BFTestWMS(BatchServiceEASY_BFTest *test,
+                        std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    BatchServiceEASY_BFTest *test;
+
+    int main() {
+        // Create a job manager
+        auto job_manager = this->createJobManager();
+
+        unsigned int random = this->test->seed;
+
+        std::shared_ptr<wrench::WorkflowTask> tasks[NUM_JOBS];
+        std::shared_ptr<wrench::StandardJob> jobs[NUM_JOBS];
+        for (int i = 0; i < NUM_JOBS; i++) {
+            random = random * 17 + 4123451;
+            tasks[i] = this->test->workflow->addTask("task" + std::to_string(i), 60 + 60 * (random % 30), 1, 1, 0);
+            jobs[i] = job_manager->createStandardJob(tasks[i]);
+        }
+
+        // Submit jobs
+        try {
+            for (int i = 0; i < NUM_JOBS; i++) {
+                std::map<std::string, std::string> job_specific_args;
+                random = random * 17 + 4123451;
+                job_specific_args["-N"] = std::to_string(1 + random % 4);
+                random = random * 17 + 4123451;
+                job_specific_args["-t"] = std::to_string(1 + random % 100);
+                job_specific_args["-c"] = "10";
+                job_manager->submitJob(jobs[i], this->test->compute_service, job_specific_args);
+            }
+        } catch (wrench::ExecutionException &e) {
+            throw std::runtime_error(
+                    "Unexpected exception while submitting job");
+        }
+
+        // Every job must complete, or fail because it ran out of time
+        std::set<std::shared_ptr<wrench::StandardJob>> finished_jobs;
+        for (int i = 0; i < NUM_JOBS; i++) {
+            // Wait for a workflow execution event
+            std::shared_ptr<wrench::ExecutionEvent> event;
+            try {
+                event = this->waitForNextEvent();
+            } catch (wrench::ExecutionException &e) {
+                throw std::runtime_error("Error while getting and execution event: " + e.getCause()->toString());
+            }
+            if (auto real_event = std::dynamic_pointer_cast<wrench::StandardJobCompletedEvent>(event)) {
+                finished_jobs.insert(real_event->standard_job);
+            } else if (auto real_event = std::dynamic_pointer_cast<wrench::StandardJobFailedEvent>(event)) {
+                finished_jobs.insert(real_event->standard_job);
+            } else {
+                throw std::runtime_error("Unexpected workflow execution event: " + event->toString());
+            }
+
+            // Get predictions for scalability measures
+            std::set<std::tuple<std::string, unsigned long, unsigned long, double>> set_of_jobs = {
+                    (std::tuple<std::string, unsigned long, unsigned long, double>){"testing_job1_" + std::to_string(i), 1, 10, 60},
+                    (std::tuple<std::string, unsigned long, unsigned long, double>){"testing_job2_" + std::to_string(i), 4, 10, 400},
+                    (std::tuple<std::string, unsigned long, unsigned long, double>){"testing_job3_" + std::to_string(i), 5, 10, 400},
+            };
+            auto estimates = this->test->compute_service->getStartTimeEstimates(set_of_jobs);
+            if (estimates["testing_job3_" + std::to_string(i)] != -1.0) {
+                throw std::runtime_error("A job that asks for too many nodes should not have a start time estimate");
+            }
+        }
+
+        if (finished_jobs.size() != NUM_JOBS) {
+            throw std::runtime_error("Some jobs were notified of more than once");
+        }
+
+        return 0;
+    }
+};
+
+#ifdef ENABLE_BATSCHED
+TEST_F(BatchServiceEASY_BFTest, DISABLED_LargeEASY_BFTest)
+#else
+TEST_F(BatchServiceEASY_BFTest, LargeEASY_BFTest)
+#endif
+{
+    for (int seed = 1; seed < 3; seed++) {
+        DO_TEST_WITH_FORK_ONE_ARG(do_LargeEASY_BF_test, seed);
+    }
+}
+
+void BatchServiceEASY_BFTest::do_LargeEASY_BF_test(int seed) {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 2;
+    auto argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    argv[1] = strdup("--cfg=contexts/stack-size:100");
+
+    this->seed = seed;
+
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Get a hostname
+    std::string hostname = "Host1";
+
+    // Create a Batch Service with an easy_bf scheduling algorithm
+    ASSERT_NO_THROW(compute_service = simulation->add(
+                            new wrench::BatchComputeService(hostname, {"Host1", "Host2", "Host3", "Host4"}, "",
+                                                            {{wrench::BatchComputeServiceProperty::BATCH_SCHEDULING_ALGORITHM, "easy_bf"}})));
+
+    simulation->add(new wrench::FileRegistryService(hostname));
+
+    // Create a WMS
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new LargeEASY_BFTestWMS(
+                                    this, hostname)));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
@@ -98,6 +98,48 @@ private:
         //        tl->print();
         tl->clear();
 
+        // Check earliest start time searches on:  [0,10): 2 available nodes,  [10,20): 10,  [20,30): 6,
+        // [30,35): 10,  [35,40): 0,  [40,...): 10
+        std::shared_ptr<wrench::CompoundJob> wj4 = job_manager->createCompoundJob("wj4");
+        auto bj4 = std::shared_ptr<wrench::BatchJob>(new wrench::BatchJob(wj4, 4, 1, 8, 1, "who", 0, 0));
+        std::shared_ptr<wrench::CompoundJob> wj5 = job_manager->createCompoundJob("wj5");
+        auto bj5 = std::shared_ptr<wrench::BatchJob>(new wrench::BatchJob(wj5, 5, 1, 4, 1, "who", 0, 0));
+        std::shared_ptr<wrench::CompoundJob> wj6 = job_manager->createCompoundJob("wj6");
+        auto bj6 = std::shared_ptr<wrench::BatchJob>(new wrench::BatchJob(wj6, 6, 1, 10, 1, "who", 0, 0));
+        tl->add(0, 10, bj4);
+        tl->add(20, 30, bj5);
+        tl->add(35, 40, bj6);
+
+        if (tl->findEarliestStartTime(5, 3) != 10) {
+            throw std::runtime_error("Unexpected earliest start time for a 3-node job");
+        }
+        // The 10 available seconds in [10,20) must not count toward a slot found after [20,30)
+        if (tl->findEarliestStartTime(15, 8) != 40) {
+            throw std::runtime_error("Unexpected earliest start time for an 8-node job");
+        }
+        if ((tl->getMaxAvailableNodesBefore(0) != 0) or
+            (tl->getMaxAvailableNodesBefore(10) != 2) or
+            (tl->getMaxAvailableNodesBefore(11) != 10)) {
+            throw std::runtime_error("Unexpected max number of available nodes");
+        }
+        if (tl->findEarlierStartTime(10, bj5, 20) != 10) {
+            throw std::runtime_error("Job bj5 should be able to start earlier");
+        }
+        if (tl->findEarlierStartTime(10, bj4, 0) != UINT32_MAX) {
+            throw std::runtime_error("Job bj4 should not be able to start earlier");
+        }
+
+        // Check the time origin
+        tl->setTimeOrigin(5);
+        if (tl->getJobsInFirstSlot() != std::set<std::shared_ptr<wrench::BatchJob>>({bj4})) {
+            throw std::runtime_error("Job bj4 should be the only job in the first slot");
+        }
+        tl->setTimeOrigin(12);
+        if ((not tl->getJobsInFirstSlot().empty()) or (tl->findEarliestStartTime(5, 3) != 12)) {
+            throw std::runtime_error("Job bj4 should no longer be in the timeline");
+        }
+        tl->clear();
+
         return 0;
     }
 };
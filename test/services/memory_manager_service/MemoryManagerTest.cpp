@@ -9,6 +9,7 @@
  */
 
 #include <math.h>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <wrench-dev.h>
 
@@ -28,7 +29,9 @@ public:
     std::shared_ptr<wrench::BareMetalComputeService> compute_service = nullptr;
 
     void do_MemoryManagerBadSetupTest_test();
-    void do_MemoryManagerChainOfTasksTest_test();
+    void do_MemoryManagerChainOfTasksTest_test(unsigned long max_extents_per_file, unsigned long readahead_max_window);
+    void do_MemoryManagerReadaheadTest_test(bool readahead);
+    void do_MemoryManagerLogSizeTest_test();
 
 protected:
     ~MemoryManagerTest() {
@@ -182,6 +185,17 @@ private:
 
         // Coverage
         auto memory_manager = this->simulation->getMemoryManagerByHost(this->getHostname());
+        if ((memory_manager == nullptr) or
+            (this->simulation->getMemoryManagerByHost(simgrid::s4u::Host::by_name(this->getHostname())) != memory_manager) or
+            (this->simulation->getMemoryManagerByHost("bogus") != nullptr)) {
+            throw std::runtime_error("Unexpected memory manager lookup result");
+        }
+        if ((this->simulation->getStorageServicesByHost(this->getHostname()).size() != 1) or
+            (this->simulation->getStorageServicesByHost(this->getHostname()).at(0) != test->storage_service1) or
+            (this->simulation->getComputeServicesByHost(this->getHostname()).size() != 1) or
+            (not this->simulation->getComputeServicesByHost("bogus").empty())) {
+            throw std::runtime_error("Unexpected per-host service lookup result");
+        }
         auto disk = memory_manager->getMemory();
         memory_manager->setMemory(disk);
         memory_manager->setDirtyRatio(memory_manager->getDirtyRatio());
@@ -190,22 +204,60 @@ private:
         memory_manager->getTotalMemory();
         memory_manager->getCachedAmount("foo");
         memory_manager->export_log("/dev/null");
+        try {
+            memory_manager->export_log("/bogus_directory/bogus_file.csv");
+            throw std::runtime_error("Should not be able to export the log to a bogus path");
+        } catch (std::invalid_argument &ignore) {
+        }
+
+        // Check that the running totals are consistent
+        if ((memory_manager->getEvictableMemory() > memory_manager->getTotalCachedAmount() + 1) or
+            (memory_manager->getDirty() > memory_manager->getTotalCachedAmount() + 1)) {
+            throw std::runtime_error("Inconsistent evictable/dirty/cached amounts");
+        }
+
+        // Check that the per-file index is consistent, and that the number of extents per file is bounded
+        // (each extent is a clean or dirty extent in the inactive or active list)
+        unsigned long max_extents_per_file = wrench::Simulation::getPageCacheMaxExtentsPerFile();
+        for (auto const &f: this->workflow->getFileMap()) {
+            double cached_amount = 0;
+            auto blocks = memory_manager->getCachedBlocks(f.first);
+            for (auto const &blk: blocks) {
+                cached_amount += blk->getSize();
+            }
+            if ((max_extents_per_file > 0) and (blocks.size() > max_extents_per_file + 3)) {
+                throw std::runtime_error("Too many extents for file " + f.first);
+            }
+            if (std::abs(cached_amount - memory_manager->getCachedAmount(f.first)) > 1) {
+                throw std::runtime_error("Inconsistent cached amount for file " + f.first);
+            }
+        }
+
+        // Check that periodical flushing eventually flushes all dirty data (expired time = 30, interval = 5)
+        wrench::Simulation::sleep(10000);
+        if (memory_manager->getDirty() > 1) {
+            throw std::runtime_error("Dirty data should have been flushed");
+        }
 
         return 0;
     }
 };
 
 TEST_F(MemoryManagerTest, MemoryManagerChainOfTask) {
-    DO_TEST_WITH_FORK(do_MemoryManagerChainOfTasksTest_test)
+    DO_TEST_WITH_FORK_TWO_ARGS(do_MemoryManagerChainOfTasksTest_test, 0, 0)
+    DO_TEST_WITH_FORK_TWO_ARGS(do_MemoryManagerChainOfTasksTest_test, 2, 0)
+    DO_TEST_WITH_FORK_TWO_ARGS(do_MemoryManagerChainOfTasksTest_test, 0, 400000000)
 }
 
-void MemoryManagerTest::do_MemoryManagerChainOfTasksTest_test() {
+void MemoryManagerTest::do_MemoryManagerChainOfTasksTest_test(unsigned long max_extents_per_file, unsigned long readahead_max_window) {
     // Create and initialize a simulation
     auto simulation = wrench::Simulation::createSimulation();
-    int argc = 2;
+    int argc = 4;
     char **argv = (char **) calloc(argc, sizeof(char *));
     argv[0] = strdup("unit_test");
     argv[1] = strdup("--wrench-pagecache-simulation");
+    argv[2] = strdup(("--wrench-pagecache-max-extents-per-file=" + std::to_string(max_extents_per_file)).c_str());
+    argv[3] = strdup(("--wrench-pagecache-readahead-max-window=" + std::to_string(readahead_max_window)).c_str());
 
     ASSERT_THROW(simulation->launch(), std::runtime_error);
 
@@ -264,3 +316,250 @@ void MemoryManagerTest::do_MemoryManagerChainOfTasksTest_test() {
         free(argv[i]);
     free(argv);
 }
+
+
+/**********************************************************************/
+/** SEQUENTIAL READAHEAD SIMULATION TEST                             **/
+/**********************************************************************/
+
+class MemoryManagerReadaheadTestWMS : public wrench::ExecutionController {
+public:
+    MemoryManagerReadaheadTestWMS(
+            MemoryManagerTest *test,
+            std::shared_ptr<wrench::Workflow> workflow,
+            std::string &hostname,
+            bool readahead) : wrench::ExecutionController(hostname, "test"),
+                              test(test), workflow(workflow), readahead(readahead) {
+    }
+
+private:
+    MemoryManagerTest *test;
+    std::shared_ptr<wrench::Workflow> workflow;
+    bool readahead;
+
+    // Read chunks of a file at the given offsets, processing each chunk for 1 second,
+    // and return the elapsed time
+    double readChunks(const std::shared_ptr<wrench::DataFile> &file, double chunk_size, const std::vector<double> &offsets) {
+        auto location = wrench::FileLocation::LOCATION(test->storage_service1, file);
+        double start = wrench::Simulation::getCurrentSimulatedDate();
+        for (auto const &offset: offsets) {
+            this->simulation->readWithMemoryCache(file, chunk_size, location, offset);
+            wrench::Simulation::sleep(1);
+        }
+        return wrench::Simulation::getCurrentSimulatedDate() - start;
+    }
+
+    int main() {
+        auto memory_manager = this->simulation->getMemoryManagerByHost(this->getHostname());
+        double chunk_size = this->workflow->getFileByID("sequential_file")->getSize() / 10;
+
+        // Read a file sequentially, and another file of the same size in a non-sequential order
+        // (offset 0, which starts a sequential read, comes last, when nothing is left to read ahead)
+        std::vector<double> sequential_offsets;
+        for (int i = 0; i < 10; i++) {
+            sequential_offsets.push_back(i * chunk_size);
+        }
+        std::vector<double> random_offsets;
+        for (int i : {9, 7, 5, 3, 1, 8, 6, 4, 2, 0}) {
+            random_offsets.push_back(i * chunk_size);
+        }
+        double sequential_time = readChunks(this->workflow->getFileByID("sequential_file"), chunk_size, sequential_offsets);
+        double random_time = readChunks(this->workflow->getFileByID("random_file"), chunk_size, random_offsets);
+
+        // With readahead, disk reads overlap with the processing of sequentially read chunks
+        if (this->readahead and (sequential_time > random_time - 1)) {
+            throw std::runtime_error("Sequential reads should finish sooner with readahead (" +
+                                     std::to_string(sequential_time) + " vs. " + std::to_string(random_time) + ")");
+        }
+        if ((not this->readahead) and (std::abs(sequential_time - random_time) > 1)) {
+            throw std::runtime_error("Sequential and non-sequential reads should take the same time without readahead (" +
+                                     std::to_string(sequential_time) + " vs. " + std::to_string(random_time) + ")");
+        }
+
+        // A non-sequential read resets the readahead window: the chunk that was read ahead after the
+        // first read is not used, the chunk is read from disk, and nothing more is read ahead
+        auto file = this->workflow->getFileByID("reset_file");
+        readChunks(file, chunk_size, {0});
+        readChunks(file, chunk_size, {5 * chunk_size});
+        wrench::Simulation::sleep(100);
+        double expected_cached_amount = (this->readahead ? 3 : 2) * chunk_size;
+        if (std::abs(memory_manager->getCachedAmount(file->getID()) - expected_cached_amount) > 1) {
+            throw std::runtime_error("Unexpected cached amount after a non-sequential read (" +
+                                     std::to_string(memory_manager->getCachedAmount(file->getID())) + " instead of " +
+                                     std::to_string(expected_cached_amount) + ")");
+        }
+
+        return 0;
+    }
+};
+
+TEST_F(MemoryManagerTest, MemoryManagerReadahead) {
+    DO_TEST_WITH_FORK_ONE_ARG(do_MemoryManagerReadaheadTest_test, false)
+    DO_TEST_WITH_FORK_ONE_ARG(do_MemoryManagerReadaheadTest_test, true)
+}
+
+void MemoryManagerTest::do_MemoryManagerReadaheadTest_test(bool readahead) {
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 4;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    argv[1] = strdup("--wrench-pagecache-simulation");
+    // Chunks are 100MB, and so is the initial readahead window
+    argv[2] = strdup(("--wrench-pagecache-readahead-max-window=" + std::to_string(readahead ? 400000000 : 0)).c_str());
+    argv[3] = strdup("--wrench-pagecache-readahead-initial-window=100000000");
+
+    simulation->init(&argc, argv);
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Get a hostname
+    std::string hostname = "TwoCoreHost";
+
+    // Create a Storage Service
+    ASSERT_NO_THROW(storage_service1 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(hostname, {"/"},
+                                                                                     {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "100000000.0"}},
+                                                                                     {})));
+
+    // Create files
+    auto workflow = wrench::Workflow::createWorkflow();
+    for (auto const &id: {"sequential_file", "random_file", "reset_file"}) {
+        auto file = workflow->addFile(id, 1 * GB);
+        ASSERT_NO_THROW(simulation->stageFile(file, storage_service1));
+    }
+
+    // Create a WMS
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new MemoryManagerReadaheadTestWMS(this, workflow, hostname, readahead)));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    workflow->clear();
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
+
+
+/**********************************************************************/
+/** BOUNDED LOG SIMULATION TEST                                      **/
+/**********************************************************************/
+
+class MemoryManagerLogSizeTestWMS : public wrench::ExecutionController {
+public:
+    MemoryManagerLogSizeTestWMS(
+            MemoryManagerTest *test,
+            std::shared_ptr<wrench::Workflow> workflow,
+            std::string &hostname) : wrench::ExecutionController(hostname, "test"),
+                                     test(test), workflow(workflow) {
+    }
+
+private:
+    MemoryManagerTest *test;
+    std::shared_ptr<wrench::Workflow> workflow;
+
+    int main() {
+        auto memory_manager = this->simulation->getMemoryManagerByHost(this->getHostname());
+        auto file = this->workflow->getFileByID("file");
+        auto location = wrench::FileLocation::LOCATION(test->storage_service1, file);
+        double used_memory = memory_manager->getTotalMemory() - memory_manager->getFreeMemory();
+
+        // Log 10 times (once per second), with 1GB of the file cached every other time
+        for (int i = 0; i < 10; i++) {
+            if (i % 2) {
+                memory_manager->evict(1 * GB, "");
+            } else {
+                memory_manager->addToCache(file->getID(), location, 1 * GB, false);
+            }
+            memory_manager->log();
+            wrench::Simulation::sleep(1);
+        }
+
+        // With a log size of 4, samples are merged twice: the log covers calls 1-4, 5-8 and 9-10,
+        // and each sample keeps the peak cached and used amounts
+        std::string log_file_path = UNIQUE_TMP_PATH_PREFIX + "pagecache_log.csv";
+        memory_manager->export_log(log_file_path);
+        std::ifstream log_file(log_file_path);
+        std::string line;
+        std::getline(log_file, line);
+        std::vector<std::vector<double>> rows;
+        while (std::getline(log_file, line)) {
+            std::vector<double> row(5);
+            if (sscanf(line.c_str(), "%lf, %lf, %lf, %lf, %lf", &row[0], &row[1], &row[2], &row[3], &row[4]) != 5) {
+                throw std::runtime_error("Invalid log line: " + line);
+            }
+            rows.push_back(row);
+        }
+        log_file.close();
+        unlink(log_file_path.c_str());
+
+        if (rows.size() != 3) {
+            throw std::runtime_error("The exported log should have 3 rows (instead of " + std::to_string(rows.size()) + ")");
+        }
+        for (unsigned long i = 0; i < rows.size(); i++) {
+            if ((std::abs(rows[i][0] - 4.0 * i) > 0.001) or
+                (std::abs(rows[i][3] - 1 * GB / 1000000.0) > 0.001) or
+                (std::abs(rows[i][4] - (used_memory + 1 * GB) / 1000000.0) > 0.001)) {
+                throw std::runtime_error("Unexpected merged log sample: " +
+                                         std::to_string(rows[i][0]) + ", " + std::to_string(rows[i][3]) + ", " + std::to_string(rows[i][4]));
+            }
+        }
+
+        return 0;
+    }
+};
+
+TEST_F(MemoryManagerTest, MemoryManagerLogSize) {
+    DO_TEST_WITH_FORK(do_MemoryManagerLogSizeTest_test)
+}
+
+void MemoryManagerTest::do_MemoryManagerLogSizeTest_test() {
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 3;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    argv[1] = strdup("--wrench-pagecache-simulation");
+
+    // A log cannot hold fewer than 2 samples
+    argv[2] = strdup("--wrench-pagecache-log-size=1");
+    ASSERT_THROW(simulation->init(&argc, argv), std::invalid_argument);
+    free(argv[2]);
+    argv[2] = strdup("--wrench-pagecache-log-size=bogus");
+    ASSERT_THROW(simulation->init(&argc, argv), std::invalid_argument);
+    free(argv[2]);
+    argv[2] = strdup("--wrench-pagecache-log-size=4");
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+    ASSERT_EQ(wrench::Simulation::getPageCacheLogMaxNumSamples(), 4UL);
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Get a hostname
+    std::string hostname = "TwoCoreHost";
+
+    // Create a Storage Service
+    ASSERT_NO_THROW(storage_service1 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(hostname, {"/"}, {}, {})));
+
+    // Create a file
+    auto workflow = wrench::Workflow::createWorkflow();
+    workflow->addFile("file", 1 * GB);
+
+    // Create a WMS
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new MemoryManagerLogSizeTestWMS(this, workflow, hostname)));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    workflow->clear();
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
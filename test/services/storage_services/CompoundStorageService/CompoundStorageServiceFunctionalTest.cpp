@@ -33,13 +33,18 @@ public:
     std::shared_ptr<wrench::SimpleStorageService> simple_storage_service_100 = nullptr;
     std::shared_ptr<wrench::SimpleStorageService> simple_storage_service_510 = nullptr;
     std::shared_ptr<wrench::SimpleStorageService> simple_storage_service_1000 = nullptr;
+    std::shared_ptr<wrench::SimpleStorageService> simple_storage_service_1000_nonbufferized = nullptr;
     std::shared_ptr<wrench::CompoundStorageService> compound_storage_service = nullptr;
+    std::map<std::string, std::shared_ptr<wrench::CompoundStorageService>> builtin_compound_storage_services;
 
     std::shared_ptr<wrench::ComputeService> compute_service = nullptr;
 
     void do_BasicFunctionality_test();
     void do_BasicInterceptFunctionality_test();
     void do_BasicError_test();
+    void do_Striping_test();
+    void do_BulkLookupAndDelete_test();
+    void do_BuiltInStorageSelection_test();
 
 protected:
     ~CompoundStorageServiceFunctionalTest() {
@@ -697,3 +702,516 @@ void CompoundStorageServiceFunctionalTest::do_BasicError_test() {
         free(argv[i]);
     free(argv);
 }
+
+
+/**********************************************************************/
+/**  STRIPING SIMULATION TEST                                        **/
+/**********************************************************************/
+
+class CompoundStorageServiceStripingTestCtrl : public wrench::ExecutionController {
+
+public:
+    CompoundStorageServiceStripingTestCtrl(CompoundStorageServiceFunctionalTest *test,
+                                           std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    CompoundStorageServiceFunctionalTest *test;
+
+    int main() {
+
+        auto css_location = wrench::FileLocation::LOCATION(test->compound_storage_service, test->file_100);
+
+        // A user file whose name looks like a stripe name
+        auto lookalike_file = wrench::Simulation::addFile("file_100_stripe_0", 1);
+
+        // Write a file, which is striped over both storage services
+        wrench::StorageService::writeFile(css_location);
+
+        auto stripe_locations = test->compound_storage_service->lookupFileStripeLocations(test->file_100);
+        if (stripe_locations.size() != 2) {
+            throw std::runtime_error("file_100 should have been striped over 2 storage services");
+        }
+        if (stripe_locations.at(0)->getStorageService() == stripe_locations.at(1)->getStorageService()) {
+            throw std::runtime_error("Stripes should be on distinct storage services");
+        }
+        for (auto const &stripe_location: stripe_locations) {
+            if (std::abs(stripe_location->getFile()->getSize() - 50.0) > 0.001) {
+                throw std::runtime_error("Unexpected stripe size " + std::to_string(stripe_location->getFile()->getSize()));
+            }
+            if (not wrench::StorageService::lookupFile(stripe_location)) {
+                throw std::runtime_error("A stripe should be on its storage service");
+            }
+            if (stripe_location->getFile() == lookalike_file) {
+                throw std::runtime_error("A stripe should never be a user file");
+            }
+        }
+        if (lookalike_file->getSize() != 1) {
+            throw std::runtime_error("Striping should not modify user files");
+        }
+
+        // Lookups and reads are transparent
+        if (not wrench::StorageService::lookupFile(css_location)) {
+            throw std::runtime_error("Should have been able to lookup file_100 through CSS");
+        }
+        wrench::StorageService::readFile(css_location);
+        wrench::StorageService::readFile(css_location, 15);
+
+        // Copy to a bufferized storage service is not allowed
+        try {
+            wrench::StorageService::copyFile(css_location, wrench::FileLocation::LOCATION(test->simple_storage_service_1000, "/disk1000/", test->file_100));
+            throw std::runtime_error("Should not be able to copy a striped file to a bufferized storage service");
+        } catch (wrench::ExecutionException &e) {
+            if (not std::dynamic_pointer_cast<wrench::NotAllowed>(e.getCause())) {
+                throw std::runtime_error("Unexpected failure cause: " + e.getCause()->toString());
+            }
+        }
+
+        // Copy to a non-bufferized storage service
+        auto ss_location = wrench::FileLocation::LOCATION(test->simple_storage_service_1000_nonbufferized, "/disk1000/", test->file_100);
+        wrench::StorageService::copyFile(css_location, ss_location);
+        if (not wrench::StorageService::lookupFile(ss_location)) {
+            throw std::runtime_error("file_100 should have been copied out of the CSS");
+        }
+
+        // Delete the file
+        wrench::StorageService::deleteFile(css_location);
+        if (wrench::StorageService::lookupFile(css_location)) {
+            throw std::runtime_error("file_100 should have been deleted from the CSS");
+        }
+        if (not test->compound_storage_service->lookupFileStripeLocations(test->file_100).empty()) {
+            throw std::runtime_error("file_100 should no longer be striped");
+        }
+        if (wrench::StorageService::lookupFile(stripe_locations.at(0))) {
+            throw std::runtime_error("The stripes of file_100 should have been deleted");
+        }
+
+        // Copy the file back into the CSS
+        wrench::StorageService::copyFile(ss_location, css_location);
+        if (test->compound_storage_service->lookupFileStripeLocations(test->file_100).size() != 2) {
+            throw std::runtime_error("file_100 should have been striped when copied into the CSS");
+        }
+        if (not wrench::StorageService::lookupFile(css_location)) {
+            throw std::runtime_error("file_100 should have been copied into the CSS");
+        }
+
+        // A file smaller than a stripe unit is not striped
+        wrench::StorageService::writeFile(wrench::FileLocation::LOCATION(test->compound_storage_service, test->file_1));
+        if (not test->compound_storage_service->lookupFileStripeLocations(test->file_1).empty()) {
+            throw std::runtime_error("file_1 should not have been striped");
+        }
+        if (not test->compound_storage_service->lookupFileLocation(test->file_1)) {
+            throw std::runtime_error("file_1 should have been placed on a storage service");
+        }
+
+        return 0;
+    }
+};
+
+TEST_F(CompoundStorageServiceFunctionalTest, Striping) {
+    DO_TEST_WITH_FORK(do_Striping_test);
+}
+
+void CompoundStorageServiceFunctionalTest::do_Striping_test() {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //    argv[1] = strdup("--wrench-full-log");
+
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Get a hostname
+    auto compute = "ComputeHost";
+    auto simple_storage0 = "SimpleStorageHost0";
+    auto simple_storage1 = "SimpleStorageHost1";
+    auto compound_storage = "CompoundStorageHost";
+
+    // Create some simple storage services
+    // Bufferized
+    ASSERT_NO_THROW(simple_storage_service_1000 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(simple_storage0, {"/disk1000"},
+                                                                                     {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "1000000"}}, {})));
+
+    // Non-bufferized
+    ASSERT_NO_THROW(simple_storage_service_1000_nonbufferized = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(simple_storage1, {"/disk1000"},
+                                                                                     {}, {})));
+
+    // Non-bufferized
+    ASSERT_NO_THROW(simple_storage_service_100 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(simple_storage0, {"/disk100"},
+                                                                                     {}, {})));
+
+    // Non-bufferized
+    ASSERT_NO_THROW(simple_storage_service_510 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(simple_storage1, {"/disk100", "/disk510"},
+                                                                                     {}, {})));
+
+    // Fail to create a striping Compound Storage Service (bogus stripe count)
+    ASSERT_THROW(simulation->add(
+                         new wrench::CompoundStorageService(compound_storage, {simple_storage_service_100, simple_storage_service_510},
+                                                            defaultStorageServiceSelection,
+                                                            {{wrench::CompoundStorageServiceProperty::STRIPE_COUNT, "0"}})),
+                 std::invalid_argument);
+
+    // Fail to create a striping Compound Storage Service (bufferized storage service)
+    ASSERT_THROW(simulation->add(
+                         new wrench::CompoundStorageService(compound_storage, {simple_storage_service_100, simple_storage_service_1000},
+                                                            defaultStorageServiceSelection,
+                                                            {{wrench::CompoundStorageServiceProperty::STRIPE_COUNT, "2"}})),
+                 std::invalid_argument);
+
+    // Create a striping Compound Storage Service
+    ASSERT_NO_THROW(compound_storage_service = simulation->add(
+                            new wrench::CompoundStorageService(compound_storage, {simple_storage_service_100, simple_storage_service_510},
+                                                               defaultStorageServiceSelection,
+                                                               {{wrench::CompoundStorageServiceProperty::STRIPE_COUNT, "4"},
+                                                                {wrench::CompoundStorageServiceProperty::STRIPE_SIZE, "10B"}})));
+
+    // Create a Controler
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new CompoundStorageServiceStripingTestCtrl(this, compute)));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
+
+
+/**********************************************************************/
+/**  BULK LOOKUP AND DELETE SIMULATION TEST                          **/
+/**********************************************************************/
+
+class CompoundStorageServiceBulkLookupAndDeleteTestCtrl : public wrench::ExecutionController {
+
+public:
+    CompoundStorageServiceBulkLookupAndDeleteTestCtrl(CompoundStorageServiceFunctionalTest *test,
+                                                      std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    CompoundStorageServiceFunctionalTest *test;
+
+    int main() {
+
+        auto css = test->compound_storage_service;
+        auto css_location_1 = wrench::FileLocation::LOCATION(css, test->file_1);
+        auto css_location_10 = wrench::FileLocation::LOCATION(css, test->file_10);
+        auto css_location_100 = wrench::FileLocation::LOCATION(css, test->file_100);
+
+        // file_100 is striped, file_1 is not
+        wrench::StorageService::writeFile(css_location_100);
+        wrench::StorageService::writeFile(css_location_1);
+        auto stripe_locations = css->lookupFileStripeLocations(test->file_100);
+        auto designated_location_1 = css->lookupFileLocation(test->file_1);
+        if ((stripe_locations.size() != 2) or (not designated_location_1)) {
+            throw std::runtime_error("Unexpected placement of file_100 and file_1");
+        }
+
+        // The free space request goes through the CSS's daemon
+        std::shared_ptr<wrench::StorageService> css_as_storage_service = css;
+        auto free_space = css_as_storage_service->getFreeSpace();
+        if ((free_space.size() != 2) or
+            (free_space.find(test->simple_storage_service_100->getName()) == free_space.end()) or
+            (free_space.find(test->simple_storage_service_510->getName()) == free_space.end())) {
+            throw std::runtime_error("Unexpected free space answer from the CSS");
+        }
+
+        // Bulk lookup
+        std::vector<bool> expected = {true, true, false};
+        auto found = wrench::StorageService::lookupFiles({css_location_100, css_location_1, css_location_10});
+        if (found != expected) {
+            throw std::runtime_error("Unexpected bulk lookup result");
+        }
+
+        // Remove file_1 behind the CSS's back, so that its bulk deletion fails
+        wrench::StorageService::deleteFile(designated_location_1);
+        try {
+            wrench::StorageService::deleteFiles({css_location_100, css_location_1});
+            throw std::runtime_error("Should not be able to delete a file that is not there");
+        } catch (wrench::ExecutionException &e) {
+            auto cause = std::dynamic_pointer_cast<wrench::FileNotFound>(e.getCause());
+            if (not cause) {
+                throw std::runtime_error("Got an expected exception but unexpected cause type: " + e.getCause()->toString());
+            }
+            if (cause->getLocation()->getFile() != test->file_1) {
+                throw std::runtime_error("Got the expected 'file not found' exception, but the failure cause does not point to the correct file");
+            }
+        }
+
+        // The successfully deleted file is forgotten, the other one is not
+        if (not css->lookupFileStripeLocations(test->file_100).empty()) {
+            throw std::runtime_error("file_100 should no longer be striped");
+        }
+        for (auto const &stripe_location: stripe_locations) {
+            if (wrench::StorageService::lookupFile(stripe_location)) {
+                throw std::runtime_error("The stripes of file_100 should have been deleted");
+            }
+        }
+        if (css->lookupFileLocation(test->file_1) == nullptr) {
+            throw std::runtime_error("file_1 should not have been forgotten since its deletion failed");
+        }
+
+        return 0;
+    }
+};
+
+TEST_F(CompoundStorageServiceFunctionalTest, BulkLookupAndDelete) {
+    DO_TEST_WITH_FORK(do_BulkLookupAndDelete_test);
+}
+
+void CompoundStorageServiceFunctionalTest::do_BulkLookupAndDelete_test() {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //    argv[1] = strdup("--wrench-full-log");
+
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Get a hostname
+    auto compute = "ComputeHost";
+    auto simple_storage0 = "SimpleStorageHost0";
+    auto simple_storage1 = "SimpleStorageHost1";
+    auto compound_storage = "CompoundStorageHost";
+
+    // Create some simple storage services
+    ASSERT_NO_THROW(simple_storage_service_100 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(simple_storage0, {"/disk100"},
+                                                                                     {}, {})));
+    ASSERT_NO_THROW(simple_storage_service_510 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(simple_storage1, {"/disk100", "/disk510"},
+                                                                                     {}, {})));
+
+    // Create a striping Compound Storage Service
+    ASSERT_NO_THROW(compound_storage_service = simulation->add(
+                            new wrench::CompoundStorageService(compound_storage, {simple_storage_service_100, simple_storage_service_510},
+                                                               defaultStorageServiceSelection,
+                                                               {{wrench::CompoundStorageServiceProperty::STRIPE_COUNT, "4"},
+                                                                {wrench::CompoundStorageServiceProperty::STRIPE_SIZE, "10B"}})));
+
+    // Create a Controler
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new CompoundStorageServiceBulkLookupAndDeleteTestCtrl(this, compute)));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
+
+
+/**********************************************************************/
+/**  BUILT-IN STORAGE SELECTION SIMULATION TEST                      **/
+/**********************************************************************/
+
+class CompoundStorageServiceBuiltInStorageSelectionTestCtrl : public wrench::ExecutionController {
+
+public:
+    CompoundStorageServiceBuiltInStorageSelectionTestCtrl(CompoundStorageServiceFunctionalTest *test,
+                                                          std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    CompoundStorageServiceFunctionalTest *test;
+
+    std::shared_ptr<wrench::FileLocation> write(const std::string &method, const std::shared_ptr<wrench::DataFile> &file) {
+        auto css = test->builtin_compound_storage_services[method];
+        wrench::StorageService::writeFile(wrench::FileLocation::LOCATION(css, file));
+        return css->lookupFileLocation(file);
+    }
+
+    void remove(const std::string &method, const std::shared_ptr<wrench::DataFile> &file) {
+        auto css = test->builtin_compound_storage_services[method];
+        wrench::StorageService::deleteFile(wrench::FileLocation::LOCATION(css, file));
+    }
+
+    int main() {
+
+        // Round-robin (not weighted): consecutive files go to distinct mount points
+        {
+            std::set<std::pair<std::shared_ptr<wrench::StorageService>, std::string>> targets;
+            std::vector<std::shared_ptr<wrench::DataFile>> files;
+            for (int i = 0; i < 3; i++) {
+                files.push_back(wrench::Simulation::addFile("rr_" + std::to_string(i), 10));
+                auto location = this->write("round_robin", files.back());
+                targets.insert(std::make_pair(location->getStorageService(), location->getMountPoint()));
+            }
+            if (targets.size() != 3) {
+                throw std::runtime_error("Round-robin should have used all 3 mount points");
+            }
+            // Targets are visited in (service name, mount point) order, whatever the pointer values
+            auto first_target = *std::min_element(targets.begin(), targets.end(), [](const std::pair<std::shared_ptr<wrench::StorageService>, std::string> &a,
+                                                                                     const std::pair<std::shared_ptr<wrench::StorageService>, std::string> &b) {
+                return std::make_pair(a.first->getName(), a.second) < std::make_pair(b.first->getName(), b.second);
+            });
+            auto first_location = test->builtin_compound_storage_services["round_robin"]->lookupFileLocation(files.at(0));
+            if ((first_location->getStorageService() != first_target.first) or (first_location->getMountPoint() != first_target.second)) {
+                throw std::runtime_error("Round-robin should have placed the first file on the first target in name order");
+            }
+            for (auto const &f: files) {
+                this->remove("round_robin", f);
+            }
+        }
+
+        // A file whose deletion fails is still known to the CSS
+        {
+            auto file = wrench::Simulation::addFile("failed_delete", 10);
+            auto location = this->write("round_robin", file);
+            wrench::StorageService::deleteFile(location);
+            try {
+                this->remove("round_robin", file);
+                throw std::runtime_error("Should not be able to delete a file that is no longer on its storage service");
+            } catch (wrench::ExecutionException &e) {
+                if (not std::dynamic_pointer_cast<wrench::FileNotFound>(e.getCause())) {
+                    throw std::runtime_error("Unexpected failure cause: " + e.getCause()->toString());
+                }
+            }
+            if (test->builtin_compound_storage_services["round_robin"]->lookupFileLocation(file) == nullptr) {
+                throw std::runtime_error("The CSS should not forget a file whose deletion failed");
+            }
+        }
+
+        // Most free: the largest mount point is picked, and deletions free tracked space
+        {
+            auto file_100 = wrench::Simulation::addFile("mf_100", 100);
+            auto file_500 = wrench::Simulation::addFile("mf_500", 500);
+            auto location = this->write("most_free", file_100);
+            if (location->getMountPoint() != "/disk510") {
+                throw std::runtime_error("Most-free should have picked /disk510, not " + location->getMountPoint());
+            }
+            try {
+                this->write("most_free", file_500);
+                throw std::runtime_error("There should not be enough tracked free space for a 500-byte file");
+            } catch (wrench::ExecutionException &ignore) {
+            }
+            this->remove("most_free", file_100);
+            location = this->write("most_free", file_500);
+            if (location->getMountPoint() != "/disk510") {
+                throw std::runtime_error("Most-free should have picked /disk510 after a deletion");
+            }
+            this->remove("most_free", file_500);
+        }
+
+        // Least used (weighted by capacity): the largest mount point gets most files
+        {
+            int num_files_on_disk510_count = 0;
+            std::vector<std::shared_ptr<wrench::DataFile>> files;
+            for (int i = 0; i < 10; i++) {
+                files.push_back(wrench::Simulation::addFile("lu_" + std::to_string(i), 10));
+                auto location = this->write("least_used", files.back());
+                if (location->getMountPoint() == "/disk510") {
+                    num_files_on_disk510_count++;
+                }
+            }
+            if (num_files_on_disk510_count < 6) {
+                throw std::runtime_error("Least-used should have placed most files on /disk510 (" + std::to_string(num_files_on_disk510_count) + ")");
+            }
+            for (auto const &f: files) {
+                this->remove("least_used", f);
+            }
+        }
+
+        // Hash and consistent hash: a file is always placed on the same mount point
+        for (auto const &method: {"hash", "consistent_hash"}) {
+            auto file = wrench::Simulation::addFile(std::string(method) + "_file", 10);
+            auto location = this->write(method, file);
+            this->remove(method, file);
+            auto location_again = this->write(method, file);
+            if ((location->getStorageService() != location_again->getStorageService()) or
+                (location->getMountPoint() != location_again->getMountPoint())) {
+                throw std::runtime_error(std::string(method) + " should always place a file on the same mount point");
+            }
+            this->remove(method, file);
+        }
+
+        return 0;
+    }
+};
+
+TEST_F(CompoundStorageServiceFunctionalTest, BuiltInStorageSelection) {
+    DO_TEST_WITH_FORK(do_BuiltInStorageSelection_test);
+}
+
+void CompoundStorageServiceFunctionalTest::do_BuiltInStorageSelection_test() {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //    argv[1] = strdup("--wrench-full-log");
+
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Get a hostname
+    auto compute = "ComputeHost";
+    auto simple_storage0 = "SimpleStorageHost0";
+    auto simple_storage1 = "SimpleStorageHost1";
+    auto compound_storage = "CompoundStorageHost";
+
+    // Non-bufferized
+    ASSERT_NO_THROW(simple_storage_service_100 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(simple_storage0, {"/disk100"},
+                                                                                     {}, {})));
+
+    // Non-bufferized
+    ASSERT_NO_THROW(simple_storage_service_510 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(simple_storage1, {"/disk100", "/disk510"},
+                                                                                     {}, {})));
+
+    // Fail to create a Compound Storage Service (bogus method)
+    ASSERT_THROW(simulation->add(
+                         new wrench::CompoundStorageService(compound_storage, {simple_storage_service_100, simple_storage_service_510},
+                                                            {{wrench::CompoundStorageServiceProperty::STORAGE_SELECTION_METHOD, "bogus"}})),
+                 std::invalid_argument);
+
+    // Fail to create a Compound Storage Service (both a callback and a built-in method)
+    ASSERT_THROW(simulation->add(
+                         new wrench::CompoundStorageService(compound_storage, {simple_storage_service_100, simple_storage_service_510},
+                                                            defaultStorageServiceSelection,
+                                                            {{wrench::CompoundStorageServiceProperty::STORAGE_SELECTION_METHOD, "round_robin"}})),
+                 std::invalid_argument);
+
+    // Create one Compound Storage Service per built-in method
+    for (auto const &method: {"round_robin", "least_used", "most_free", "hash", "consistent_hash"}) {
+        std::string weighted = (std::string(method) == "round_robin" ? "false" : "true");
+        ASSERT_NO_THROW(builtin_compound_storage_services[method] = simulation->add(
+                                new wrench::CompoundStorageService(compound_storage, {simple_storage_service_100, simple_storage_service_510},
+                                                                   {{wrench::CompoundStorageServiceProperty::STORAGE_SELECTION_METHOD, method},
+                                                                    {wrench::CompoundStorageServiceProperty::STORAGE_SELECTION_WEIGHTED_BY_CAPACITY, weighted}})));
+    }
+
+    // Create a Controler
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new CompoundStorageServiceBuiltInStorageSelectionTestCtrl(this, compute)));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
@@ -13,6 +13,7 @@ public:
     void do_BasicTests();
     void do_DevNullTests();
     void do_LRUTests();
+    void do_CachePolicyTests();
 
 protected:
     LogicalFileSystemTest() {
@@ -32,6 +33,18 @@ protected:
                           "             <prop id=\"size\" value=\"100B\"/>"
                           "             <prop id=\"mount\" value=\"/tmp\"/>"
                           "          </disk>"
+                          "          <disk id=\"100bytedisk_arc\" read_bw=\"100MBps\" write_bw=\"100MBps\">"
+                          "             <prop id=\"size\" value=\"100B\"/>"
+                          "             <prop id=\"mount\" value=\"/arc\"/>"
+                          "          </disk>"
+                          "          <disk id=\"100bytedisk_2q\" read_bw=\"100MBps\" write_bw=\"100MBps\">"
+                          "             <prop id=\"size\" value=\"100B\"/>"
+                          "             <prop id=\"mount\" value=\"/2q\"/>"
+                          "          </disk>"
+                          "          <disk id=\"100bytedisk_ttl\" read_bw=\"100MBps\" write_bw=\"100MBps\">"
+                          "             <prop id=\"size\" value=\"100B\"/>"
+                          "             <prop id=\"mount\" value=\"/ttl\"/>"
+                          "          </disk>"
                           "       </host>"
                           "   </zone> "
                           "</platform>";
@@ -273,6 +286,165 @@ void LogicalFileSystemTest::do_LRUTests() {
 
     fs1->storeFileInDirectory(file_10, "/faa", true);// coverage
 
+    // A file that becomes evictable again keeps its LRU position (file_50's
+    // reservation from above is still held, so release it first)
+    fs1->unreserveSpace(file_50, "/foo");
+    fs1->storeFileInDirectory(file_20, "/foo", true);
+    fs1->storeFileInDirectory(file_30, "/foo", true);
+    ASSERT_DOUBLE_EQ(fs1->getFreeSpace(), 40);
+    fs1->incrementNumRunningTransactionsForFileInDirectory(file_20, "/foo");
+    fs1->decrementNumRunningTransactionsForFileInDirectory(file_20, "/foo");
+    ASSERT_TRUE(fs1->reserveSpace(file_60, "/foo"));
+    ASSERT_FALSE(fs1->isFileInDirectory(file_10, "/faa"));
+    ASSERT_FALSE(fs1->isFileInDirectory(file_20, "/foo"));
+    ASSERT_TRUE(fs1->isFileInDirectory(file_30, "/foo"));
+    ASSERT_DOUBLE_EQ(fs1->getFreeSpace(), 10);
+
+    ASSERT_EQ(fs1->getCachingBehavior(), "LRU");
+    ASSERT_EQ(fs1->getCacheStatistics().num_hits, 1);
+    ASSERT_EQ(fs1->getCacheStatistics().num_misses, 0);
+    ASSERT_EQ(fs1->getCacheStatistics().num_evictions, 5);
+
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
+
+
+TEST_F(LogicalFileSystemTest, CachePolicyTests) {
+    DO_TEST_WITH_FORK(do_CachePolicyTests);
+}
+
+void LogicalFileSystemTest::do_CachePolicyTests() {
+    // Create and initialize the simulation
+    auto simulation = wrench::Simulation::createSimulation();
+
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //    argv[1] = strdup("--wrench-full-log");
+
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+
+    // set up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Create a  Storage Services
+    std::shared_ptr<wrench::SimpleStorageService> storage_service;
+    ASSERT_NO_THROW(storage_service = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService("Host", {"/"})));
+
+    ASSERT_THROW(wrench::LogicalFileSystem::createLogicalFileSystem("Host", storage_service.get(), "/tmp", "BOGUS"), std::invalid_argument);
+    ASSERT_THROW(wrench::LogicalFileSystem::createLogicalFileSystem("Host", storage_service.get(), "/tmp", "TTL", 0), std::invalid_argument);
+
+    auto a_30 = wrench::Simulation::addFile("a_30", 30);
+    auto b_30 = wrench::Simulation::addFile("b_30", 30);
+    auto c_30 = wrench::Simulation::addFile("c_30", 30);
+    auto d_30 = wrench::Simulation::addFile("d_30", 30);
+    auto e_30 = wrench::Simulation::addFile("e_30", 30);
+
+    {
+        // LFU: the least frequently read file is evicted, even if it was read recently
+        auto fs = wrench::LogicalFileSystem::createLogicalFileSystem("Host", storage_service.get(), "/tmp", "LFU");
+        fs->init();
+        ASSERT_EQ(fs->getCachingBehavior(), "LFU");
+        fs->storeFileInDirectory(a_30, "/foo", true);
+        fs->storeFileInDirectory(b_30, "/foo", true);
+        fs->storeFileInDirectory(c_30, "/foo", true);
+        fs->updateReadDate(a_30, "/foo");
+        fs->updateReadDate(a_30, "/foo");
+        fs->updateReadDate(b_30, "/foo");
+        fs->updateReadDate(c_30, "/foo");
+        fs->updateReadDate(b_30, "/foo");
+        // Frequencies: a_30: 3, b_30: 3, c_30: 2
+        ASSERT_TRUE(fs->reserveSpace(d_30, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(c_30, "/foo"));
+        fs->storeFileInDirectory(d_30, "/foo", true);
+        // A pinned file is not evicted, even with the lowest frequency
+        fs->incrementNumRunningTransactionsForFileInDirectory(d_30, "/foo");
+        ASSERT_TRUE(fs->reserveSpace(e_30, "/foo"));
+        ASSERT_TRUE(fs->isFileInDirectory(d_30, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(a_30, "/foo"));
+        ASSERT_TRUE(fs->isFileInDirectory(b_30, "/foo"));
+        fs->storeFileInDirectory(e_30, "/foo", true);
+        fs->decrementNumRunningTransactionsForFileInDirectory(d_30, "/foo");
+        // d_30 and e_30 both have frequency 1, and d_30 is less recently used
+        ASSERT_TRUE(fs->reserveSpace(c_30, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(d_30, "/foo"));
+        ASSERT_TRUE(fs->isFileInDirectory(e_30, "/foo"));
+        ASSERT_EQ(fs->getCacheStatistics().num_hits, 5);
+        ASSERT_EQ(fs->getCacheStatistics().num_evictions, 3);
+    }
+
+    // Each policy uses its own mount point, since there can be only one file system per mount point of a storage service
+    {
+        // ARC: a file evicted from T1 and written again goes to T2 and grows the target size of T1
+        auto fs = wrench::LogicalFileSystem::createLogicalFileSystem("Host", storage_service.get(), "/arc", "ARC");
+        fs->init();
+        fs->storeFileInDirectory(a_30, "/foo", true);
+        fs->storeFileInDirectory(b_30, "/foo", true);
+        fs->storeFileInDirectory(c_30, "/foo", true);
+        fs->updateReadDate(a_30, "/foo");
+        // T1: b_30, c_30   T2: a_30
+        ASSERT_TRUE(fs->reserveSpace(d_30, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(b_30, "/foo"));
+        fs->storeFileInDirectory(d_30, "/foo", true);
+        ASSERT_TRUE(fs->reserveSpace(b_30, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(c_30, "/foo"));
+        fs->storeFileInDirectory(b_30, "/foo", true);
+        // T1: d_30   T2: a_30, b_30   and T1 is no longer larger than its target size
+        ASSERT_TRUE(fs->reserveSpace(e_30, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(a_30, "/foo"));
+        ASSERT_TRUE(fs->isFileInDirectory(b_30, "/foo"));
+        ASSERT_TRUE(fs->isFileInDirectory(d_30, "/foo"));
+        ASSERT_EQ(fs->getCacheStatistics().num_evictions, 3);
+    }
+
+    {
+        // 2Q: a file evicted from A1in and written again goes to Am, and is kept over files in A1in
+        auto f1 = wrench::Simulation::addFile("f1_20", 20);
+        auto f2 = wrench::Simulation::addFile("f2_20", 20);
+        auto f3 = wrench::Simulation::addFile("f3_20", 20);
+        auto f4 = wrench::Simulation::addFile("f4_20", 20);
+        auto f5 = wrench::Simulation::addFile("f5_20", 20);
+        auto f6 = wrench::Simulation::addFile("f6_20", 20);
+        auto f7 = wrench::Simulation::addFile("f7_20", 20);
+        auto fs = wrench::LogicalFileSystem::createLogicalFileSystem("Host", storage_service.get(), "/2q", "2Q");
+        fs->init();
+        for (auto const &f: {f1, f2, f3, f4, f5}) {
+            fs->storeFileInDirectory(f, "/foo", true);
+        }
+        // Reads of files in A1in do not matter
+        fs->updateReadDate(f1, "/foo");
+        ASSERT_TRUE(fs->reserveSpace(f6, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(f1, "/foo"));
+        fs->storeFileInDirectory(f6, "/foo", true);
+        ASSERT_TRUE(fs->reserveSpace(f1, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(f2, "/foo"));
+        fs->storeFileInDirectory(f1, "/foo", true);
+        // A1in: f3, f4, f5, f6   Am: f1
+        ASSERT_TRUE(fs->reserveSpace(f7, "/foo"));
+        ASSERT_TRUE(fs->isFileInDirectory(f1, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(f3, "/foo"));
+        ASSERT_EQ(fs->getCacheStatistics().num_evictions, 3);
+    }
+
+    {
+        // TTL: files are evicted in write order, regardless of reads
+        auto fs = wrench::LogicalFileSystem::createLogicalFileSystem("Host", storage_service.get(), "/ttl", "TTL", 3600);
+        fs->init();
+        fs->storeFileInDirectory(a_30, "/foo", true);
+        fs->storeFileInDirectory(b_30, "/foo", true);
+        fs->storeFileInDirectory(c_30, "/foo", true);
+        fs->updateReadDate(a_30, "/foo");
+        ASSERT_TRUE(fs->reserveSpace(d_30, "/foo"));
+        ASSERT_FALSE(fs->isFileInDirectory(a_30, "/foo"));
+        ASSERT_TRUE(fs->isFileInDirectory(b_30, "/foo"));
+        // Nothing has expired at date 0
+        ASSERT_DOUBLE_EQ(fs->getFreeSpace(), 10);
+        ASSERT_EQ(fs->getCacheStatistics().num_evictions, 1);
+    }
 
     for (int i = 0; i < argc; i++)
         free(argv[i]);
@@ -48,6 +48,8 @@ public:
 
     void do_FileWrite_test(double buffer_size);
 
+    void do_BulkLookupAndDelete_test(double buffer_size);
+
 
 protected:
     ~SimpleStorageServiceFunctionalTest() {
@@ -277,6 +279,38 @@ private:
                 throw std::runtime_error("Should not be able to read a file unavailable a storage service");
             } catch (wrench::ExecutionException &e) {
             }
+
+            // Bogus concurrency
+            try {
+                std::map<std::shared_ptr<wrench::DataFile>, std::shared_ptr<wrench::FileLocation>> locations;
+                locations[this->test->file_10] = wrench::FileLocation::LOCATION(this->test->storage_service_100, this->test->file_10);
+                wrench::StorageService::readFiles(locations, 0);
+                throw std::runtime_error("Should not be able to read files with a zero concurrency");
+            } catch (std::invalid_argument &e) {
+            }
+
+            // Read files concurrently, one of which is unavailable (the other one should still be read)
+            try {
+                std::map<std::shared_ptr<wrench::DataFile>, std::shared_ptr<wrench::FileLocation>> locations;
+                locations[this->test->file_10] = wrench::FileLocation::LOCATION(this->test->storage_service_100, this->test->file_10);
+                locations[this->test->file_100] = wrench::FileLocation::LOCATION(this->test->storage_service_100, this->test->file_100);
+                wrench::StorageService::readFiles(locations, 2);
+                throw std::runtime_error("Should not be able to read a file unavailable a storage service");
+            } catch (wrench::ExecutionException &e) {
+                if (not std::dynamic_pointer_cast<wrench::FileNotFound>(e.getCause())) {
+                    throw std::runtime_error("Got an exception, as expected, but of the unexpected failure cause: " +
+                                             e.getCause()->toString() + " (expected: FileNotFound)");
+                }
+            }
+
+            // Read a file concurrently
+            try {
+                std::map<std::shared_ptr<wrench::DataFile>, std::shared_ptr<wrench::FileLocation>> locations;
+                locations[this->test->file_10] = wrench::FileLocation::LOCATION(this->test->storage_service_100, this->test->file_10);
+                wrench::StorageService::readFiles(locations, 4);
+            } catch (wrench::ExecutionException &e) {
+                throw std::runtime_error("Should be able to read a file available on a storage service");
+            }
         }
 
         {// Test using writeFiles()
@@ -1720,6 +1754,17 @@ void SimpleStorageServiceFunctionalTest::do_FileWrite_test(double buffer_size) {
     ASSERT_THROW(wrench::FileLocation::SCRATCH(file_1)->getAbsolutePathAtMountPoint(), std::invalid_argument);
     ASSERT_THROW(wrench::FileLocation::SCRATCH(file_1)->getFullAbsolutePath(), std::invalid_argument);
     ASSERT_THROW(wrench::FileLocation::sanitizePath(""), std::invalid_argument);
+
+    // Equivalent locations are shared, and a location is re-created once all references are gone
+    auto location_1 = wrench::FileLocation::LOCATION(storage_service_100, "/disk100/foo/", file_1);
+    ASSERT_EQ(location_1, wrench::FileLocation::LOCATION(storage_service_100, "/disk100/foo", file_1));
+    ASSERT_NE(location_1, wrench::FileLocation::LOCATION(storage_service_100, "/disk100/foo", file_10));
+    ASSERT_NE(location_1, wrench::FileLocation::LOCATION(storage_service_100, "/disk1000/foo", file_1));
+    ASSERT_EQ(wrench::FileLocation::SCRATCH(file_1), wrench::FileLocation::SCRATCH(file_1));
+    location_1 = nullptr;
+    location_1 = wrench::FileLocation::LOCATION(storage_service_100, "/disk100/foo", file_1);
+    ASSERT_EQ(file_1, location_1->getFile());
+    ASSERT_EQ(storage_service_100, location_1->getStorageService());
     //    ASSERT_THROW(wrench::FileLocation::sanitizePath(" "), std::invalid_argument);
     //    ASSERT_THROW(wrench::FileLocation::sanitizePath("../.."), std::invalid_argument);
 
@@ -1741,3 +1786,116 @@ void SimpleStorageServiceFunctionalTest::do_FileWrite_test(double buffer_size) {
         free(argv[i]);
     free(argv);
 }
+
+
+/**********************************************************************/
+/**  BULK LOOKUP AND DELETE TEST                                     **/
+/**********************************************************************/
+
+class BulkLookupAndDeleteTestWMS : public wrench::ExecutionController {
+
+public:
+    BulkLookupAndDeleteTestWMS(SimpleStorageServiceFunctionalTest *test,
+                               std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    SimpleStorageServiceFunctionalTest *test;
+
+    int main() override {
+
+        auto ss_100 = this->test->storage_service_100;
+        auto ss_1000 = this->test->storage_service_1000;
+
+        // Empty lookup
+        if (not wrench::StorageService::lookupFiles({}).empty()) {
+            throw std::runtime_error("An empty bulk lookup should return an empty result");
+        }
+
+        // Bulk lookup across two services
+        std::vector<bool> expected = {true, true, false, true};
+        auto found = wrench::StorageService::lookupFiles({wrench::FileLocation::LOCATION(ss_100, this->test->file_1),
+                                                          wrench::FileLocation::LOCATION(ss_100, this->test->file_10),
+                                                          wrench::FileLocation::LOCATION(ss_100, this->test->file_100),
+                                                          wrench::FileLocation::LOCATION(ss_1000, this->test->file_100)});
+        if (found != expected) {
+            throw std::runtime_error("Unexpected bulk lookup result");
+        }
+
+        // Bulk delete, with one failure
+        try {
+            wrench::StorageService::deleteFiles({wrench::FileLocation::LOCATION(ss_100, this->test->file_1),
+                                                 wrench::FileLocation::LOCATION(ss_1000, this->test->file_100),
+                                                 wrench::FileLocation::LOCATION(ss_100, this->test->file_500)});
+            throw std::runtime_error("Should not be able to delete a file that is not there");
+        } catch (wrench::ExecutionException &e) {
+            auto cause = std::dynamic_pointer_cast<wrench::FileNotFound>(e.getCause());
+            if (not cause) {
+                throw std::runtime_error("Got an expected exception but unexpected cause type: " + e.getCause()->toString());
+            }
+            if (cause->getLocation()->getFile() != this->test->file_500) {
+                throw std::runtime_error("Got the expected 'file not found' exception, but the failure cause does not point to the correct file");
+            }
+        }
+
+        // The other deletions should have happened
+        expected = {false, true, false};
+        found = wrench::StorageService::lookupFiles({wrench::FileLocation::LOCATION(ss_100, this->test->file_1),
+                                                     wrench::FileLocation::LOCATION(ss_100, this->test->file_10),
+                                                     wrench::FileLocation::LOCATION(ss_1000, this->test->file_100)});
+        if (found != expected) {
+            throw std::runtime_error("Unexpected bulk lookup result after bulk deletion");
+        }
+
+        return 0;
+    }
+};
+
+TEST_F(SimpleStorageServiceFunctionalTest, BulkLookupAndDelete) {
+    DO_TEST_WITH_FORK_ONE_ARG(do_BulkLookupAndDelete_test, 1000000);
+    DO_TEST_WITH_FORK_ONE_ARG(do_BulkLookupAndDelete_test, 0);
+}
+
+void SimpleStorageServiceFunctionalTest::do_BulkLookupAndDelete_test(double buffer_size) {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //    argv[1] = strdup("--wrench-full-log");
+
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Get a hostname
+    std::string hostname = wrench::Simulation::getHostnameList()[0];
+
+    // Create 2 Storage Services
+    ASSERT_NO_THROW(storage_service_100 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(hostname, {"/disk100"},
+                                                                                     {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, std::to_string(buffer_size)}}, {})));
+    ASSERT_NO_THROW(storage_service_1000 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService(hostname, {"/disk1000"},
+                                                                                     {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, std::to_string(buffer_size)}}, {})));
+
+    // Create a WMS
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new BulkLookupAndDeleteTestWMS(
+                                    this, hostname)));
+
+    // Staging files
+    ASSERT_NO_THROW(simulation->stageFile(file_1, storage_service_100));
+    ASSERT_NO_THROW(simulation->stageFile(file_10, storage_service_100));
+    ASSERT_NO_THROW(simulation->stageFile(file_100, storage_service_1000));
+
+    // Running the simulation
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
@@ -37,6 +37,7 @@ public:
 
     void do_FileRead_test(double buffer_size);
     void do_ConcurrentFileCopies_test(double buffer_size);
+    void do_ConcurrentFileWrites_test(double buffer_size);
 
     static double computeExpectedTwoStagePipelineTime(double bw_stage1, double bw_stage2, double total_size,
                                                       double buffer_size) {
@@ -89,7 +90,8 @@ protected:
         file_2 = workflow->addFile("file_2", FILE_SIZE);
         file_3 = workflow->addFile("file_3", FILE_SIZE);
 
-        // Create a 3-host platform file (network bandwidth == disk bandwidth)
+        // Create a 3-host platform file (network bandwidth == disk bandwidth, and
+        // WMSHost reaches SrcHost and DstHost through different links)
         std::string xml = "<?xml version='1.0'?>"
                           "<!DOCTYPE platform SYSTEM \"https://simgrid.org/simgrid.dtd\">"
                           "<platform version=\"4.1\"> "
@@ -120,6 +122,9 @@ protected:
                           "       <link id=\"link\" bandwidth=\"" +
                           std::to_string(MBPS_BANDWIDTH) +
                           "MBps\" latency=\"1us\"/>"
+                          "       <link id=\"link_2\" bandwidth=\"" +
+                          std::to_string(MBPS_BANDWIDTH) +
+                          "MBps\" latency=\"1us\"/>"
                           "       <route src=\"SrcHost\" dst=\"DstHost\">"
                           "         <link_ctn id=\"link\"/>"
                           "       </route>"
@@ -127,7 +132,7 @@ protected:
                           "         <link_ctn id=\"link\"/>"
                           "       </route>"
                           "       <route src=\"WMSHost\" dst=\"DstHost\">"
-                          "         <link_ctn id=\"link\"/>"
+                          "         <link_ctn id=\"link_2\"/>"
                           "       </route>"
                           "   </zone> "
                           "</platform>";
@@ -300,6 +305,100 @@ void SimpleStorageServicePerformanceTest::do_ConcurrentFileCopies_test(double bu
 }
 
 
+/**********************************************************************/
+/**  CONCURRENT FILE WRITES TEST                                     **/
+/**********************************************************************/
+
+class SimpleStorageServiceConcurrentFileWritesTestWMS : public wrench::ExecutionController {
+
+public:
+    SimpleStorageServiceConcurrentFileWritesTestWMS(SimpleStorageServicePerformanceTest *test,
+                                                    std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    SimpleStorageServicePerformanceTest *test;
+
+    int main() {
+
+        // Two files, each written to a storage service reached through its own link
+        std::map<std::shared_ptr<wrench::DataFile>, std::shared_ptr<wrench::FileLocation>> locations;
+        locations[this->test->file_1] = wrench::FileLocation::LOCATION(this->test->storage_service_1, this->test->file_1);
+        locations[this->test->file_2] = wrench::FileLocation::LOCATION(this->test->storage_service_2, this->test->file_2);
+
+        // Write the files one after the other
+        double sequential_start = wrench::Simulation::getCurrentSimulatedDate();
+        wrench::StorageService::writeFiles(locations);
+        double sequential_elapsed = wrench::Simulation::getCurrentSimulatedDate() - sequential_start;
+
+        for (auto const &l: locations) {
+            wrench::StorageService::deleteFile(l.second);
+        }
+
+        // Write the files concurrently
+        double concurrent_start = wrench::Simulation::getCurrentSimulatedDate();
+        wrench::StorageService::writeFiles(locations, 2);
+        double concurrent_elapsed = wrench::Simulation::getCurrentSimulatedDate() - concurrent_start;
+
+        for (auto const &l: locations) {
+            if (not wrench::StorageService::lookupFile(l.second)) {
+                throw std::runtime_error("File " + l.first->getID() + " should have been written");
+            }
+        }
+
+        // Since the two transfers use different links and disks, they should fully overlap
+        if (std::abs(concurrent_elapsed - sequential_elapsed / 2.0) > 1.0) {
+            throw std::runtime_error("Concurrent writes took " + std::to_string(concurrent_elapsed) +
+                                     " seconds, but should take half as long as sequential writes (" +
+                                     std::to_string(sequential_elapsed) + " seconds)");
+        }
+
+        return 0;
+    }
+};
+
+TEST_F(SimpleStorageServicePerformanceTest, ConcurrentFileWrites) {
+    DO_TEST_WITH_FORK_ONE_ARG(do_ConcurrentFileWrites_test, FILE_SIZE / 10);
+    DO_TEST_WITH_FORK_ONE_ARG(do_ConcurrentFileWrites_test, FILE_SIZE / 100);
+    DO_TEST_WITH_FORK_ONE_ARG(do_ConcurrentFileWrites_test, 0);
+}
+
+void SimpleStorageServicePerformanceTest::do_ConcurrentFileWrites_test(double buffer_size) {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //    argv[1] = strdup("--wrench-full-log");
+
+    ASSERT_NO_THROW(simulation->init(&argc, argv));
+
+    // Setting up the platform
+    ASSERT_NO_THROW(simulation->instantiatePlatform(platform_file_path));
+
+    // Create Two Storage Services
+    ASSERT_NO_THROW(storage_service_1 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService("SrcHost", {"/"},
+                                                                                     {{wrench::StorageServiceProperty::BUFFER_SIZE, std::to_string(buffer_size)}})));
+    ASSERT_NO_THROW(storage_service_2 = simulation->add(
+                            wrench::SimpleStorageService::createSimpleStorageService("DstHost", {"/"},
+                                                                                     {{wrench::StorageServiceProperty::BUFFER_SIZE, std::to_string(buffer_size)}})));
+
+    // Create a WMS
+    std::shared_ptr<wrench::ExecutionController> wms = nullptr;
+    ASSERT_NO_THROW(wms = simulation->add(
+                            new SimpleStorageServiceConcurrentFileWritesTestWMS(this, "WMSHost")));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
+
+
 /**********************************************************************/
 /**  FILE READ TEST                                                  **/
 /*******************************z**************************************/
@@ -21,6 +21,12 @@ class StorageServiceProxyBasicTest : public ::testing::Test {
 public:
     void do_BasicFunctionality_test(bool arg, std::string mode);
 
+    void do_Prefetching_test();
+
+    void do_WriteBack_test();
+
+    void do_BulkLookupAndDelete_test();
+
     std::shared_ptr<wrench::SimpleStorageService> remote;
     std::shared_ptr<wrench::SimpleStorageService> target;
     std::shared_ptr<wrench::StorageServiceProxy> proxy;
@@ -337,3 +343,339 @@ void StorageServiceProxyBasicTest::do_BasicFunctionality_test(bool arg, std::str
         free(argv[i]);
     free(argv);
 }
+
+
+/**********************************************************************/
+/**  PREFETCHING SIMULATION TEST                                     **/
+/**********************************************************************/
+
+class StorageServiceProxyPrefetchingTestExecutionController : public wrench::ExecutionController {
+
+public:
+    StorageServiceProxyPrefetchingTestExecutionController(StorageServiceProxyBasicTest *test,
+                                                          std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    StorageServiceProxyBasicTest *test;
+    int main() override {
+
+        using namespace wrench;
+        auto &proxy = test->proxy;
+        auto cache = proxy->getCache();
+
+        auto file1 = wrench::Simulation::addFile("file1", 100000000);
+        auto file2 = wrench::Simulation::addFile("file2", 100000000);
+        auto file3 = wrench::Simulation::addFile("file3", 100000000);
+        auto big_file1 = wrench::Simulation::addFile("big_file1", 60000000000);
+        auto big_file2 = wrench::Simulation::addFile("big_file2", 60000000000);
+        this->test->remote->createFile(file1);
+        this->test->remote->createFile(file2);
+        this->test->remote->createFile(file3);
+        this->test->remote->createFile(big_file1);
+        this->test->target->createFile(big_file2);
+
+        // A read of a file that is being prefetched waits for the prefetch
+        proxy->prefetchFiles({FileLocation::LOCATION(this->test->remote, file3)});
+        proxy->readFile(file3);
+        if (not cache->lookupFile(file3)) {
+            throw std::runtime_error("Prefetched file should be in the cache");
+        }
+
+        // The second big file does not fit in the cache once the first one is there
+        proxy->prefetchFiles({ProxyLocation::LOCATION(this->test->remote, proxy, file1),
+                              ProxyLocation::LOCATION(this->test->remote, proxy, file2),
+                              ProxyLocation::LOCATION(this->test->remote, proxy, big_file1),
+                              ProxyLocation::LOCATION(this->test->target, proxy, big_file2)});
+        simulation->sleep(2000);
+        if ((not cache->lookupFile(file1)) or (not cache->lookupFile(file2)) or (not cache->lookupFile(big_file1))) {
+            throw std::runtime_error("Prefetched files should be in the cache");
+        }
+        if (cache->lookupFile(big_file2)) {
+            throw std::runtime_error("A file that does not fit in the cache should not have been prefetched");
+        }
+
+        // Reads of prefetched files are served by the cache
+        auto start = simulation->getCurrentSimulatedDate();
+        proxy->readFile(file1);
+        if (simulation->getCurrentSimulatedDate() - start > 1.5) {
+            throw std::runtime_error("Reading a prefetched file should not require a copy from the remote");
+        }
+
+        proxy->stop();
+        return 0;
+    }
+};
+
+TEST_F(StorageServiceProxyBasicTest, Prefetching) {
+    DO_TEST_WITH_FORK(do_Prefetching_test);
+}
+
+void StorageServiceProxyBasicTest::do_Prefetching_test() {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //   argv[1] = strdup("--wrench-full-log");
+    simulation->init(&argc, argv);
+
+    simulation->instantiatePlatform(platform_file_path);
+    simgrid::s4u::Engine::get_instance()->netzone_by_name_or_null("AS0")->add_route(simgrid::s4u::Host::by_name("Remote")->get_netpoint(),
+                                                                                    simgrid::s4u::Host::by_name("Client")->get_netpoint(),
+                                                                                    nullptr,
+                                                                                    nullptr,
+                                                                                    {simgrid::s4u::LinkInRoute(simgrid::s4u::Link::by_name("backdoor"))});
+
+    this->remote = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Remote", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+    auto cache = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Proxy", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+    this->target = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Target", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+
+    this->proxy = simulation->add(
+            wrench::StorageServiceProxy::createRedirectProxy(
+                    "Proxy", cache, remote, {{wrench::StorageServiceProxyProperty::PREFETCH_MAX_NUM_CONCURRENT_COPIES, "2"}}));
+
+    // Create an execution controller
+    auto controller = simulation->add(new StorageServiceProxyPrefetchingTestExecutionController(this, "Client"));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
+
+
+/**********************************************************************/
+/**  WRITE-BACK SIMULATION TEST                                      **/
+/**********************************************************************/
+
+class StorageServiceProxyWriteBackTestExecutionController : public wrench::ExecutionController {
+
+public:
+    StorageServiceProxyWriteBackTestExecutionController(StorageServiceProxyBasicTest *test,
+                                                        std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    StorageServiceProxyBasicTest *test;
+    int main() override {
+
+        using namespace wrench;
+        auto &proxy = test->proxy;
+
+        auto file1 = wrench::Simulation::addFile("file1", 100000000);
+        auto file2 = wrench::Simulation::addFile("file2", 100000000);
+
+        // The client looks up files directly on the target
+        S4U_Simulation::setLinkBandwidth("backdoor", 1000000000);
+
+        // Nothing to sync
+        proxy->sync();
+
+        // A written file is dirty until the flush delay has elapsed
+        proxy->writeFile(this->test->target, file1);
+        if (not proxy->isFileDirty(file1)) {
+            throw std::runtime_error("A newly written file should be dirty");
+        }
+        simulation->sleep(10);
+        if (this->test->target->lookupFile(file1)) {
+            throw std::runtime_error("A dirty file should not be on the target before the flush delay has elapsed");
+        }
+        simulation->sleep(200);
+        if (proxy->isFileDirty(file1) or (not this->test->target->lookupFile(file1))) {
+            throw std::runtime_error("A dirty file should have been flushed after the flush delay");
+        }
+
+        // A sync flushes dirty files right away
+        proxy->writeFile(this->test->target, file2);
+        auto start = simulation->getCurrentSimulatedDate();
+        proxy->sync();
+        if (simulation->getCurrentSimulatedDate() - start > 50) {
+            throw std::runtime_error("A sync should not wait for the flush delay");
+        }
+        if (proxy->isFileDirty(file2) or (not this->test->target->lookupFile(file2))) {
+            throw std::runtime_error("A synced file should be on the target");
+        }
+
+        // A file deleted while being flushed is not left on the target by the flush
+        auto file3 = wrench::Simulation::addFile("file3", 100000000);
+        proxy->writeFile(this->test->target, file3);
+        simulation->sleep(100.5);
+        proxy->deleteFile(this->test->target, file3);
+        if (proxy->isFileDirty(file3) or this->test->target->lookupFile(file3)) {
+            throw std::runtime_error("A file deleted during its flush should not be on the target");
+        }
+
+        // A sync waits for flushes that take longer than the network timeout
+        auto file4 = wrench::Simulation::addFile("file4", 5000000000);
+        proxy->writeFile(this->test->target, file4);
+        start = simulation->getCurrentSimulatedDate();
+        proxy->sync();
+        if (simulation->getCurrentSimulatedDate() - start <= proxy->getNetworkTimeoutValue()) {
+            throw std::runtime_error("The flush of file4 should take longer than the network timeout");
+        }
+        if (proxy->isFileDirty(file4) or (not this->test->target->lookupFile(file4))) {
+            throw std::runtime_error("A file synced after a long flush should be on the target");
+        }
+
+        proxy->stop();
+        return 0;
+    }
+};
+
+TEST_F(StorageServiceProxyBasicTest, WriteBack) {
+    DO_TEST_WITH_FORK(do_WriteBack_test);
+}
+
+void StorageServiceProxyBasicTest::do_WriteBack_test() {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //   argv[1] = strdup("--wrench-full-log");
+    simulation->init(&argc, argv);
+
+    simulation->instantiatePlatform(platform_file_path);
+    simgrid::s4u::Engine::get_instance()->netzone_by_name_or_null("AS0")->add_route(simgrid::s4u::Host::by_name("Target")->get_netpoint(),
+                                                                                    simgrid::s4u::Host::by_name("Client")->get_netpoint(),
+                                                                                    nullptr,
+                                                                                    nullptr,
+                                                                                    {simgrid::s4u::LinkInRoute(simgrid::s4u::Link::by_name("backdoor"))});
+
+    this->remote = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Remote", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+    auto cache = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Proxy", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+    this->target = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Target", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+
+    this->proxy = simulation->add(
+            wrench::StorageServiceProxy::createRedirectProxy(
+                    "Proxy", cache, remote, {{wrench::StorageServiceProxyProperty::WRITE_BACK, "true"}, {wrench::StorageServiceProxyProperty::WRITE_BACK_FLUSH_DELAY, "100"}}));
+
+    // Create an execution controller
+    auto controller = simulation->add(new StorageServiceProxyWriteBackTestExecutionController(this, "Client"));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
+
+
+/**********************************************************************/
+/**  BULK LOOKUP AND DELETE SIMULATION TEST                          **/
+/**********************************************************************/
+
+class StorageServiceProxyBulkLookupAndDeleteTestExecutionController : public wrench::ExecutionController {
+
+public:
+    StorageServiceProxyBulkLookupAndDeleteTestExecutionController(StorageServiceProxyBasicTest *test,
+                                                                  std::string hostname) : wrench::ExecutionController(hostname, "test"), test(test) {
+    }
+
+private:
+    StorageServiceProxyBasicTest *test;
+    int main() override {
+
+        using namespace wrench;
+        auto &proxy = test->proxy;
+        auto cache = proxy->getCache();
+
+        auto file1 = wrench::Simulation::addFile("file1", 10000);
+        auto file2 = wrench::Simulation::addFile("file2", 10000);
+        auto file3 = wrench::Simulation::addFile("file3", 10000);
+        auto file4 = wrench::Simulation::addFile("file4", 10000);
+        this->test->remote->createFile(file1);
+        this->test->remote->createFile(file2);
+        this->test->target->createFile(file3);
+        cache->createFile(file1);
+
+        // Bulk lookup of cached and uncached files, at the remote and at another target
+        std::vector<bool> expected = {true, true, false, true};
+        auto found = StorageService::lookupFiles({ProxyLocation::LOCATION(this->test->remote, proxy, file1),
+                                                  ProxyLocation::LOCATION(this->test->remote, proxy, file2),
+                                                  ProxyLocation::LOCATION(this->test->remote, proxy, file4),
+                                                  ProxyLocation::LOCATION(this->test->target, proxy, file3)});
+        if (found != expected) {
+            throw std::runtime_error("Unexpected bulk lookup result");
+        }
+
+        // Bulk delete, which removes files from the cache and from their targets
+        StorageService::deleteFiles({ProxyLocation::LOCATION(this->test->remote, proxy, file1),
+                                     ProxyLocation::LOCATION(this->test->remote, proxy, file2),
+                                     ProxyLocation::LOCATION(this->test->target, proxy, file3)});
+        if (cache->lookupFile(file1)) {
+            throw std::runtime_error("A file deleted in bulk should no longer be in the cache");
+        }
+        expected = {false, false, false};
+        found = StorageService::lookupFiles({ProxyLocation::LOCATION(this->test->remote, proxy, file1),
+                                             ProxyLocation::LOCATION(this->test->remote, proxy, file2),
+                                             ProxyLocation::LOCATION(this->test->target, proxy, file3)});
+        if (found != expected) {
+            throw std::runtime_error("Unexpected bulk lookup result after bulk deletion");
+        }
+
+        // Bulk delete of a file that is nowhere
+        try {
+            StorageService::deleteFiles({ProxyLocation::LOCATION(this->test->remote, proxy, file4)});
+            throw std::runtime_error("Should not be able to delete a file that is not there");
+        } catch (ExecutionException &e) {
+            auto cause = std::dynamic_pointer_cast<FileNotFound>(e.getCause());
+            if (not cause) {
+                throw std::runtime_error("Got an expected exception but unexpected cause type: " + e.getCause()->toString());
+            }
+            if (cause->getLocation()->getFile() != file4) {
+                throw std::runtime_error("Got the expected 'file not found' exception, but the failure cause does not point to the correct file");
+            }
+        }
+
+        proxy->stop();
+        return 0;
+    }
+};
+
+TEST_F(StorageServiceProxyBasicTest, BulkLookupAndDelete) {
+    DO_TEST_WITH_FORK(do_BulkLookupAndDelete_test);
+}
+
+void StorageServiceProxyBasicTest::do_BulkLookupAndDelete_test() {
+
+    // Create and initialize a simulation
+    auto simulation = wrench::Simulation::createSimulation();
+    int argc = 1;
+    char **argv = (char **) calloc(argc, sizeof(char *));
+    argv[0] = strdup("unit_test");
+    //   argv[1] = strdup("--wrench-full-log");
+    simulation->init(&argc, argv);
+
+    simulation->instantiatePlatform(platform_file_path);
+
+    this->remote = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Remote", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+    auto cache = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Proxy", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+    this->target = simulation->add(wrench::SimpleStorageService::createSimpleStorageService(
+            "Target", {"/disk100"}, {{wrench::SimpleStorageServiceProperty::BUFFER_SIZE, "10MB"}}, {}));
+
+    this->proxy = simulation->add(
+            wrench::StorageServiceProxy::createRedirectProxy(
+                    "Proxy", cache, remote, {}));
+
+    // Create an execution controller
+    auto controller = simulation->add(new StorageServiceProxyBulkLookupAndDeleteTestExecutionController(this, "Client"));
+
+    ASSERT_NO_THROW(simulation->launch());
+
+    for (int i = 0; i < argc; i++)
+        free(argv[i]);
+    free(argv);
+}
@@ -18,10 +18,12 @@ WRENCH_LOG_CATEGORY(xrootd_storage_service_basic_functional_test, "Log category
 class XRootDServiceBasicFunctionalTest : public ::testing::Test {
 
 public:
-    void do_BasicFunctionality_test(std::string arg);
+    void do_BasicFunctionality_test(std::string arg, std::string use_bloom_filters);
 
     std::shared_ptr<wrench::XRootD::Node> root_supervisor;
     std::shared_ptr<wrench::SimpleStorageService> standalone_ss;
+    bool reduced_simulation = false;
+    bool search_with_bloom_filters = false;
 
 protected:
     XRootDServiceBasicFunctionalTest() {
@@ -51,7 +53,7 @@ protected:
                           "          </disk>"
                           "       </host>"
                           "       <link id=\"link12\" bandwidth=\"5GBps\" latency=\"10us\"/>"
-                          "       <link id=\"link13\" bandwidth=\"5GBps\" latency=\"10us\"/>"
+                          "       <link id=\"link13\" bandwidth=\"5GBps\" latency=\"1ms\"/>"
                           "       <link id=\"link23\" bandwidth=\"5GBps\" latency=\"10us\"/>"
                           "       <route src=\"Host1\" dst=\"Host2\"> <link_ctn id=\"link12\"/> </route>"
                           "       <route src=\"Host1\" dst=\"Host3\"> <link_ctn id=\"link13\"/> </route>"
@@ -130,6 +132,27 @@ private:
         if (this->test->root_supervisor->lookupFile(file2)) throw std::runtime_error("File that does not exist located - indirect");
         if (this->test->root_supervisor->getChild(0)->lookupFile(file2)) throw std::runtime_error("File that does not exist located - direct");
 
+        // Lookup several files at once, some of which require a search
+        auto file8 = wrench::Simulation::addFile("file8", 10000);
+        auto file9 = wrench::Simulation::addFile("file9", 10000);
+        this->test->root_supervisor->getChild(0)->createFile(file8);
+        this->test->root_supervisor->getChild(1)->createFile(file9);
+        auto found = wrench::StorageService::lookupFiles({wrench::FileLocation::LOCATION(this->test->root_supervisor, file8),
+                                                          wrench::FileLocation::LOCATION(this->test->root_supervisor, file1),
+                                                          wrench::FileLocation::LOCATION(this->test->root_supervisor, file9),
+                                                          wrench::FileLocation::LOCATION(this->test->root_supervisor, file8)});
+        if (found != std::vector<bool>({true, true, true, true})) throw std::runtime_error("Files that exist not all located - bulk");
+        found = wrench::StorageService::lookupFiles({wrench::FileLocation::LOCATION(this->test->root_supervisor, file2),
+                                                     wrench::FileLocation::LOCATION(this->test->root_supervisor, file9)});
+        if (found != std::vector<bool>({false, true})) throw std::runtime_error("Unexpected bulk lookup result");
+        if (!this->test->root_supervisor->cached(file8) or !this->test->root_supervisor->cached(file9)) {
+            throw std::runtime_error("Files found by a bulk lookup should be cached");
+        }
+        std::shared_ptr<wrench::StorageService> root_as_storage_service = this->test->root_supervisor;
+        if (!root_as_storage_service->hasFile(file9) or root_as_storage_service->hasFile(file2)) {
+            throw std::runtime_error("The root supervisor should know which files are in its subtree");
+        }
+
         this->test->root_supervisor->deleteFile(file1);
 
         try {
@@ -141,6 +164,51 @@ private:
             }
         }
 
+        // Delete several files at once
+        wrench::StorageService::deleteFiles({wrench::FileLocation::LOCATION(this->test->root_supervisor, file8),
+                                             wrench::FileLocation::LOCATION(this->test->root_supervisor, file9)});
+        found = wrench::StorageService::lookupFiles({wrench::FileLocation::LOCATION(this->test->root_supervisor, file8),
+                                                     wrench::FileLocation::LOCATION(this->test->root_supervisor, file9)});
+        if (found != std::vector<bool>({false, false})) throw std::runtime_error("Files not deleted properly - bulk");
+        if (this->test->root_supervisor->getChild(0)->lookupFile(file8) or this->test->root_supervisor->getChild(1)->lookupFile(file9)) {
+            throw std::runtime_error("Files deleted in bulk should be gone from the leaves");
+        }
+
+        // Searches skip children whose Bloom filter rules the file out (which the children's cache
+        // statistics show, since a child that receives a search looks the file up in its cache),
+        // and deleting a file removes it from the Bloom filters
+        if (not this->test->reduced_simulation) {
+            bool pruned = this->test->search_with_bloom_filters;
+            auto file10 = wrench::Simulation::addFile("file10", 10000);
+            this->test->root_supervisor->getChild(0)->createFile(file10);
+            auto num_misses = this->test->root_supervisor->getChild(1)->getCacheLookupStatistics().num_misses;
+            if (!this->test->root_supervisor->lookupFile(file10)) throw std::runtime_error("File that exists not located - filtered");
+            wrench::Simulation::sleep(10);
+            if ((this->test->root_supervisor->getChild(1)->getCacheLookupStatistics().num_misses == num_misses) != pruned) {
+                throw std::runtime_error(std::string("The child without file10 should ") + (pruned ? "not " : "") + "have been searched");
+            }
+
+            this->test->root_supervisor->deleteFile(file10);
+            num_misses = this->test->root_supervisor->getChild(0)->getCacheLookupStatistics().num_misses;
+            if (this->test->root_supervisor->lookupFile(file10)) throw std::runtime_error("File not deleted properly - filtered");
+            if ((this->test->root_supervisor->getChild(0)->getCacheLookupStatistics().num_misses == num_misses) != pruned) {
+                throw std::runtime_error(std::string("The child that had file10 should ") + (pruned ? "not " : "") + "have been searched after its deletion");
+            }
+        }
+
+        // In a reduced simulation, a read is served by the copy with the lowest route latency
+        // (Host2 is closer to Host1 than Host3 is), even if it is not the first copy
+        if (this->test->reduced_simulation) {
+            auto file11 = wrench::Simulation::addFile("file11", 10000);
+            this->test->root_supervisor->getChild(1)->createFile(file11);
+            this->test->root_supervisor->getChild(0)->createFile(file11);
+            this->test->root_supervisor->readFile(file11);
+            auto cached = this->test->root_supervisor->getCached(file11);
+            if ((cached.size() != 1) or ((*cached.begin())->getStorageService() != this->test->root_supervisor->getChild(0)->getStorageServer())) {
+                throw std::runtime_error("The copy with the lowest route latency should have served the read");
+            }
+        }
+
         // attempt to write file directly to leaf
         this->test->root_supervisor->getChild(0)->writeFile(file3);
 
@@ -220,6 +288,18 @@ private:
         this->test->root_supervisor->getLoad();
         this->test->root_supervisor->getChild(0)->getLoad();
 
+        // Check cache statistics, and that cache entries expire (the cache lifetime is 28800)
+        auto statistics = this->test->root_supervisor->getCacheLookupStatistics();
+        if ((statistics.num_hits == 0) or (statistics.num_misses == 0) or (statistics.num_expirations != 0)) {
+            throw std::runtime_error("Unexpected cache statistics");
+        }
+        wrench::Simulation::sleep(30000);
+        if (!this->test->root_supervisor->lookupFile(file3)) throw std::runtime_error("File that exists not located - expired");
+        statistics = this->test->root_supervisor->getCacheLookupStatistics();
+        if (statistics.num_expirations == 0) {
+            throw std::runtime_error("Cache entries should have expired");
+        }
+
         return 0;
 
         //TODO hookup cache.clear to something or remove it
@@ -227,13 +307,16 @@ private:
 };
 
 TEST_F(XRootDServiceBasicFunctionalTest, BasicFunctionalityFullSimulation) {
-    DO_TEST_WITH_FORK_ONE_ARG(do_BasicFunctionality_test, "false");
+    DO_TEST_WITH_FORK_TWO_ARGS(do_BasicFunctionality_test, "false", "false");
+}
+TEST_F(XRootDServiceBasicFunctionalTest, BloomFilterFullSimulation) {
+    DO_TEST_WITH_FORK_TWO_ARGS(do_BasicFunctionality_test, "false", "true");
 }
 TEST_F(XRootDServiceBasicFunctionalTest, FastSearchQuickSimulation) {
-    DO_TEST_WITH_FORK_ONE_ARG(do_BasicFunctionality_test, "true");
+    DO_TEST_WITH_FORK_TWO_ARGS(do_BasicFunctionality_test, "true", "false");
 }
 
-void XRootDServiceBasicFunctionalTest::do_BasicFunctionality_test(std::string arg) {
+void XRootDServiceBasicFunctionalTest::do_BasicFunctionality_test(std::string arg, std::string use_bloom_filters) {
 
     // Create and initialize a simulation
     auto simulation = wrench::Simulation::createSimulation();
@@ -247,8 +330,11 @@ void XRootDServiceBasicFunctionalTest::do_BasicFunctionality_test(std::string ar
     // Setting up the platform
     simulation->instantiatePlatform(platform_file_path);
 
+    this->reduced_simulation = (arg == "true");
+    this->search_with_bloom_filters = (use_bloom_filters == "true");
+
     // Create a XRootD Manager object
-    wrench::XRootD::Deployment xrootd_deployment(simulation, {{wrench::XRootD::Property::CACHE_MAX_LIFETIME, "28800"}, {wrench::XRootD::Property::REDUCED_SIMULATION, arg}, {wrench::XRootD::Property::FILE_NOT_FOUND_TIMEOUT, "10"}}, {{wrench::StorageServiceMessagePayload::FILE_WRITE_REQUEST_MESSAGE_PAYLOAD, 1024}});
+    wrench::XRootD::Deployment xrootd_deployment(simulation, {{wrench::XRootD::Property::CACHE_MAX_LIFETIME, "28800"}, {wrench::XRootD::Property::REDUCED_SIMULATION, arg}, {wrench::XRootD::Property::FILE_NOT_FOUND_TIMEOUT, "10"}, {wrench::XRootD::Property::SEARCH_WITH_BLOOM_FILTERS, use_bloom_filters}, {wrench::XRootD::Property::BLOOM_FILTER_NUM_COUNTERS, "1024"}}, {{wrench::StorageServiceMessagePayload::FILE_WRITE_REQUEST_MESSAGE_PAYLOAD, 1024}});
 
     this->root_supervisor = xrootd_deployment.createRootSupervisor("Host1");
 